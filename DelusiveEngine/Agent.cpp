@@ -78,46 +78,20 @@ void Agent::SetScale(const glm::vec2 scale) {
 	transform.scale = scale;
 }
 
-GLuint Agent::RenderAgentToTexture(int width, int height) {
-	GLuint framebuffer, textureColorbuffer;
-	glGenFramebuffers(1, &framebuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
-	// Create texture
-	glGenTextures(1, &textureColorbuffer);
-	glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	// Attach to framebuffer
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureColorbuffer, 0);
-
-	// Optional depth buffer
-	GLuint rbo;
-	glGenRenderbuffers(1, &rbo);
-	glBindRenderbuffer(GL_RENDERBUFFER, rbo);
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
-
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-		std::cerr << "[RenderAgentToTexture] Framebuffer not complete!" << std::endl;
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		return 0;
-	}
+bool Agent::RenderAgentToTexture(const RenderTarget& target) {
+	if (!target.framebuffer) return false;
+	glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
 
 	// Set viewport and clear
-	glViewport(0, 0, width, height);
+	glViewport(0, 0, target.width, target.height);
 	glDisable(GL_BLEND);
 	glDisable(GL_DEPTH_TEST);
 	glClearColor(0.15f, 0.15f, 0.15f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	float halfWidth = width * 0.5f;
-	float halfHeight = height * 0.5f;
 	constexpr float pixelsPerUnit = 64.0f;
-	float halfWidthUnits = width / (2.0f * pixelsPerUnit);
-	float halfHeightUnits = height / (2.0f * pixelsPerUnit);
+	float halfWidthUnits = target.width / (2.0f * pixelsPerUnit);
+	float halfHeightUnits = target.height / (2.0f * pixelsPerUnit);
 	glm::mat4 projection = glm::ortho(
 		-halfWidthUnits, halfWidthUnits,
 		-halfHeightUnits, halfHeightUnits,
@@ -126,13 +100,10 @@ GLuint Agent::RenderAgentToTexture(int width, int height) {
 
 	this->Draw(projection);
 
-	// Cleanup
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	glEnable(GL_BLEND);
-	glDeleteRenderbuffers(1, &rbo);
-	glDeleteFramebuffers(1, &framebuffer);
 
-	return textureColorbuffer;
+	return true;
 }
 
 void Agent::AddRawComponent(std::unique_ptr<Component> component) {
@@ -141,6 +112,32 @@ void Agent::AddRawComponent(std::unique_ptr<Component> component) {
 	components.push_back(std::move(component));
 }
 
+uint64_t Agent::GetEditStamp() const {
+	uint64_t stamp = FnvOffset;
+	HashValue(stamp, registry->GetRevision());
+	HashValue(stamp, transform.position);
+	HashValue(stamp, transform.rotation);
+	HashValue(stamp, transform.scale);
+	HashValue(stamp, components.size());
+	for (const auto& comp : components) {
+		HashValue(stamp, comp->GetID());
+		HashValue(stamp, comp->GetPropertyRevision());
+		HashValue(stamp, comp->IsEnabled());
+		HashValue(stamp, comp->transform.position);
+		HashValue(stamp, comp->transform.rotation);
+		HashValue(stamp, comp->transform.scale);
+	}
+	return stamp;
+}
+
+std::vector<ColliderComponent*> Agent::GetColliders() const {
+	std::vector<ColliderComponent*> result;
+	for (const auto& comp : components) {
+		comp->CollectColliders(result);
+	}
+	return result;
+}
+
 Component* Agent::GetComponentByName(const std::string & name) {
 	for (auto& comp : components) {
 		if (comp->GetName() == name) {
@@ -207,6 +204,9 @@ void Agent::Deserialize(std::ifstream& in) {
 			else if (type == "HitboxCollider")    comp = AddComponent<HitboxCollider>();
 			else if (type == "StatsComponent")    comp = AddComponent<StatsComponent>();
 			else if (type == "AnimatorComponent") comp = AddComponent<AnimatorComponent>();
+			else if (type == "PathfinderComponent") comp = AddComponent<PathfindingComponent>();
+			else if (type == "RigidbodyComponent") comp = AddComponent<RigidbodyComponent>();
+			else if (type == "TilemapComponent") comp = AddComponent<TilemapComponent>();
 			else if (type == "ScriptComponent") {
 				ScriptManager& scriptManager = this->scene->GetScriptManager();
 				comp = AddComponent<ScriptComponent>(scriptManager);
@@ -293,6 +293,9 @@ void Agent::DrawImGui() {
 			AddComponent<ScriptComponent>(scriptManager);
 		}
 		if (ImGui::MenuItem("Stats")) AddComponent<StatsComponent>();
+		if (ImGui::MenuItem("Pathfinding")) AddComponent<PathfindingComponent>();
+		if (ImGui::MenuItem("Rigidbody")) AddComponent<RigidbodyComponent>();
+		if (ImGui::MenuItem("Tilemap")) AddComponent<TilemapComponent>();
 		ImGui::EndPopup();
 	}
 }
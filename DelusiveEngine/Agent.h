@@ -1,5 +1,6 @@
 #pragma once
 #include "TransformComponent.h"
+#include <Delusive/Steering.h>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -12,14 +13,17 @@
 #include "EditorInferface.h"
 
 class Component;
+class ColliderComponent;
 class PropertyRegistry;
 class Collider;
 class Scene;
+struct RenderTarget;
 
 
 class Agent {
 public:
 	TransformComponent transform;
+	Steering steering;
 
 	Agent();
 	virtual ~Agent();
@@ -44,8 +48,11 @@ public:
 	virtual void OnHit() {};
 	void HandleMouse(const glm::vec2&, bool);
 	virtual void SetEditorMode(bool);
+	bool IsEditorMode() const { return editorMode; }
+	bool IsInteracting() const { return interaction.isSelected || interaction.currentAction != EditorAction::None; }
 	virtual void HandleInput(const PlayerInputState&) {}
-	virtual GLuint RenderAgentToTexture(int width = 128, int height = 128);
+	//Draws the agent centered on the target, returns false if there is nothing to draw into
+	virtual bool RenderAgentToTexture(const RenderTarget&);
 
 	virtual void RegisterProperties();
 	void SetPosition(const glm::vec2& pos);
@@ -119,6 +126,13 @@ public:
 		);
 	}
 
+	//Changes whenever a property edit, a transform or a component add/remove touches the agent.
+	//Compare stamps around editor code to tell whether anything actually changed.
+	uint64_t GetEditStamp() const;
+
+	//Collider components plus colliders other components generate, such as merged tilemap solids
+	std::vector<ColliderComponent*> GetColliders() const;
+
 	Component* GetComponentByName(const std::string&);
 	Component* GetComponentByID(uint64_t id);
 	const std::vector<std::unique_ptr<Component>>& GetComponents() const;
@@ -145,7 +145,6 @@ bool Animation::LoadFromFile(const std::string& path) {
     for (auto& branch : data.branches) {
         for (auto& frame : branch.frames) {
             frame.dirty = true;
-            frame.previewTexture = 0;
         }
     }
 
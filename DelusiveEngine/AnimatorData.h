@@ -24,8 +24,7 @@ struct AnimationFrame {
     std::vector<FlagChange> flagChanges;
     std::vector<ComponentMod> componentOverrides;
 
-    //Texture preview control
-    GLuint previewTexture = 0;
+    //Set when the editor's cached preview of this frame needs redrawing
     bool dirty = true;
 };
 
@@ -1,4 +1,5 @@
 #include "ColliderComponent.h"
+#include "DeterministicMath.h"
 #include <iostream>
 
 template<typename T>
@@ -14,12 +15,21 @@ ColliderComponent::ColliderComponent(){
 void ColliderComponent::RegisterProperties() {
     Component::RegisterProperties();
     registry->Register("shape", reinterpret_cast<int*>(&shape));
+    registry->Register("layer", &layer);
+    registry->Register("collisionMask", &collisionMask);
+    registry->Register("continuous", &continuous);
+    registry->Register("wantsStay", &wantsStay);
+}
+
+int ColliderComponent::GetLayer() const {
+    if (layer >= 0 && layer < MaxCollisionLayers) return layer;
+    return DefaultLayerFor(GetColliderType());
 }
 
 Zone ColliderComponent::ComputeWorldArea() const {
     const glm::mat4 model =
-        GetOwner()->GetTransform().ToMatrix() *
-        transform.ToMatrix();
+        DeterministicMath::TransformMatrix(GetOwner()->GetTransform()) *
+        DeterministicMath::TransformMatrix(transform);
 
     Zone out{ {  std::numeric_limits<float>::infinity(),
                  std::numeric_limits<float>::infinity() },
@@ -28,8 +38,8 @@ Zone ColliderComponent::ComputeWorldArea() const {
 
     switch (shape) {
     case ShapeType::Box: {
-        // Local corners centered at origin, scaled by full size
-        const glm::vec2 he = 0.5f * transform.scale;
+        // Unit box corners, the model already carries the collider's size (as ColliderRenderer draws it)
+        const glm::vec2 he(0.5f);
         const glm::vec2 corners[4] = {
             {-he.x, -he.y}, { he.x, -he.y},
             { he.x,  he.y}, {-he.x,  he.y}
@@ -56,9 +66,9 @@ Zone ColliderComponent::ComputeWorldArea() const {
         break;
     }
     case ShapeType::Line: {
-        // Line from (0,0) to (len, 0) in local space
+        // Line from (0,0) to (1, 0) in local space, scaled to its length by the model
         glm::vec4 a = model * glm::vec4(0, 0, 0, 1);
-        glm::vec4 b = model * glm::vec4(transform.scale.x, 0, 0, 1);
+        glm::vec4 b = model * glm::vec4(1, 0, 0, 1);
         glm::vec2 p0(a.x, a.y), p1(b.x, b.y);
         out.min = glm::min(p0, p1);
         out.max = glm::max(p0, p1);
@@ -76,6 +86,24 @@ glm::vec2 ColliderComponent::GetMax() const {
     return ComputeWorldArea().max;
 }
 
+void ColliderComponent::GetWorldCircle(glm::vec2& center, float& radius) const {
+    const glm::mat4 agentMatrix = DeterministicMath::TransformMatrix(GetOwner()->GetTransform());
+    center = glm::vec2(agentMatrix * glm::vec4(transform.position, 0.0f, 1.0f));
+
+    float sx = glm::length(glm::vec2(agentMatrix[0]));
+    float sy = glm::length(glm::vec2(agentMatrix[1]));
+    radius = 0.5f * transform.scale.x * std::max(sx, sy);
+}
+
+void ColliderComponent::GetWorldSegment(glm::vec2& start, glm::vec2& end) const {
+    const glm::mat4 agentMatrix = DeterministicMath::TransformMatrix(GetOwner()->GetTransform());
+    glm::vec2 direction(DeterministicMath::Cos(transform.rotation), DeterministicMath::Sin(transform.rotation));
+    glm::vec2 localEnd = transform.position + direction * transform.scale.x;
+
+    start = glm::vec2(agentMatrix * glm::vec4(transform.position, 0.0f, 1.0f));
+    end = glm::vec2(agentMatrix * glm::vec4(localEnd, 0.0f, 1.0f));
+}
+
 void ColliderComponent::Draw(const ColliderRenderer& renderer, const glm::mat4& projection) const{
 	//std::cout << "[ColliderComponent] Draw called" << std::endl;
 	renderer.Draw(*this, projection);
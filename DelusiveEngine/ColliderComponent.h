@@ -3,19 +3,10 @@
 #include "TransformComponent.h"
 #include "ColliderRenderer.h"
 #include "Agent.h"
+#include "PhysicsTypes.h"
+#include <Delusive/Contact.h>
 #include <glm/glm.hpp>
 
-enum class ColliderType {
-	Solid,
-	Hitbox,
-	Hurtbox,
-	Trigger
-};
-
-struct Zone {
-	glm::vec2 min, max;
-};
-
 
 enum class ColliderHandleType {
     None,
@@ -24,12 +15,6 @@ enum class ColliderHandleType {
     TopLeft, TopRight, BottomLeft, BottomRight
 };
 
-enum class ShapeType {
-	Box,
-	Circle,
-	Line
-};
-
 enum class ColliderAction {
 	None,
 	Drag,
@@ -61,9 +46,29 @@ public:
 
 	glm::vec2 GetMin() const;
 	glm::vec2 GetMax() const;
+	Zone GetWorldBounds() const { return ComputeWorldArea(); }
+
+	//World-space shape, matching what ColliderRenderer draws
+	void GetWorldCircle(glm::vec2& center, float& radius) const;
+	void GetWorldSegment(glm::vec2& start, glm::vec2& end) const;
 
 	virtual ColliderType GetColliderType() const = 0;
 	virtual ShapeType GetShapeType() const { return shape; }
+	void SetShapeType(ShapeType _shape) { shape = _shape; }
+
+	//Layer index into the scene's CollisionLayers, -1 follows the collider type
+	int GetLayer() const;
+	void SetLayer(int _layer) { layer = _layer; }
+	uint32_t GetCollisionMask() const { return static_cast<uint32_t>(collisionMask); }
+	void SetCollisionMask(uint32_t mask) { collisionMask = static_cast<int>(mask); }
+
+	//Fast movers (dodges, knockback) are swept so they cannot tunnel through thin walls
+	bool IsContinuous() const { return continuous; }
+	void SetContinuous(bool _continuous) { continuous = _continuous; }
+
+	//Begin and End are always sent, Stay only to colliders (and their scripts) that ask for it
+	bool WantsStayEvents() const { return wantsStay; }
+	void SetWantsStayEvents(bool _wantsStay) { wantsStay = _wantsStay; }
 
 	virtual bool CheckCenterRender() const { return showCenter; }
 	virtual void ToggleCenterDisplay() { showCenter = !showCenter; };
@@ -71,11 +76,17 @@ public:
 	virtual void Draw(const ColliderRenderer&, const glm::mat4& ) const;
 	virtual bool DrawAnimatorImGui(ComponentMod&) override;
 	void HandleMouse(const glm::vec2&, bool) override;
+	void CollectColliders(std::vector<ColliderComponent*>& out) override { out.push_back(this); }
 
-	virtual void OnCollision(ColliderComponent* other) = 0;
+	//Called after the physics step. other is null on End when the other collider was removed.
+	virtual void OnContact(ContactPhase, ColliderComponent*) {}
 	ColliderAction FromColliderHandleType(ColliderHandleType h);
 protected:
 	ShapeType shape = ShapeType::Box;
+	int layer = -1;
+	int collisionMask = -1; // further restricts the layer's row in the matrix
+	bool continuous = false;
+	bool wantsStay = false;
 	bool showCenter = false;
 	ColliderHandleType activeHandle = ColliderHandleType::None;
 	ColliderAction currentAction = ColliderAction::None;
@@ -84,4 +95,18 @@ protected:
 	glm::vec2 dragStartSize;
 
 	Zone ComputeWorldArea() const;
+
+	//Shared by the collider Clone()s so play mode keeps the shape and the layer filtering
+	template<typename T>
+	std::unique_ptr<Component> CloneCollider() const {
+		auto clone = std::make_unique<T>();
+		clone->SetName(GetName());
+		clone->transform = transform;
+		clone->shape = shape;
+		clone->layer = layer;
+		clone->collisionMask = collisionMask;
+		clone->continuous = continuous;
+		clone->wantsStay = wantsStay;
+		return clone;
+	}
 };
\ No newline at end of file
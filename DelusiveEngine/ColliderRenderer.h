@@ -1,14 +1,15 @@
 #pragma once
 #include <glm/glm.hpp>
-#include "Shader.h"
 #include "ColliderComponent.h"
 #include "DelusiveRenderer.h"
+#include "DebugDraw.h"
 
 class ColliderComponent;
 
+//Turns collider shapes and their edit handles into DebugDraw lines, drawn when the frame flushes
 class ColliderRenderer {
 public:
-	ColliderRenderer();
+	ColliderRenderer(DebugDraw&);
 	ColliderRenderer(const ColliderRenderer&) = delete;
 	ColliderRenderer& operator=(const ColliderRenderer&) = delete;
 	~ColliderRenderer();
@@ -24,7 +25,6 @@ public:
 	void DrawLineHandles(const ColliderComponent&, const glm::mat4&) const;
 	void DrawHandle(const glm::vec2& center, const glm::mat4& projection) const;
 private:
-	GLuint VAO, VBO;
-	Shader* shader;
+	DebugDraw& debugDraw;
 	float handleSize = 12.0f;
 };
\ No newline at end of file
@@ -44,6 +44,10 @@ void Component::Deserialize(std::istream& in) {
     registry->Deserialize(block);
 }
 
+uint32_t Component::GetPropertyRevision() const {
+	return registry->GetRevision();
+}
+
 void Component::DrawImGui() {
     ImGui::Text("%s", GetType());
 	registry->DrawImGui();
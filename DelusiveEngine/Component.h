@@ -7,8 +7,10 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 class Agent;
+class ColliderComponent;
 class PropertyRegistry;
 
 class Component {
@@ -42,6 +44,9 @@ public:
 	virtual void HandleMouse(const glm::vec2&, bool) {}
 	virtual bool IsDragging() const { return isDragging; }
 
+	//Colliders this component contributes to its agent, see Agent::GetColliders
+	virtual void CollectColliders(std::vector<ColliderComponent*>&) {}
+
 	virtual void SetOwner(Agent* agent) { this->owner = agent; }
 	Agent* GetOwner() const { return owner; }
 
@@ -54,6 +59,9 @@ public:
 	virtual uint64_t GetID() const { return componentID; }
 	void SetID(uint64_t id) { componentID = id; }
 
+	//Bumped every time an inspector edit changes one of the registered properties
+	uint32_t GetPropertyRevision() const;
+
 	// Save/Load
 	virtual void Serialize(std::ostream& out) const;
 	virtual void Deserialize(std::istream& in);
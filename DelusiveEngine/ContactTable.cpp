@@ -0,0 +1,115 @@
+#include "ContactTable.h"
+
+uint64_t ContactTable::Hash(uint64_t key) {
+	// splitmix64 finalizer
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9ull;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111ebull;
+	key ^= key >> 31;
+	return key;
+}
+
+int ContactTable::FindSlot(uint64_t key) const {
+	if (keys.empty()) return -1;
+
+	size_t mask = keys.size() - 1;
+	for (size_t slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+		if (keys[slot] == key) return static_cast<int>(slot);
+		if (keys[slot] == EmptyKey) return -1;
+	}
+}
+
+Contact* ContactTable::Find(uint64_t key) {
+	int slot = FindSlot(key);
+	return slot < 0 ? nullptr : &contacts[slots[slot]];
+}
+
+Contact& ContactTable::Insert(uint64_t key) {
+	// Keep the load factor under one half
+	if ((contacts.size() + 1) * 2 > keys.size()) Grow();
+
+	size_t mask = keys.size() - 1;
+	size_t slot = Hash(key) & mask;
+	while (keys[slot] != EmptyKey) {
+		slot = (slot + 1) & mask;
+	}
+
+	keys[slot] = key;
+	slots[slot] = static_cast<int>(contacts.size());
+	contacts.emplace_back();
+	contacts.back().key = key;
+	return contacts.back();
+}
+
+void ContactTable::Remove(int index) {
+	size_t mask = keys.size() - 1;
+	size_t hole = static_cast<size_t>(FindSlot(contacts[index].key));
+	keys[hole] = EmptyKey;
+
+	// Back-shift any entry whose probe chain ran through the hole
+	for (size_t slot = (hole + 1) & mask; keys[slot] != EmptyKey; slot = (slot + 1) & mask) {
+		size_t home = Hash(keys[slot]) & mask;
+		bool reachable = (hole <= slot) ? (home > hole && home <= slot) : (home > hole || home <= slot);
+		if (reachable) continue;
+
+		keys[hole] = keys[slot];
+		slots[hole] = slots[slot];
+		keys[slot] = EmptyKey;
+		hole = slot;
+	}
+
+	int last = static_cast<int>(contacts.size()) - 1;
+	if (index != last) {
+		contacts[index] = contacts[last];
+		slots[FindSlot(contacts[index].key)] = index;
+	}
+	contacts.pop_back();
+}
+
+void ContactTable::Clear() {
+	keys.clear();
+	slots.clear();
+	contacts.clear();
+}
+
+void ContactTable::Grow() {
+	size_t capacity = keys.empty() ? 64 : keys.size() * 2;
+	keys.assign(capacity, EmptyKey);
+	slots.assign(capacity, -1);
+
+	size_t mask = capacity - 1;
+	for (int i = 0; i < static_cast<int>(contacts.size()); ++i) {
+		size_t slot = Hash(contacts[i].key) & mask;
+		while (keys[slot] != EmptyKey) {
+			slot = (slot + 1) & mask;
+		}
+		keys[slot] = contacts[i].key;
+		slots[slot] = i;
+	}
+}
+
+void ContactEventBuffer::Push(const ContactEvent& event) {
+	if (GetSize() == events.size()) {
+		// Full, unroll into a buffer twice the size
+		std::vector<ContactEvent> grown(events.empty() ? 256 : events.size() * 2);
+		uint32_t count = GetSize();
+		for (uint32_t i = 0; i < count; ++i) {
+			grown[i] = events[(head + i) & (events.size() - 1)];
+		}
+		events.swap(grown);
+		head = 0;
+		tail = count;
+	}
+
+	events[tail & (events.size() - 1)] = event;
+	++tail;
+}
+
+bool ContactEventBuffer::Pop(ContactEvent& event) {
+	if (head == tail) return false;
+
+	event = events[head & (events.size() - 1)];
+	++head;
+	return true;
+}
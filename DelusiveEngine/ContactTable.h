@@ -0,0 +1,69 @@
+#pragma once
+#include "PhysicsTypes.h"
+#include <Delusive/Contact.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//Persistent overlapping pair, keyed by the two collider IDs
+struct Contact {
+	uint64_t key = 0;
+	ColliderComponent* a = nullptr;
+	ColliderComponent* b = nullptr;
+	uint32_t idA = 0, idB = 0;
+	uint64_t agentA = 0, agentB = 0;
+	int layerA = 0, layerB = 0;
+	bool stayA = false, stayB = false; // that side wants Stay events
+	uint32_t lastStep = 0;
+};
+
+struct ContactEvent {
+	ContactPhase phase = ContactPhase::Begin;
+	Contact contact;
+	bool removedA = false; // End only: that side no longer exists
+	bool removedB = false;
+};
+
+//Open-addressing (linear probing) map from pair key to a dense contact array.
+//Removal swaps with the last contact and back-shifts the probe chain, so no tombstones build up.
+class ContactTable {
+public:
+	static uint64_t MakeKey(uint32_t idA, uint32_t idB) {
+		if (idA > idB) std::swap(idA, idB);
+		return (static_cast<uint64_t>(idA) << 32) | idB;
+	}
+
+	Contact* Find(uint64_t key);
+	Contact& Insert(uint64_t key);
+	void Remove(int index);
+	void Clear();
+
+	std::vector<Contact>& GetContacts() { return contacts; }
+	const std::vector<Contact>& GetContacts() const { return contacts; }
+	int GetCapacity() const { return static_cast<int>(keys.size()); }
+
+private:
+	static constexpr uint64_t EmptyKey = ~0ull;
+
+	std::vector<uint64_t> keys;
+	std::vector<int> slots; // dense index per key slot
+	std::vector<Contact> contacts;
+
+	static uint64_t Hash(uint64_t key);
+	int FindSlot(uint64_t key) const;
+	void Grow();
+};
+
+//Growable ring buffer of contact events, filled by the physics step and drained after it
+class ContactEventBuffer {
+public:
+	void Push(const ContactEvent&);
+	bool Pop(ContactEvent&);
+	void Clear() { head = tail = 0; }
+	uint32_t GetSize() const { return tail - head; }
+
+private:
+	std::vector<ContactEvent> events; // power of two sized
+	uint32_t head = 0;
+	uint32_t tail = 0;
+};
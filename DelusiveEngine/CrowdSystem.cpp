@@ -0,0 +1,386 @@
+#include "CrowdSystem.h"
+#include "Scene.h"
+#include "Agent.h"
+#include "PathfindingComponent.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+// Linear programs follow the RVO2 reference solver for agent-agent constraints
+namespace {
+	constexpr float CrowdEpsilon = 0.00001f;
+
+	struct OrcaLine {
+		glm::vec2 point;
+		glm::vec2 direction;
+	};
+
+	float Det(glm::vec2 a, glm::vec2 b) {
+		return a.x * b.y - a.y * b.x;
+	}
+
+	bool LinearProgram1(const std::vector<OrcaLine>& lines, size_t lineNo, float radius,
+		glm::vec2 optVelocity, bool directionOpt, glm::vec2& result) {
+		const OrcaLine& line = lines[lineNo];
+		float dotProduct = glm::dot(line.point, line.direction);
+		float discriminant = dotProduct * dotProduct + radius * radius - glm::dot(line.point, line.point);
+		if (discriminant < 0.0f) return false; // max speed circle misses the line
+
+		float sqrtDiscriminant = std::sqrt(discriminant);
+		float tLeft = -dotProduct - sqrtDiscriminant;
+		float tRight = -dotProduct + sqrtDiscriminant;
+
+		for (size_t i = 0; i < lineNo; ++i) {
+			float denominator = Det(line.direction, lines[i].direction);
+			float numerator = Det(lines[i].direction, line.point - lines[i].point);
+
+			if (std::fabs(denominator) <= CrowdEpsilon) {
+				if (numerator < 0.0f) return false; // parallel and infeasible
+				continue;
+			}
+
+			float t = numerator / denominator;
+			if (denominator >= 0.0f) tRight = std::min(tRight, t);
+			else tLeft = std::max(tLeft, t);
+
+			if (tLeft > tRight) return false;
+		}
+
+		if (directionOpt) {
+			result = line.point + (glm::dot(optVelocity, line.direction) > 0.0f ? tRight : tLeft) * line.direction;
+		}
+		else {
+			float t = glm::clamp(glm::dot(line.direction, optVelocity - line.point), tLeft, tRight);
+			result = line.point + t * line.direction;
+		}
+		return true;
+	}
+
+	size_t LinearProgram2(const std::vector<OrcaLine>& lines, float radius, glm::vec2 optVelocity,
+		bool directionOpt, glm::vec2& result) {
+		if (directionOpt) {
+			result = optVelocity * radius;
+		}
+		else if (glm::dot(optVelocity, optVelocity) > radius * radius) {
+			result = glm::normalize(optVelocity) * radius;
+		}
+		else {
+			result = optVelocity;
+		}
+
+		for (size_t i = 0; i < lines.size(); ++i) {
+			if (Det(lines[i].direction, lines[i].point - result) > 0.0f) {
+				glm::vec2 previous = result;
+				if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result)) {
+					result = previous;
+					return i;
+				}
+			}
+		}
+		return lines.size();
+	}
+
+	// Infeasible case: minimize the largest constraint violation instead
+	void LinearProgram3(const std::vector<OrcaLine>& lines, size_t beginLine, float radius,
+		glm::vec2& result, std::vector<OrcaLine>& projectedLines) {
+		float distance = 0.0f;
+
+		for (size_t i = beginLine; i < lines.size(); ++i) {
+			if (Det(lines[i].direction, lines[i].point - result) <= distance) continue;
+
+			projectedLines.clear();
+			for (size_t j = 0; j < i; ++j) {
+				OrcaLine line;
+				float determinant = Det(lines[i].direction, lines[j].direction);
+
+				if (std::fabs(determinant) <= CrowdEpsilon) {
+					if (glm::dot(lines[i].direction, lines[j].direction) > 0.0f) continue;
+					line.point = 0.5f * (lines[i].point + lines[j].point);
+				}
+				else {
+					line.point = lines[i].point
+						+ (Det(lines[j].direction, lines[i].point - lines[j].point) / determinant) * lines[i].direction;
+				}
+
+				line.direction = glm::normalize(lines[j].direction - lines[i].direction);
+				projectedLines.push_back(line);
+			}
+
+			glm::vec2 previous = result;
+			glm::vec2 direction(-lines[i].direction.y, lines[i].direction.x);
+			if (LinearProgram2(projectedLines, radius, direction, true, result) < projectedLines.size()) {
+				result = previous; // numerical trouble, keep the last good answer
+			}
+
+			distance = Det(lines[i].direction, lines[i].point - result);
+		}
+	}
+}
+
+CrowdSystem::CrowdSystem(DelusiveRenderer& _renderer)
+	: SceneSystem(_renderer)
+{
+	name = "New CrowdSystem";
+	RegisterProperties();
+}
+
+void CrowdSystem::RegisterProperties() {
+	SceneSystem::RegisterProperties();
+
+	registry.Register("neighborDistance", &neighborDistance);
+	registry.Register("maxNeighbors", &maxNeighbors);
+	registry.Register("timeHorizon", &timeHorizon);
+}
+
+std::unique_ptr<SceneSystem> CrowdSystem::Clone() const {
+	auto clone = std::make_unique<CrowdSystem>(renderer);
+	clone->SetName(name);
+	clone->neighborDistance = neighborDistance;
+	clone->maxNeighbors = maxNeighbors;
+	clone->timeHorizon = timeHorizon;
+	return clone;
+}
+
+void CrowdSystem::Update(float deltaTime) {
+	if (!scene || deltaTime <= 0.0f) return;
+
+	crowd.clear();
+	crowdOwners.clear();
+	for (auto& agent : scene->GetAgents()) {
+		if (!agent) continue;
+
+		PathfindingComponent* pathfinder = agent->GetComponent<PathfindingComponent>();
+		agent->steering.active = pathfinder && pathfinder->IsEnabled();
+		if (!agent->steering.active) continue;
+
+		CrowdAgent entry;
+		entry.position = agent->GetTransform().position;
+		entry.velocity = agent->steering.velocity;
+		entry.preferredVelocity = agent->steering.preferredVelocity;
+		entry.radius = pathfinder->GetRadius();
+		entry.maxSpeed = pathfinder->GetSpeed();
+		entry.newVelocity = entry.velocity;
+		crowd.push_back(entry);
+		crowdOwners.push_back(agent.get());
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	Step(crowd, deltaTime);
+	lastStepMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	for (size_t i = 0; i < crowd.size(); ++i) {
+		crowdOwners[i]->steering.velocity = crowd[i].newVelocity;
+	}
+}
+
+void CrowdSystem::Step(std::vector<CrowdAgent>& agents, float deltaTime) {
+	if (agents.empty()) return;
+
+	BuildBuckets(agents);
+
+	// Agents only read the previous velocities, so every solve is independent
+	JobSystem::ParallelFor(static_cast<int>(agents.size()), 64, [&](int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			glm::vec2 result;
+			SolveAgent(agents, i, deltaTime, result);
+			agents[i].newVelocity = result;
+		}
+	});
+
+	for (CrowdAgent& agent : agents) {
+		agent.velocity = agent.newVelocity;
+	}
+}
+
+glm::ivec2 CrowdSystem::CellOf(glm::vec2 position) const {
+	return glm::ivec2(glm::floor(position / std::max(neighborDistance, CrowdEpsilon)));
+}
+
+int CrowdSystem::BucketOf(glm::ivec2 cell) const {
+	uint32_t h = static_cast<uint32_t>(cell.x) * 73856093u ^ static_cast<uint32_t>(cell.y) * 19349663u;
+	return static_cast<int>(h & static_cast<uint32_t>(bucketMask));
+}
+
+void CrowdSystem::BuildBuckets(const std::vector<CrowdAgent>& agents) {
+	int bucketCount = 1;
+	while (bucketCount < static_cast<int>(agents.size()) * 2) bucketCount <<= 1;
+	bucketMask = bucketCount - 1;
+
+	bucketStart.assign(bucketCount + 1, 0);
+	bucketAgents.resize(agents.size());
+
+	std::vector<int> agentBucket(agents.size());
+	for (size_t i = 0; i < agents.size(); ++i) {
+		agentBucket[i] = BucketOf(CellOf(agents[i].position));
+		++bucketStart[agentBucket[i] + 1];
+	}
+	for (int b = 0; b < bucketCount; ++b) {
+		bucketStart[b + 1] += bucketStart[b];
+	}
+
+	std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+	for (size_t i = 0; i < agents.size(); ++i) {
+		bucketAgents[fill[agentBucket[i]]++] = static_cast<int>(i);
+	}
+}
+
+void CrowdSystem::SolveAgent(const std::vector<CrowdAgent>& agents, int index, float deltaTime, glm::vec2& result) const {
+	struct Neighbor {
+		float distanceSq;
+		int index;
+	};
+
+	thread_local std::vector<Neighbor> neighbors;
+	thread_local std::vector<OrcaLine> lines;
+	thread_local std::vector<OrcaLine> projectedLines;
+	thread_local std::vector<int> visitedBuckets;
+
+	const CrowdAgent& self = agents[index];
+	const float rangeSq = neighborDistance * neighborDistance;
+	const size_t neighborLimit = static_cast<size_t>(std::max(maxNeighbors, 0));
+
+	// Closest neighbours within range, kept sorted by insertion. A limit of 0 turns avoidance off.
+	neighbors.clear();
+	visitedBuckets.clear();
+	glm::ivec2 cell = CellOf(self.position);
+	for (int dy = -1; dy <= 1 && neighborLimit > 0; ++dy) {
+		for (int dx = -1; dx <= 1; ++dx) {
+			int bucket = BucketOf(cell + glm::ivec2(dx, dy));
+			if (std::find(visitedBuckets.begin(), visitedBuckets.end(), bucket) != visitedBuckets.end()) continue;
+			visitedBuckets.push_back(bucket);
+
+			for (int k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+				int other = bucketAgents[k];
+				if (other == index) continue;
+
+				glm::vec2 offset = agents[other].position - self.position;
+				float distanceSq = glm::dot(offset, offset);
+				if (distanceSq >= rangeSq) continue;
+				if (neighbors.size() == neighborLimit && distanceSq >= neighbors.back().distanceSq) continue;
+
+				if (neighbors.size() < neighborLimit) neighbors.push_back({ distanceSq, other });
+				else neighbors.back() = { distanceSq, other };
+
+				for (size_t n = neighbors.size() - 1; n > 0 && neighbors[n].distanceSq < neighbors[n - 1].distanceSq; --n) {
+					std::swap(neighbors[n], neighbors[n - 1]);
+				}
+			}
+		}
+	}
+
+	// One half-plane per neighbour: each agent takes half the responsibility for avoiding the other
+	lines.clear();
+	const float invTimeHorizon = 1.0f / std::max(timeHorizon, CrowdEpsilon);
+	for (const Neighbor& neighbor : neighbors) {
+		const CrowdAgent& other = agents[neighbor.index];
+
+		glm::vec2 relativePosition = other.position - self.position;
+		glm::vec2 relativeVelocity = self.velocity - other.velocity;
+		float distanceSq = neighbor.distanceSq;
+		float combinedRadius = self.radius + other.radius;
+		float combinedRadiusSq = combinedRadius * combinedRadius;
+
+		OrcaLine line;
+		glm::vec2 u;
+
+		if (distanceSq > combinedRadiusSq) {
+			glm::vec2 w = relativeVelocity - invTimeHorizon * relativePosition;
+			float wLengthSq = glm::dot(w, w);
+			float dotProduct = glm::dot(w, relativePosition);
+
+			if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSq * wLengthSq) {
+				// Project on the cut-off circle
+				float wLength = std::sqrt(wLengthSq);
+				glm::vec2 unitW = w / wLength;
+				line.direction = glm::vec2(unitW.y, -unitW.x);
+				u = (combinedRadius * invTimeHorizon - wLength) * unitW;
+			}
+			else {
+				// Project on the nearer leg of the velocity obstacle
+				float leg = std::sqrt(distanceSq - combinedRadiusSq);
+				if (Det(relativePosition, w) > 0.0f) {
+					line.direction = glm::vec2(relativePosition.x * leg - relativePosition.y * combinedRadius,
+						relativePosition.x * combinedRadius + relativePosition.y * leg) / distanceSq;
+				}
+				else {
+					line.direction = -glm::vec2(relativePosition.x * leg + relativePosition.y * combinedRadius,
+						-relativePosition.x * combinedRadius + relativePosition.y * leg) / distanceSq;
+				}
+				u = glm::dot(relativeVelocity, line.direction) * line.direction - relativeVelocity;
+			}
+		}
+		else {
+			// Already overlapping: resolve within this step
+			float invTimeStep = 1.0f / deltaTime;
+			glm::vec2 w = relativeVelocity - invTimeStep * relativePosition;
+			float wLength = glm::length(w);
+			glm::vec2 unitW = wLength > CrowdEpsilon ? w / wLength : glm::vec2(1.0f, 0.0f);
+			line.direction = glm::vec2(unitW.y, -unitW.x);
+			u = (combinedRadius * invTimeStep - wLength) * unitW;
+		}
+
+		line.point = self.velocity + 0.5f * u;
+		lines.push_back(line);
+	}
+
+	size_t lineFail = LinearProgram2(lines, self.maxSpeed, self.preferredVelocity, false, result);
+	if (lineFail < lines.size()) {
+		LinearProgram3(lines, lineFail, self.maxSpeed, result, projectedLines);
+	}
+}
+
+// Two groups crossing through each other, sized like a busy scene
+void CrowdSystem::RunBenchmark() {
+	std::vector<CrowdAgent> agents;
+	agents.reserve(benchmarkAgents);
+
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+	int columns = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(benchmarkAgents))));
+	for (int i = 0; i < benchmarkAgents; ++i) {
+		bool left = (i % 2) == 0;
+		glm::vec2 position((left ? -1.0f : 1.0f) * (10.0f + (i / 2) % columns), static_cast<float>((i / 2) / columns));
+		position += glm::vec2(jitter(rng), jitter(rng));
+
+		CrowdAgent agent;
+		agent.position = position;
+		agent.velocity = glm::vec2(0.0f);
+		agent.preferredVelocity = glm::vec2(left ? 2.0f : -2.0f, 0.0f);
+		agent.radius = 0.4f;
+		agent.maxSpeed = 2.0f;
+		agent.newVelocity = glm::vec2(0.0f);
+		agents.push_back(agent);
+	}
+
+	const int ticks = 30;
+	const float deltaTime = 1.0f / 60.0f;
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < ticks; ++t) {
+		Step(agents, deltaTime);
+		for (CrowdAgent& agent : agents) {
+			agent.position += agent.velocity * deltaTime;
+		}
+	}
+	benchmarkMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() / ticks;
+}
+
+void CrowdSystem::DrawImGui() {
+	ImGui::SeparatorText("Crowd System");
+
+	ImGui::DragFloat("Neighbor Distance", &neighborDistance, 0.05f, 0.1f, 50.0f);
+	ImGui::DragInt("Max Neighbors", &maxNeighbors, 1.0f, 0, 64);
+	ImGui::DragFloat("Time Horizon", &timeHorizon, 0.05f, 0.1f, 10.0f);
+
+	ImGui::Text("Agents: %zu", crowd.size());
+	ImGui::Text("Last step: %.3f ms (%d workers)", lastStepMs, JobSystem::GetWorkerCount() + 1);
+
+	ImGui::SeparatorText("Benchmark");
+	ImGui::InputInt("Agents", &benchmarkAgents);
+	benchmarkAgents = std::clamp(benchmarkAgents, 1, 100000);
+	if (ImGui::Button("Run Benchmark")) {
+		RunBenchmark();
+	}
+	ImGui::Text("Average step: %.3f ms", benchmarkMs);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include "SceneSystem.h"
+
+//Per-agent state for one crowd step
+struct CrowdAgent {
+	glm::vec2 position;
+	glm::vec2 velocity;
+	glm::vec2 preferredVelocity;
+	float radius;
+	float maxSpeed;
+	glm::vec2 newVelocity;
+};
+
+//Local avoidance for every agent with a PathfindingComponent.
+//Each tick solves ORCA (optimal reciprocal collision avoidance) against nearby agents
+//found through a spatial hash, and writes the result to Agent::steering.
+class CrowdSystem : public SceneSystem {
+public:
+	CrowdSystem(DelusiveRenderer&);
+
+	void RegisterProperties() override;
+	std::string GetType() const override { return "CrowdSystem"; }
+
+	void Update(float) override;
+	void Draw(const glm::mat4&) override {};
+	void Reset() override {};
+	void DrawImGui() override;
+
+	std::unique_ptr<SceneSystem> Clone() const override;
+
+	//Solves new velocities for a batch of agents, runs across the JobSystem
+	void Step(std::vector<CrowdAgent>&, float deltaTime);
+
+private:
+	float neighborDistance = 3.0f;
+	int maxNeighbors = 10;
+	float timeHorizon = 2.0f;
+
+	std::vector<CrowdAgent> crowd;
+	std::vector<Agent*> crowdOwners;
+
+	//Spatial hash, rebuilt every step with a counting sort
+	std::vector<int> bucketStart;
+	std::vector<int> bucketAgents;
+	int bucketMask = 0;
+
+	float lastStepMs = 0.0f;
+	float benchmarkMs = 0.0f;
+	int benchmarkAgents = 2000;
+
+	void BuildBuckets(const std::vector<CrowdAgent>&);
+	int BucketOf(glm::ivec2 cell) const;
+	glm::ivec2 CellOf(glm::vec2 position) const;
+	void SolveAgent(const std::vector<CrowdAgent>&, int index, float deltaTime, glm::vec2& result) const;
+	void RunBenchmark();
+};
@@ -0,0 +1,46 @@
+#include "CullingGrid.h"
+#include <algorithm>
+
+void CullingGrid::Clear() {
+	cells.clear();
+	oversized.clear();
+	bounds.clear();
+	stamps.clear();
+	queryStamp = 0;
+}
+
+void CullingGrid::Insert(int item, const Zone& itemBounds) {
+	if (item >= static_cast<int>(bounds.size())) {
+		bounds.resize(item + 1, Zone{ glm::vec2(0.0f), glm::vec2(0.0f) });
+		stamps.resize(item + 1, 0);
+	}
+	bounds[item] = itemBounds;
+
+	const glm::vec2 size = itemBounds.max - itemBounds.min;
+	if (!std::isfinite(size.x) || !std::isfinite(size.y)
+		|| size.x > cellSize * MaxCellSpan || size.y > cellSize * MaxCellSpan) {
+		oversized.push_back(item);
+		return;
+	}
+
+	const int x0 = CellCoord(itemBounds.min.x), x1 = CellCoord(itemBounds.max.x);
+	const int y0 = CellCoord(itemBounds.min.y), y1 = CellCoord(itemBounds.max.y);
+	if (x1 - x0 >= MaxCellSpan || y1 - y0 >= MaxCellSpan) {
+		oversized.push_back(item);
+		return;
+	}
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			cells[CellKey(x, y)].push_back(item);
+		}
+	}
+}
+
+uint32_t CullingGrid::NextStamp() const {
+	if (++queryStamp == 0) {
+		std::fill(stamps.begin(), stamps.end(), 0u);
+		queryStamp = 1;
+	}
+	return queryStamp;
+}
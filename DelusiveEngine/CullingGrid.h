@@ -0,0 +1,77 @@
+#pragma once
+#include "PhysicsTypes.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+
+//Uniform hash grid for items that never move (environment sprites and colliders).
+//Items spanning more than MaxCellSpan cells per axis go to a list checked on every query.
+class CullingGrid {
+public:
+	static constexpr int MaxCellSpan = 8;
+
+	explicit CullingGrid(float _cellSize = 16.0f) : cellSize(_cellSize) {}
+
+	void Clear();
+	void Insert(int item, const Zone& bounds);
+
+	int GetItemCount() const { return static_cast<int>(bounds.size()); }
+	int GetCellCount() const { return static_cast<int>(cells.size()); }
+	const Zone& GetBounds(int item) const { return bounds[item]; }
+
+	//Callback(int item) is invoked once per item whose bounds overlap view
+	template<typename Callback>
+	void Query(const Zone& view, Callback&& callback) const;
+
+private:
+	float cellSize;
+	std::unordered_map<uint64_t, std::vector<int>> cells;
+	std::vector<int> oversized;
+	std::vector<Zone> bounds;
+	mutable std::vector<uint32_t> stamps;
+	mutable uint32_t queryStamp = 0;
+
+	int CellCoord(float v) const { return static_cast<int>(std::floor(v / cellSize)); }
+	static uint64_t CellKey(int x, int y) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+	static bool Overlaps(const Zone& a, const Zone& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+	uint32_t NextStamp() const;
+};
+
+template<typename Callback>
+void CullingGrid::Query(const Zone& view, Callback&& callback) const {
+	const uint32_t stamp = NextStamp();
+	auto visit = [&](int item) {
+		if (stamps[item] == stamp) return;
+		stamps[item] = stamp;
+		if (Overlaps(bounds[item], view)) callback(item);
+	};
+
+	for (int item : oversized) visit(item);
+
+	if (cells.empty()) return;
+	//A huge view (zoomed far out) is cheaper to answer by walking the occupied cells
+	const double spanX = std::floor(double(view.max.x) / cellSize) - std::floor(double(view.min.x) / cellSize) + 1.0;
+	const double spanY = std::floor(double(view.max.y) / cellSize) - std::floor(double(view.min.y) / cellSize) + 1.0;
+	if (!(spanX * spanY <= static_cast<double>(cells.size()))) {
+		for (const auto& [key, list] : cells) {
+			for (int item : list) visit(item);
+		}
+		return;
+	}
+
+	const int x0 = CellCoord(view.min.x), x1 = CellCoord(view.max.x);
+	const int y0 = CellCoord(view.min.y), y1 = CellCoord(view.max.y);
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			auto it = cells.find(CellKey(x, y));
+			if (it == cells.end()) continue;
+			for (int item : it->second) visit(item);
+		}
+	}
+}
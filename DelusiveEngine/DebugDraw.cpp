@@ -0,0 +1,164 @@
+#include "DebugDraw.h"
+#include "DelusiveMacros.h"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+	constexpr int CircleSegments = 32;
+
+	struct UnitCircle {
+		glm::vec2 points[CircleSegments + 1];
+		UnitCircle() {
+			for (int i = 0; i <= CircleSegments; ++i) {
+				float angle = (float)i / CircleSegments * glm::two_pi<float>();
+				points[i] = glm::vec2(std::cos(angle), std::sin(angle));
+			}
+		}
+	};
+}
+
+DebugDraw::DebugDraw() {
+	// The nav grid can be thousands of cells, it is opt in
+	for (bool& category : enabled) category = true;
+	enabled[static_cast<int>(DebugCategory::NavGrid)] = false;
+}
+
+DebugDraw::~DebugDraw() {
+	Shutdown();
+}
+
+void DebugDraw::Init() {
+	Shutdown();
+
+	shader = std::make_unique<Shader>(DEFAULT_DEBUG_VERT, DEFAULT_DEBUG_FRAG);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DebugDraw::Shutdown() {
+	if (VBO) glDeleteBuffers(1, &VBO);
+	if (VAO) glDeleteVertexArrays(1, &VAO);
+	VAO = VBO = 0;
+	shader.reset();
+}
+
+const char* DebugDraw::GetCategoryName(DebugCategory category) {
+	switch (category) {
+	case DebugCategory::Colliders: return "Colliders";
+	case DebugCategory::Handles: return "Handles";
+	case DebugCategory::NavGrid: return "Nav Grid";
+	case DebugCategory::General: return "General";
+	default: return "";
+	}
+}
+
+void DebugDraw::Line(DebugCategory category, glm::vec2 a, glm::vec2 b, const glm::vec4& color) {
+	if (!IsEnabled(category)) return;
+	lines.push_back({ a, color });
+	lines.push_back({ b, color });
+}
+
+void DebugDraw::Rect(DebugCategory category, glm::vec2 center, glm::vec2 size, const glm::vec4& color) {
+	if (!IsEnabled(category)) return;
+	const glm::vec2 half = size * 0.5f;
+	const glm::vec2 corners[4] = {
+		center + glm::vec2(-half.x, -half.y),
+		center + glm::vec2(half.x, -half.y),
+		center + glm::vec2(half.x, half.y),
+		center + glm::vec2(-half.x, half.y)
+	};
+	for (int i = 0; i < 4; ++i) {
+		lines.push_back({ corners[i], color });
+		lines.push_back({ corners[(i + 1) % 4], color });
+	}
+}
+
+void DebugDraw::Box(DebugCategory category, const glm::mat4& transform, const glm::vec4& color) {
+	if (!IsEnabled(category)) return;
+	glm::vec2 corners[4];
+	const glm::vec2 local[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+	for (int i = 0; i < 4; ++i) {
+		corners[i] = glm::vec2(transform * glm::vec4(local[i], 0.0f, 1.0f));
+	}
+	for (int i = 0; i < 4; ++i) {
+		lines.push_back({ corners[i], color });
+		lines.push_back({ corners[(i + 1) % 4], color });
+	}
+}
+
+void DebugDraw::Circle(DebugCategory category, const glm::mat4& transform, glm::vec2 center, float radius, const glm::vec4& color) {
+	if (!IsEnabled(category)) return;
+	static const UnitCircle unit;
+
+	glm::vec2 previous = glm::vec2(transform * glm::vec4(center + unit.points[0] * radius, 0.0f, 1.0f));
+	for (int i = 1; i <= CircleSegments; ++i) {
+		const glm::vec2 next = glm::vec2(transform * glm::vec4(center + unit.points[i] * radius, 0.0f, 1.0f));
+		lines.push_back({ previous, color });
+		lines.push_back({ next, color });
+		previous = next;
+	}
+}
+
+void DebugDraw::Handle(DebugCategory category, glm::vec2 center, float size, const glm::vec4& color) {
+	if (!IsEnabled(category)) return;
+	const float half = size * 0.5f;
+	const Vertex bottomLeft{ center + glm::vec2(-half, -half), color };
+	const Vertex bottomRight{ center + glm::vec2(half, -half), color };
+	const Vertex topRight{ center + glm::vec2(half, half), color };
+	const Vertex topLeft{ center + glm::vec2(-half, half), color };
+	triangles.insert(triangles.end(), { bottomLeft, bottomRight, topRight, bottomLeft, topRight, topLeft });
+}
+
+void DebugDraw::Flush(const glm::mat4& projection) {
+	stats = Stats{};
+	stats.lines = static_cast<int>(lines.size() / 2);
+	stats.triangles = static_cast<int>(triangles.size() / 3);
+
+	if (!shader || (lines.empty() && triangles.empty())) {
+		lines.clear();
+		triangles.clear();
+		return;
+	}
+
+	GLboolean wasBlend = glIsEnabled(GL_BLEND);
+	if (!wasBlend) glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	shader->Use();
+	shader->SetMat4("projection", projection);
+
+	// Lines then triangles in one orphaned upload
+	const size_t lineBytes = lines.size() * sizeof(Vertex);
+	const size_t triangleBytes = triangles.size() * sizeof(Vertex);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, lineBytes + triangleBytes, nullptr, GL_STREAM_DRAW);
+	if (lineBytes) glBufferSubData(GL_ARRAY_BUFFER, 0, lineBytes, lines.data());
+	if (triangleBytes) glBufferSubData(GL_ARRAY_BUFFER, lineBytes, triangleBytes, triangles.data());
+
+	if (!lines.empty()) {
+		glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(lines.size()));
+		++stats.drawCalls;
+	}
+	if (!triangles.empty()) {
+		glDrawArrays(GL_TRIANGLES, static_cast<GLint>(lines.size()), static_cast<GLsizei>(triangles.size()));
+		++stats.drawCalls;
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (!wasBlend) glDisable(GL_BLEND);
+
+	lines.clear();
+	triangles.clear();
+}
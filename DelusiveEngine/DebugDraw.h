@@ -0,0 +1,60 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "Shader.h"
+
+enum class DebugCategory { Colliders = 0, Handles, NavGrid, General, Count };
+
+//Immediate-mode debug shapes. Everything added during a frame goes into one vertex buffer
+//and Flush draws it with at most two calls: one for lines, one for filled handles.
+//Shapes in a disabled category are dropped when added.
+class DebugDraw {
+public:
+	struct Vertex {
+		glm::vec2 position;
+		glm::vec4 color;
+	};
+
+	struct Stats {
+		int lines = 0;
+		int triangles = 0;
+		int drawCalls = 0;
+	};
+
+	DebugDraw();
+	~DebugDraw();
+	DebugDraw(const DebugDraw&) = delete;
+	DebugDraw& operator=(const DebugDraw&) = delete;
+
+	void Init();
+	void Shutdown();
+
+	bool IsEnabled(DebugCategory category) const { return enabled[static_cast<int>(category)]; }
+	void SetEnabled(DebugCategory category, bool value) { enabled[static_cast<int>(category)] = value; }
+	static const char* GetCategoryName(DebugCategory);
+
+	void Line(DebugCategory, glm::vec2 a, glm::vec2 b, const glm::vec4& color);
+	//Axis aligned outline around center
+	void Rect(DebugCategory, glm::vec2 center, glm::vec2 size, const glm::vec4& color);
+	//Outline of the unit quad (-0.5..0.5) under transform
+	void Box(DebugCategory, const glm::mat4& transform, const glm::vec4& color);
+	//Circle in transform's local space, so non-uniform scale gives an ellipse like the collider does
+	void Circle(DebugCategory, const glm::mat4& transform, glm::vec2 center, float radius, const glm::vec4& color);
+	//Filled square, size in world units
+	void Handle(DebugCategory, glm::vec2 center, float size, const glm::vec4& color);
+
+	//Draws and clears everything added since the last flush
+	void Flush(const glm::mat4& projection);
+	const Stats& GetStats() const { return stats; }
+
+private:
+	bool enabled[static_cast<int>(DebugCategory::Count)];
+	std::vector<Vertex> lines;
+	std::vector<Vertex> triangles;
+
+	std::unique_ptr<Shader> shader;
+	GLuint VAO = 0, VBO = 0;
+	Stats stats;
+};
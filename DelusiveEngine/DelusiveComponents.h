@@ -9,4 +9,6 @@
 #include "TransformComponent.h"
 #include "AnimatorComponent.h"
 #include "PathfindingComponent.h"
-#include "ScriptComponent.h"
\ No newline at end of file
+#include "RigidbodyComponent.h"
+#include "ScriptComponent.h"
+#include "TilemapComponent.h"
\ No newline at end of file
@@ -7,7 +7,11 @@
 #include "Font.h"
 #include "BehaviourScript.h"
 #include "ScriptManager.h"
+#include "UnitQuad.h"
+#include "TextBatch.h"
+#include "TextLayout.h"
 #include <memory>
+#include <vector>
 #include <iostream>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -52,23 +56,12 @@ struct DelusiveTexture {
 			texture = new Texture(texturePath.c_str());
 		}
 
-		float vertices[] = {
-			// pos       // tex
-			-0.5f, -0.5f,  0.0f, 0.0f,
-			 0.5f, -0.5f,  1.0f, 0.0f,
-			 0.5f,  0.5f,  1.0f, 1.0f,
-
-			 0.5f,  0.5f,  1.0f, 1.0f,
-			-0.5f,  0.5f,  0.0f, 1.0f,
-			-0.5f, -0.5f,  0.0f, 0.0f
-		};
-
 		glGenVertexArrays(1, &VAO);
 		glGenBuffers(1, &VBO);
 
 		glBindVertexArray(VAO);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(UnitQuadVertices), UnitQuadVertices, GL_STATIC_DRAW);
 
 		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(0);
@@ -104,7 +97,7 @@ struct DelusiveTexture {
 		shader->SetMat4("projection", glm::value_ptr(projection));
 
 		glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
+		glDrawArrays(GL_TRIANGLES, 0, UnitQuadVertexCount);
 		glBindVertexArray(0);
 	}
 };
@@ -114,10 +107,12 @@ struct DelusiveFont {
     std::string previousFontPath = "";
     float fontSize = 16.0f;            // desired draw size in pixels (runtime scaling)
     float loadedPixelHeight = 0.0f;    // the pixel height used to load glyphs
+    bool sdf = false;                  // distance field atlas, one load serves every fontSize
 
     GLuint VAO = 0, VBO = 0;
     Shader* shader = nullptr;
-    std::unique_ptr<Font> font;        // your Font class (owns glyph textures/metrics)
+    Shader* sdfShader = nullptr;
+    std::shared_ptr<Font> font;        // shared with every DelusiveFont using the same atlas
 
     DelusiveFont() = default;
     ~DelusiveFont() { Cleanup(); }
@@ -126,10 +121,11 @@ struct DelusiveFont {
         if (VAO) { glDeleteVertexArrays(1, &VAO); VAO = 0; }
         if (VBO) { glDeleteBuffers(1, &VBO); VBO = 0; }
         if (shader) { delete shader; shader = nullptr; }
+        if (sdfShader) { delete sdfShader; sdfShader = nullptr; }
         font.reset();
     }
 
-    // Create VAO/VBO and set sampler uniform (call after GL context ready)
+    // Create VAO/VBO and both text shaders (call after GL context ready)
     void Init(const std::string& shaderVert = DEFAULT_TEXT_VERT,
         const std::string& shaderFrag = DEFAULT_TEXT_FRAG)
     {
@@ -137,51 +133,38 @@ struct DelusiveFont {
         Cleanup();
 
         shader = new Shader(shaderVert.c_str(), shaderFrag.c_str());
-        shader->Use();
+        sdfShader = new Shader(shaderVert.c_str(), DEFAULT_TEXT_SDF_FRAG);
 
-        // Ensure sampler 'tex' uses texture unit 0
-        GLint loc = glGetUniformLocation(shader->GetID(), "tex");
-        if (loc >= 0) glUniform1i(loc, 0);
-
-        // Create a dynamic VBO sized for a single glyph quad (6 verts * 4 floats)
+        // The VBO is resized per string, see TextBatch::DrawVertices
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
 
         glBindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-
-        // layout matches your text.vert expectations:
-        // location 0 = vec2 position, location 1 = vec2 uv
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        TextBatch::SetVertexLayout();
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
     }
 
     // Load/reload font atlas. Calls Init() if GL objects are missing.
+    // In SDF mode every pixelHeight maps to the same shared atlas, so resizing never rasterizes.
     bool SetFont(const std::string& path, float pixelHeight) {
         fontPath = path;
+        previousFontPath = path;
 
-        if (!shader || VAO == 0 || VBO == 0) {
+        if (!shader || !sdfShader || VAO == 0 || VBO == 0) {
             Init();
         }
 
-        // Important for glyph uploads
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        auto tmp = std::make_unique<Font>();
-        if (!tmp->LoadFromFile(path, pixelHeight)) {
+        auto tmp = Font::Acquire(path, pixelHeight, sdf ? FontMode::SDF : FontMode::Bitmap);
+        if (!tmp) {
             std::cerr << "[DelusiveFont] Failed to load font: " << path << std::endl;
             return false;
         }
 
         font = std::move(tmp);
-        loadedPixelHeight = pixelHeight;
+        loadedPixelHeight = font->GetPixelHeight();
 
         // If caller hasn't set a runtime fontSize, default it to loaded height
         if (fontSize <= 0.0f) fontSize = loadedPixelHeight;
@@ -195,6 +178,7 @@ struct DelusiveFont {
         previousFontPath = other.previousFontPath;
         fontSize = other.fontSize;
         loadedPixelHeight = other.loadedPixelHeight;
+        sdf = other.sdf;
 
         Init();
         if (!fontPath.empty()) {
@@ -202,66 +186,74 @@ struct DelusiveFont {
         }
     }
 
-    // Draw uses the exact math your original UILabel used (bearing, size, advance)
+    // Picks up path or mode edits made through the inspector or a loaded file
+    void Refresh() {
+        if (fontPath.empty()) return;
+        if (fontPath != previousFontPath || (font && font->IsSDF() != sdf)) {
+            SetFont(fontPath, fontSize);
+        }
+    }
+
+    // Runtime size relative to the size the atlas was rasterized at
+    float GetDrawScale() const {
+        return (loadedPixelHeight > 0.0f) ? (fontSize / loadedPixelHeight) : 1.0f;
+    }
+
+    // Appends to an open batch when there is one, otherwise draws the whole string in one call.
     // projection should be an orthographic matrix (screen coords).
     void DrawText(const std::string& text,
         const glm::vec2& position,
         const glm::vec4& color,
-        const glm::mat4& projection)
+        const glm::mat4& projection,
+        TextBatch* batch = nullptr)
+    {
+        if (!font) return;
+
+        if (batch && batch->IsActive()) {
+            batch->Add(*font, text, position, GetDrawScale(), color);
+            return;
+        }
+        std::vector<TextVertex> vertices;
+        vertices.reserve(text.size() * 6);
+        font->AppendQuads(text, position, GetDrawScale(), color, vertices);
+        DrawVertices(vertices, projection);
+    }
+
+    // Same as above, but reuses layout's shaped quads until the text, font or size changes
+    void DrawText(TextLayout& layout,
+        const std::string& text,
+        const glm::vec2& position,
+        const glm::vec4& color,
+        const glm::mat4& projection,
+        TextBatch* batch = nullptr,
+        float width = 0.0f,
+        TextAlign align = TextAlign::Left,
+        bool wrap = false)
     {
-        if (!shader || !font) return;
+        if (!font) return;
+
+        layout.Build(font, text, GetDrawScale(), width, align, wrap);
+        const std::vector<TextVertex>& vertices = layout.Place(position, color);
+
+        if (batch && batch->IsActive()) {
+            batch->AddVertices(*font, vertices);
+            return;
+        }
+        DrawVertices(vertices, projection);
+    }
+
+    void DrawVertices(const std::vector<TextVertex>& vertices, const glm::mat4& projection) {
+        Shader* program = font->IsSDF() ? sdfShader : shader;
+        if (!program) return;
 
         // enable blending for glyphs (simple management: enable if disabled, then restore)
         GLboolean wasBlend = glIsEnabled(GL_BLEND);
         if (!wasBlend) glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        shader->Use();
-        shader->SetMat4("projection", glm::value_ptr(projection));
-        shader->SetVec4("uColor", color);
-
         // identity model (positions are screen-space)
-        glm::mat4 model(1.0f);
-        shader->SetMat4("model", glm::value_ptr(model));
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindVertexArray(VAO);
-
-        float x = position.x;
-        float y = position.y;
-        const float s = (loadedPixelHeight > 0.0f) ? (fontSize / loadedPixelHeight) : 1.0f;
-
-        for (unsigned char uc : text) {
-            const Character& ch = font->GetCharacter(uc);
-            // skip missing glyphs (Font should return empty Character)
-            if (ch.textureID == 0 && ch.size.x == 0 && ch.size.y == 0) continue;
-
-            float xpos = x + ch.bearing.x * s;
-            float ypos = y - (ch.size.y - ch.bearing.y) * s;
-            float w = ch.size.x * s;
-            float h = ch.size.y * s;
-
-            // match your previous vertex order/uvs
-            float verts[6][4] = {
-                { xpos,     ypos,     0.0f, 1.0f }, // bottom-left
-                { xpos,     ypos + h, 0.0f, 0.0f }, // top-left
-                { xpos + w, ypos + h, 1.0f, 0.0f }, // top-right
-
-                { xpos,     ypos,     0.0f, 1.0f }, // bottom-left
-                { xpos + w, ypos + h, 1.0f, 0.0f }, // top-right
-                { xpos + w, ypos,     1.0f, 1.0f }  // bottom-right
-            };
-
-            glBindTexture(GL_TEXTURE_2D, ch.textureID);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-
-            // advance is in pixels for the loaded font
-            x += ch.advance * s;
-        }
-
-        glBindVertexArray(0);
+        TextBatch::UseShader(*program, projection);
+        TextBatch::DrawVertices(VAO, VBO, font->GetAtlasTexture(), vertices, 0, vertices.size());
         glBindTexture(GL_TEXTURE_2D, 0);
 
         if (!wasBlend) glDisable(GL_BLEND);
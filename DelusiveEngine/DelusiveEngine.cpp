@@ -66,7 +66,7 @@ namespace DelusiveEngine {
         ImGui_ImplOpenGL3_Init("#version 330 core");
 
         // --- Collider Renderer ---
-        ColliderRenderer colliderRenderer;
+        ColliderRenderer colliderRenderer(renderer.GetDebugDraw());
         
 
         // --- Editor Camera ---
@@ -152,6 +152,7 @@ namespace DelusiveEngine {
             if (context.editorMode) {
                 ui.Render(game.GetActiveScene());
             }
+            renderer.GetRenderTargetPool().EndFrame();
 
             ImGui::Render();
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
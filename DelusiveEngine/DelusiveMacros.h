@@ -6,9 +6,14 @@
 #define DEFAULT_FRAG "../assets/shaders/fragment.glsl"
 #define DEFAULT_TEXT_VERT "../assets/shaders/text.vert"
 #define DEFAULT_TEXT_FRAG "../assets/shaders/text.frag"
+#define DEFAULT_TEXT_SDF_FRAG "../assets/shaders/text_sdf.frag"
 #define DEFAULT_FONT "../assets/fonts/pixel_arial_11/PIXEARG_.TTF"
 #define DEFAULT_COLL_VERT "../assets/shaders/collider_vert.glsl"
 #define DEFAULT_COLL_FRAG "../assets/shaders/collider_frag.glsl"
+#define DEFAULT_DEBUG_VERT "../assets/shaders/debug_line.vert"
+#define DEFAULT_DEBUG_FRAG "../assets/shaders/debug_line.frag"
+#define DEFAULT_SPRITE_INST_VERT "../assets/shaders/sprite_instanced.vert"
+#define DEFAULT_SPRITE_INST_FRAG "../assets/shaders/sprite_instanced.frag"
 
 #define DEFAULT_SPRITE "../assets/sprites/star.png"
 
@@ -24,4 +29,5 @@
 #define ANIMS_FOLDER "../assets/animations/"
 #define SPRITE_FOLDER "../assets/sprites/"
 #define FONT_FOLDER "../assets/fonts/"
+#define FONT_CACHE_FOLDER "../assets/fonts/cache/"
 #define CANVAS_DATA "../assets/canvasData/ui_canvases.txt"
\ No newline at end of file
@@ -25,8 +25,11 @@ void PropertyRegistry::Deserialize(std::istream& in) {
     }
 }
 
-void PropertyRegistry::DrawImGui() {
+bool PropertyRegistry::DrawImGui() {
+    bool edited = false;
     for (auto& prop : properties) {
-        prop->DrawImGui();
+        edited |= prop->DrawImGui();
     }
+    if (edited) ++revision;
+    return edited;
 }
\ No newline at end of file
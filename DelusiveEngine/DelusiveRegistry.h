@@ -2,6 +2,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 class PropertyBase {
 public:
@@ -12,7 +13,8 @@ public:
 
     virtual void Serialize(std::ostream& out) const = 0;
     virtual void Deserialize(std::istream& in) = 0;
-    virtual void DrawImGui() = 0;
+    //Returns true when the user edited the value
+    virtual bool DrawImGui() = 0;
 };
 
 template<typename T>
@@ -36,7 +38,12 @@ public:
 
     void Serialize(std::ostream& out) const;
     void Deserialize(std::istream& in);
-    void DrawImGui();
+    //Returns true when any property was edited, which also bumps the revision
+    bool DrawImGui();
+    uint32_t GetRevision() const { return revision; }
+
+private:
+    uint32_t revision = 0;
 };
 
 #include "Property.inl"
\ No newline at end of file
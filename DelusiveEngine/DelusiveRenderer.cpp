@@ -38,6 +38,10 @@ void DelusiveRenderer::Init() {
 	glBindVertexArray(0);
 
 	InitTextRenderer();
+	spriteRenderer.Init();
+	renderQueue.Init();
+	textBatch.Init();
+	debugDraw.Init();
 }
 
 void DelusiveRenderer::Clear() {
@@ -93,6 +97,12 @@ void DelusiveRenderer::Shutdown() {
 	if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
 	quadVBO = quadVAO = 0;
 
+	spriteRenderer.Shutdown();
+	renderQueue.Shutdown();
+	textBatch.Shutdown();
+	debugDraw.Shutdown();
+	renderTargets.Shutdown();
+
 	if (textVBO) glDeleteBuffers(1, &textVBO);
 	if (textVAO) glDeleteVertexArrays(1, &textVAO);
 	textVBO = textVAO = 0;
@@ -117,39 +127,11 @@ void DelusiveRenderer::EndUIRenderPass() {
 }
 
 void DelusiveRenderer::DebugDrawLine(glm::vec2 a, glm::vec2 b, glm::vec4 color) {
-	glMatrixMode(GL_PROJECTION);
-	glPushMatrix();
-	glLoadMatrixf(&projection[0][0]);
-
-	glMatrixMode(GL_MODELVIEW);
-	glPushMatrix();
-	glLoadIdentity();
-
-	glDisable(GL_TEXTURE_2D);
-	glColor4f(color.r, color.g, color.b, color.a);
-
-	glBegin(GL_LINES);
-	glVertex2f(a.x, a.y);
-	glVertex2f(b.x, b.y);
-	glEnd();
-
-	glPopMatrix();
-	glMatrixMode(GL_PROJECTION);
-	glPopMatrix();
-	glMatrixMode(GL_MODELVIEW);
+	debugDraw.Line(DebugCategory::General, a, b, color);
 }
 
 void DelusiveRenderer::DebugDrawRect(glm::vec2 center, float size, glm::vec4 color) {
-	float halfSize = size * 0.5f;
-	glm::vec2 topLeft = center + glm::vec2(-halfSize, halfSize);
-	glm::vec2 topRight = center + glm::vec2(halfSize, halfSize);
-	glm::vec2 bottomRight = center + glm::vec2(halfSize, -halfSize);
-	glm::vec2 bottomLeft = center + glm::vec2(-halfSize, -halfSize);
-
-	DebugDrawLine(topLeft, topRight, color);
-	DebugDrawLine(topRight, bottomRight, color);
-	DebugDrawLine(bottomRight, bottomLeft, color);
-	DebugDrawLine(bottomLeft, topLeft, color);
+	debugDraw.Rect(DebugCategory::General, center, glm::vec2(size), color);
 }
 
 void DelusiveRenderer::InitTextRenderer() {
@@ -159,10 +141,7 @@ void DelusiveRenderer::InitTextRenderer() {
 
 	glBindVertexArray(textVAO);
 	glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+	TextBatch::SetVertexLayout();
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
@@ -170,7 +149,7 @@ void DelusiveRenderer::InitTextRenderer() {
 	// Load text shader (managed by unique_ptr)
 	textShader = std::make_unique<Shader>(DEFAULT_TEXT_VERT, DEFAULT_TEXT_FRAG);
 	textShader->Use();
-	textShader->SetInt("text", 0); // instead of raw glUniform1i
+	textShader->SetInt("tex", 0); // instead of raw glUniform1i
 
 	// Load default font (also managed by unique_ptr)
 	defaultFont = std::make_unique<Font>();
@@ -182,44 +161,16 @@ void DelusiveRenderer::InitTextRenderer() {
 void DelusiveRenderer::DrawText(const std::string& text, glm::vec2 position, float size, glm::vec4 color, const glm::mat4& proj) {
 	if (!defaultFont || !textShader) return;
 
-	float scale = size;
-	float x = position.x;
-	float y = position.y;
+	// Whole string in one draw from the font atlas
+	std::vector<TextVertex> vertices;
+	vertices.reserve(text.size() * 6);
+	defaultFont->AppendQuads(text, position, size, color, vertices);
 
-	glActiveTexture(GL_TEXTURE0);
 	textShader->Use();
-	textShader->SetMat4("uProjection", proj);
-	textShader->SetVec4("uColor", color);
-
-	glBindVertexArray(textVAO);
-
-	for (char c : text) {
-		const Character& ch = defaultFont->GetCharacter(c);
-		float xpos = x + ch.bearing.x * scale;
-		float ypos = y - (ch.size.y - ch.bearing.y) * scale;
-
-		float w = ch.size.x * scale;
-		float h = ch.size.y * scale;
+	textShader->SetMat4("projection", proj);
+	textShader->SetMat4("model", glm::mat4(1.0f));
 
-		float vertices[6][4] = {
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos,     ypos,       0.0f, 1.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-			{ xpos + w, ypos + h,   1.0f, 0.0f }
-		};
-
-		glBindTexture(GL_TEXTURE_2D, ch.textureID);
-		glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		x += (ch.advance >> 6) * scale; // Advance is in 1/64 pixels
-	}
-
-	glBindVertexArray(0);
+	TextBatch::DrawVertices(textVAO, textVBO, defaultFont->GetAtlasTexture(), vertices, 0, vertices.size());
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
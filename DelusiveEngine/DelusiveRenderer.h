@@ -4,6 +4,11 @@
 #include <memory>
 #include "Shader.h"
 #include "Font.h"
+#include "SpriteRenderer.h"
+#include "RenderQueue.h"
+#include "TextBatch.h"
+#include "DebugDraw.h"
+#include "RenderTargetPool.h"
 
 class DelusiveRenderer {
 public:
@@ -23,8 +28,13 @@ public:
 	void EndUIRenderPass();
 
 	Shader* GetDefaultUIShader();
+	SpriteRenderer& GetSpriteRenderer() { return spriteRenderer; }
+	RenderQueue& GetRenderQueue() { return renderQueue; }
+	TextBatch& GetTextBatch() { return textBatch; }
+	DebugDraw& GetDebugDraw() { return debugDraw; }
+	RenderTargetPool& GetRenderTargetPool() { return renderTargets; }
 
-	//Drawing tools
+	//Drawing tools, queued on the General debug category until the scene flushes
 	void DebugDrawLine(glm::vec2, glm::vec2, glm::vec4);
 	void DebugDrawRect(glm::vec2, float, glm::vec4);
 	void DrawText(const std::string&, glm::vec2, float, glm::vec4, const glm::mat4&);
@@ -54,4 +64,10 @@ private:
 	std::unique_ptr<Shader> textShader; // Make sure Shader is included
 	std::unique_ptr<Shader> uiShader;
 	std::unique_ptr<Font> defaultFont;
+
+	SpriteRenderer spriteRenderer;
+	RenderQueue renderQueue;
+	TextBatch textBatch;
+	DebugDraw debugDraw;
+	RenderTargetPool renderTargets;
 };
\ No newline at end of file
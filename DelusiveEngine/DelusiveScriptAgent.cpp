@@ -1,10 +1,12 @@
 #include <Delusive/DelusiveScriptAgent.h>
 #include "Agent.h"
 #include "TransformComponent.h"
+#include "Scene.h"
 
 DelusiveScriptAgent::DelusiveScriptAgent(Agent* agent)
 	: agent(agent) {
 	transform = &agent->GetTransform();
+	steering = &agent->steering;
 }
 
 uint64_t DelusiveScriptAgent::GetID() const {
@@ -13,4 +15,9 @@ uint64_t DelusiveScriptAgent::GetID() const {
 
 const std::string& DelusiveScriptAgent::GetName() const {
     return agent->GetName();
+}
+
+const PhysicsQuery* DelusiveScriptAgent::GetPhysics() const {
+    Scene* scene = agent->GetScene();
+    return scene ? &scene->GetPhysicsQuery() : nullptr;
 }
\ No newline at end of file
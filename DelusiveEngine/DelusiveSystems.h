@@ -1,3 +1,4 @@
 #pragma once
 #include "PathfindingSystem.h"
+#include "CrowdSystem.h"
 #include "UIManager.h"
\ No newline at end of file
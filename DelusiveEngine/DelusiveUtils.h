@@ -1,10 +1,37 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <Delusive/Transform.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 glm::vec2 ScreenToWorld2D(int, int, glm::mat4);
 bool IsInsideCircle(const glm::vec2&, const glm::vec2&, float);
 bool IsNearLine(float, float, float);
 
+//FNV-1a, start from FnvOffset and feed bytes in a fixed order
+constexpr uint64_t FnvOffset = 14695981039346656037ull;
+
+inline void HashBytes(uint64_t& hash, const void* data, size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+}
+
+template<typename T>
+void HashValue(uint64_t& hash, const T& value) {
+	HashBytes(hash, &value, sizeof(T));
+}
+
+inline float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline bool SameTransform(const Transform& a, const Transform& b) {
+	return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
+}
+
 struct PlayerInputState {
 	glm::vec2 moveDir = { 0.0f, 0.0f };
 
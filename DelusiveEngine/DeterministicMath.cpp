@@ -0,0 +1,86 @@
+#include "DeterministicMath.h"
+#include <cmath>
+#include <cstdint>
+
+#ifdef DELUSIVE_DETERMINISTIC
+#ifdef _MSC_VER
+#pragma fp_contract(off)
+#endif
+
+namespace {
+	// pi / 2 split so k * HalfPiHigh is exact for any quadrant count a rotation will reach
+	constexpr double HalfPiHigh = 1.57079632673412561417;
+	constexpr double HalfPiLow = 6.07710050650619224932e-11;
+	constexpr double TwoOverPi = 0.63661977236758134308;
+
+	// Taylor series on [-pi/4, pi/4], accurate well past float precision
+	double SinKernel(double x) {
+		double x2 = x * x;
+		return x * (1.0 + x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0 +
+			x2 * (1.0 / 362880.0 + x2 * (-1.0 / 39916800.0 + x2 * (1.0 / 6227020800.0)))))));
+	}
+
+	double CosKernel(double x) {
+		double x2 = x * x;
+		return 1.0 + x2 * (-1.0 / 2.0 + x2 * (1.0 / 24.0 + x2 * (-1.0 / 720.0 + x2 * (1.0 / 40320.0 +
+			x2 * (-1.0 / 3628800.0 + x2 * (1.0 / 479001600.0))))));
+	}
+
+	// Reduces to [-pi/4, pi/4] and returns the quadrant
+	int64_t Reduce(float radians, double& reduced) {
+		double x = radians;
+		double scaled = x * TwoOverPi;
+		int64_t quadrant = static_cast<int64_t>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+		double k = static_cast<double>(quadrant);
+		reduced = (x - k * HalfPiHigh) - k * HalfPiLow;
+		return quadrant;
+	}
+}
+
+float DeterministicMath::Sin(float radians) {
+	double x;
+	switch (Reduce(radians, x) & 3) {
+	case 0: return static_cast<float>(SinKernel(x));
+	case 1: return static_cast<float>(CosKernel(x));
+	case 2: return static_cast<float>(-SinKernel(x));
+	default: return static_cast<float>(-CosKernel(x));
+	}
+}
+
+float DeterministicMath::Cos(float radians) {
+	double x;
+	switch (Reduce(radians, x) & 3) {
+	case 0: return static_cast<float>(CosKernel(x));
+	case 1: return static_cast<float>(-SinKernel(x));
+	case 2: return static_cast<float>(-CosKernel(x));
+	default: return static_cast<float>(SinKernel(x));
+	}
+}
+
+// Translate * rotate about z * scale written out, so no libm call sneaks in through glm::rotate
+glm::mat4 DeterministicMath::TransformMatrix(const Transform& transform) {
+	float c = Cos(transform.rotation);
+	float s = Sin(transform.rotation);
+
+	glm::mat4 model(1.0f);
+	model[0] = glm::vec4(c * transform.scale.x, s * transform.scale.x, 0.0f, 0.0f);
+	model[1] = glm::vec4(-s * transform.scale.y, c * transform.scale.y, 0.0f, 0.0f);
+	model[3] = glm::vec4(transform.position, 0.0f, 1.0f);
+	return model;
+}
+
+#else
+
+float DeterministicMath::Sin(float radians) {
+	return std::sin(radians);
+}
+
+float DeterministicMath::Cos(float radians) {
+	return std::cos(radians);
+}
+
+glm::mat4 DeterministicMath::TransformMatrix(const Transform& transform) {
+	return transform.ToMatrix();
+}
+
+#endif
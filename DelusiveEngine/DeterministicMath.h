@@ -0,0 +1,14 @@
+#pragma once
+#include <Delusive/Transform.h>
+#include <glm/glm.hpp>
+
+//Trig used by the physics path. Building with DELUSIVE_DETERMINISTIC (msbuild /p:DelusiveDeterministic=true)
+//also switches the compiler to strict floating point, and these become fixed polynomials built only
+//from + and *, so every machine produces the same bits. Otherwise they forward to the standard library.
+namespace DeterministicMath {
+	float Sin(float radians);
+	float Cos(float radians);
+
+	//Same matrix as Transform::ToMatrix, built with the functions above
+	glm::mat4 TransformMatrix(const Transform&);
+}
@@ -0,0 +1,278 @@
+#include "DynamicAABBTree.h"
+
+DynamicAABBTree::DynamicAABBTree() {
+	nodes.reserve(16);
+}
+
+void DynamicAABBTree::Clear() {
+	nodes.clear();
+	root = NullNode;
+	freeList = NullNode;
+	proxyCount = 0;
+}
+
+int DynamicAABBTree::AllocateNode() {
+	if (freeList == NullNode) {
+		nodes.emplace_back();
+		freeList = static_cast<int>(nodes.size()) - 1;
+		nodes[freeList].parent = NullNode;
+	}
+
+	int nodeID = freeList;
+	freeList = nodes[nodeID].parent;
+
+	TreeNode& node = nodes[nodeID];
+	node.parent = NullNode;
+	node.child1 = NullNode;
+	node.child2 = NullNode;
+	node.height = 0;
+	node.userData = nullptr;
+	return nodeID;
+}
+
+void DynamicAABBTree::FreeNode(int nodeID) {
+	nodes[nodeID].parent = freeList;
+	nodes[nodeID].height = -1;
+	nodes[nodeID].userData = nullptr;
+	freeList = nodeID;
+}
+
+int DynamicAABBTree::CreateProxy(const Zone& bounds, void* userData) {
+	int proxyID = AllocateNode();
+
+	nodes[proxyID].bounds = { bounds.min - glm::vec2(margin), bounds.max + glm::vec2(margin) };
+	nodes[proxyID].userData = userData;
+	nodes[proxyID].height = 0;
+
+	InsertLeaf(proxyID);
+	++proxyCount;
+	return proxyID;
+}
+
+void DynamicAABBTree::DestroyProxy(int proxyID) {
+	RemoveLeaf(proxyID);
+	FreeNode(proxyID);
+	--proxyCount;
+}
+
+bool DynamicAABBTree::MoveProxy(int proxyID, const Zone& bounds, glm::vec2 displacement) {
+	if (Contains(nodes[proxyID].bounds, bounds)) {
+		return false;
+	}
+
+	RemoveLeaf(proxyID);
+
+	// Fatten, then stretch along the motion so steady movers reinsert less often
+	Zone fat = { bounds.min - glm::vec2(margin), bounds.max + glm::vec2(margin) };
+	glm::vec2 stretch = displacementMultiplier * displacement;
+	fat.min += glm::min(stretch, glm::vec2(0.0f));
+	fat.max += glm::max(stretch, glm::vec2(0.0f));
+	nodes[proxyID].bounds = fat;
+
+	InsertLeaf(proxyID);
+	return true;
+}
+
+void DynamicAABBTree::InsertLeaf(int leaf) {
+	if (root == NullNode) {
+		root = leaf;
+		nodes[root].parent = NullNode;
+		return;
+	}
+
+	// Walk down towards the cheapest sibling
+	const Zone leafBounds = nodes[leaf].bounds;
+	int index = root;
+	while (!nodes[index].IsLeaf()) {
+		int child1 = nodes[index].child1;
+		int child2 = nodes[index].child2;
+
+		float area = Perimeter(nodes[index].bounds);
+		float combinedArea = Perimeter(Combine(nodes[index].bounds, leafBounds));
+
+		// Cost of making a new parent for this node and the leaf
+		float cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](int child) {
+			Zone combined = Combine(leafBounds, nodes[child].bounds);
+			if (nodes[child].IsLeaf()) {
+				return Perimeter(combined) + inheritanceCost;
+			}
+			return Perimeter(combined) - Perimeter(nodes[child].bounds) + inheritanceCost;
+		};
+
+		float cost1 = descendCost(child1);
+		float cost2 = descendCost(child2);
+
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int sibling = index;
+	int oldParent = nodes[sibling].parent;
+	int newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].bounds = Combine(leafBounds, nodes[sibling].bounds);
+	nodes[newParent].height = nodes[sibling].height + 1;
+
+	if (oldParent != NullNode) {
+		if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+		else nodes[oldParent].child2 = newParent;
+	}
+	else {
+		root = newParent;
+	}
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	// Refit and rebalance the ancestors
+	index = nodes[leaf].parent;
+	while (index != NullNode) {
+		index = Balance(index);
+
+		int child1 = nodes[index].child1;
+		int child2 = nodes[index].child2;
+		nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+		nodes[index].bounds = Combine(nodes[child1].bounds, nodes[child2].bounds);
+
+		index = nodes[index].parent;
+	}
+}
+
+void DynamicAABBTree::RemoveLeaf(int leaf) {
+	if (leaf == root) {
+		root = NullNode;
+		return;
+	}
+
+	int parent = nodes[leaf].parent;
+	int grandParent = nodes[parent].parent;
+	int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != NullNode) {
+		// Splice the sibling into the parent's place
+		if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+		else nodes[grandParent].child2 = sibling;
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		int index = grandParent;
+		while (index != NullNode) {
+			index = Balance(index);
+
+			int child1 = nodes[index].child1;
+			int child2 = nodes[index].child2;
+			nodes[index].bounds = Combine(nodes[child1].bounds, nodes[child2].bounds);
+			nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+
+			index = nodes[index].parent;
+		}
+	}
+	else {
+		root = sibling;
+		nodes[sibling].parent = NullNode;
+		FreeNode(parent);
+	}
+}
+
+// Tree rotation when one side is more than one level taller than the other.
+// Returns the index now sitting where iA was.
+int DynamicAABBTree::Balance(int iA) {
+	TreeNode* A = &nodes[iA];
+	if (A->IsLeaf() || A->height < 2) {
+		return iA;
+	}
+
+	int iB = A->child1;
+	int iC = A->child2;
+	TreeNode* B = &nodes[iB];
+	TreeNode* C = &nodes[iC];
+
+	int balance = C->height - B->height;
+
+	// Rotate C up
+	if (balance > 1) {
+		int iF = C->child1;
+		int iG = C->child2;
+		TreeNode* F = &nodes[iF];
+		TreeNode* G = &nodes[iG];
+
+		C->child1 = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != NullNode) {
+			if (nodes[C->parent].child1 == iA) nodes[C->parent].child1 = iC;
+			else nodes[C->parent].child2 = iC;
+		}
+		else {
+			root = iC;
+		}
+
+		if (F->height > G->height) {
+			C->child2 = iF;
+			A->child2 = iG;
+			G->parent = iA;
+			A->bounds = Combine(B->bounds, G->bounds);
+			C->bounds = Combine(A->bounds, F->bounds);
+			A->height = 1 + std::max(B->height, G->height);
+			C->height = 1 + std::max(A->height, F->height);
+		}
+		else {
+			C->child2 = iG;
+			A->child2 = iF;
+			F->parent = iA;
+			A->bounds = Combine(B->bounds, F->bounds);
+			C->bounds = Combine(A->bounds, G->bounds);
+			A->height = 1 + std::max(B->height, F->height);
+			C->height = 1 + std::max(A->height, G->height);
+		}
+		return iC;
+	}
+
+	// Rotate B up
+	if (balance < -1) {
+		int iD = B->child1;
+		int iE = B->child2;
+		TreeNode* D = &nodes[iD];
+		TreeNode* E = &nodes[iE];
+
+		B->child1 = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != NullNode) {
+			if (nodes[B->parent].child1 == iA) nodes[B->parent].child1 = iB;
+			else nodes[B->parent].child2 = iB;
+		}
+		else {
+			root = iB;
+		}
+
+		if (D->height > E->height) {
+			B->child2 = iD;
+			A->child1 = iE;
+			E->parent = iA;
+			A->bounds = Combine(C->bounds, E->bounds);
+			B->bounds = Combine(A->bounds, D->bounds);
+			A->height = 1 + std::max(C->height, E->height);
+			B->height = 1 + std::max(A->height, D->height);
+		}
+		else {
+			B->child2 = iE;
+			A->child1 = iD;
+			D->parent = iA;
+			A->bounds = Combine(C->bounds, D->bounds);
+			B->bounds = Combine(A->bounds, E->bounds);
+			A->height = 1 + std::max(C->height, D->height);
+			B->height = 1 + std::max(A->height, E->height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
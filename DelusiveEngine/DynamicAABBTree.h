@@ -0,0 +1,183 @@
+#pragma once
+#include "PhysicsTypes.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+//Bounding volume hierarchy over fattened AABBs.
+//Leaves are only reinserted when their shape leaves the fat bounds, and insertion
+//picks the sibling with the lowest perimeter cost (the 2D surface area heuristic).
+class DynamicAABBTree {
+public:
+	static constexpr int NullNode = -1;
+
+	DynamicAABBTree();
+
+	int CreateProxy(const Zone& bounds, void* userData);
+	void DestroyProxy(int proxyID);
+	bool MoveProxy(int proxyID, const Zone& bounds, glm::vec2 displacement); // true if reinserted
+	void Clear();
+
+	void* GetUserData(int proxyID) const { return nodes[proxyID].userData; }
+	const Zone& GetFatBounds(int proxyID) const { return nodes[proxyID].bounds; }
+	int GetProxyCount() const { return proxyCount; }
+	int GetHeight() const { return root == NullNode ? 0 : nodes[root].height; }
+
+	void SetMargin(float _margin) { margin = _margin; }
+
+	//Callback(int proxyID) returns false to stop the query
+	template<typename Callback>
+	void Query(const Zone& bounds, Callback&& callback) const;
+
+	template<typename Callback>
+	void QueryPoint(glm::vec2 point, Callback&& callback) const;
+
+	//Callback(int proxyID, glm::vec2 from, glm::vec2 to, float maxFraction) returns the new max fraction.
+	//Returning 0 stops the cast, returning maxFraction leaves it unchanged.
+	template<typename Callback>
+	void RayCast(glm::vec2 from, glm::vec2 to, Callback&& callback) const;
+
+	static bool Overlaps(const Zone& a, const Zone& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+
+	static bool Contains(const Zone& outer, const Zone& inner) {
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y
+			&& inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+	}
+
+	static Zone Combine(const Zone& a, const Zone& b) {
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	static float Perimeter(const Zone& zone) {
+		glm::vec2 size = zone.max - zone.min;
+		return 2.0f * (size.x + size.y);
+	}
+
+private:
+	struct TreeNode {
+		Zone bounds;
+		void* userData = nullptr;
+		int parent = NullNode; // doubles as the next free node while on the free list
+		int child1 = NullNode;
+		int child2 = NullNode;
+		int height = -1;       // 0 for leaves, -1 for free nodes
+
+		bool IsLeaf() const { return child1 == NullNode; }
+	};
+
+	//Traversal stack that lives on the call stack and moves to the heap once a deep tree outgrows it
+	class NodeStack {
+	public:
+		NodeStack() = default;
+		NodeStack(const NodeStack&) = delete;
+		NodeStack& operator=(const NodeStack&) = delete;
+
+		void Push(int nodeID) {
+			if (count == capacity) Grow();
+			data[count++] = nodeID;
+		}
+		int Pop() { return data[--count]; }
+		bool Empty() const { return count == 0; }
+
+	private:
+		static constexpr int LocalCapacity = 256;
+		int local[LocalCapacity];
+		std::vector<int> heap;
+		int* data = local;
+		int count = 0;
+		int capacity = LocalCapacity;
+
+		void Grow() {
+			if (data == local) heap.assign(local, local + count);
+			capacity *= 2;
+			heap.resize(capacity);
+			data = heap.data();
+		}
+	};
+
+	std::vector<TreeNode> nodes;
+	int root = NullNode;
+	int freeList = NullNode;
+	int proxyCount = 0;
+	float margin = 0.1f;
+	float displacementMultiplier = 2.0f;
+
+	int AllocateNode();
+	void FreeNode(int);
+	void InsertLeaf(int);
+	void RemoveLeaf(int);
+	int Balance(int);
+};
+
+template<typename Callback>
+void DynamicAABBTree::Query(const Zone& bounds, Callback&& callback) const {
+	if (root == NullNode) return;
+
+	NodeStack stack;
+	stack.Push(root);
+
+	while (!stack.Empty()) {
+		int nodeID = stack.Pop();
+		const TreeNode& node = nodes[nodeID];
+		if (!Overlaps(node.bounds, bounds)) continue;
+
+		if (node.IsLeaf()) {
+			if (!callback(nodeID)) return;
+		}
+		else {
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
+
+template<typename Callback>
+void DynamicAABBTree::QueryPoint(glm::vec2 point, Callback&& callback) const {
+	Query(Zone{ point, point }, std::forward<Callback>(callback));
+}
+
+template<typename Callback>
+void DynamicAABBTree::RayCast(glm::vec2 from, glm::vec2 to, Callback&& callback) const {
+	if (root == NullNode) return;
+
+	glm::vec2 ray = to - from;
+	float length = glm::length(ray);
+	if (length <= 0.0f) return;
+
+	// Separating axis for the segment: |dot(normal, from - center)| > dot(|normal|, halfExtent)
+	glm::vec2 direction = ray / length;
+	glm::vec2 normal(-direction.y, direction.x);
+	glm::vec2 absNormal = glm::abs(normal);
+
+	float maxFraction = 1.0f;
+	Zone segmentBounds = { glm::min(from, to), glm::max(from, to) };
+
+	NodeStack stack;
+	stack.Push(root);
+
+	while (!stack.Empty()) {
+		int nodeID = stack.Pop();
+		const TreeNode& node = nodes[nodeID];
+		if (!Overlaps(node.bounds, segmentBounds)) continue;
+
+		glm::vec2 center = 0.5f * (node.bounds.min + node.bounds.max);
+		glm::vec2 halfExtent = 0.5f * (node.bounds.max - node.bounds.min);
+		if (std::fabs(glm::dot(normal, from - center)) - glm::dot(absNormal, halfExtent) > 0.0f) continue;
+
+		if (node.IsLeaf()) {
+			float value = callback(nodeID, from, to, maxFraction);
+			if (value == 0.0f) return;
+			if (value > 0.0f && value < maxFraction) {
+				maxFraction = value;
+				glm::vec2 clipped = from + maxFraction * ray;
+				segmentBounds = { glm::min(from, clipped), glm::max(from, clipped) };
+			}
+		}
+		else {
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
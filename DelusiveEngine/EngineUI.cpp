@@ -8,6 +8,27 @@
 #include "DelusiveSystems.h"
 #include <glm/gtc/type_ptr.hpp>
 
+namespace {
+    //Content hash of an agent file, so previews drawn for one agent are never shown for another
+    uint64_t HashAgentFile(const std::string& path) {
+        uint64_t hash = FnvOffset;
+        std::ifstream in(path, std::ios::binary);
+        char buffer[4096];
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+            HashBytes(hash, buffer, static_cast<size_t>(in.gcount()));
+        }
+        HashBytes(hash, path.data(), path.size());
+        return hash;
+    }
+
+    uint64_t FramePreviewKey(uint64_t agentHash, int branchIndex, int frameIndex) {
+        uint64_t key = agentHash;
+        HashBytes(key, &branchIndex, sizeof(branchIndex));
+        HashBytes(key, &frameIndex, sizeof(frameIndex));
+        return key;
+    }
+}
+
 EngineUI::EngineUI(GameManager& _game, DelusiveRenderer& _renderer)
     : gameManager(_game), renderer(_renderer)
 {
@@ -16,14 +37,7 @@ EngineUI::EngineUI(GameManager& _game, DelusiveRenderer& _renderer)
 }
 
 EngineUI::~EngineUI() {
-    for (auto& branch : currentAnimation.data.branches) {
-        for (auto& frame : branch.frames) {
-            if (frame.previewTexture != 0) {
-                glDeleteTextures(1, &frame.previewTexture);
-                frame.previewTexture = 0;
-            }
-        }
-    }
+    ClearFramePreviews();
 }
 
 const char* ViewModeToString(EditorMode mode) {
@@ -65,20 +79,27 @@ std::vector<std::string> EngineUI::LoadSceneList() {
     return sceneNames;
 }
 
-ImTextureID EngineUI::GetFramePreviewTexture(AnimationFrame& frame, Agent& baseAgent) {
-    if (!frame.dirty && frame.previewTexture != 0)
-        return (ImTextureID)(intptr_t)frame.previewTexture;
+ImTextureID EngineUI::GetFramePreviewTexture(int branchIndex, int frameIndex, Agent& baseAgent) {
+    AnimationFrame& frame = currentAnimation.data.branches[branchIndex].frames[frameIndex];
+    FramePreview& preview = framePreviews[FramePreviewKey(previewAgentHash, branchIndex, frameIndex)];
+    preview.lastUsed = previewFrame;
+
+    if (preview.target && !frame.dirty)
+        return (ImTextureID)(intptr_t)preview.target->texture;
+
+    // Redraws reuse the frame's target, only a new key takes one from the pool
+    if (!preview.target)
+        preview.target = renderer.GetRenderTargetPool().Acquire(256, 256);
+    if (!preview.target)
+        return (ImTextureID)0;
 
     std::unique_ptr<Agent> tempAgent = baseAgent.Clone(&gameManager.GetActiveScene());
     ApplyOverrides(frame, *tempAgent);
 
-    if (frame.previewTexture != 0)
-        glDeleteTextures(1, &frame.previewTexture);
-
-    frame.previewTexture = tempAgent->RenderAgentToTexture(256, 256);
+    tempAgent->RenderAgentToTexture(*preview.target);
     frame.dirty = false;
 
-    return (ImTextureID)(intptr_t)frame.previewTexture;
+    return (ImTextureID)(intptr_t)preview.target->texture;
 }
 
 void EngineUI::Render(Scene& scene) {
@@ -107,7 +128,7 @@ void EngineUI::SwitchMode(Scene& scene, EditorMode mode) {
     selectedComponent = nullptr;
     selectedFrame = -1;
     selectedBranch = -1;
-    ClearFramePreviews(currentAnimation);
+    ClearFramePreviews();
     currentAnimation.Clear();
     baseAgent.reset();
     pureAgent.reset();
@@ -205,7 +226,7 @@ void EngineUI::RenderTopBar(Scene& scene) {
                         break;
                     }
                     case EditorMode::AnimatorEditor: {
-                        ClearFramePreviews(currentAnimation);
+                        ClearFramePreviews();
 
                         currentAnimation.Clear();
                         currentAnimation.LoadFromFile(fullPath);
@@ -442,6 +463,9 @@ void EngineUI::RenderSceneEditor(Scene& scene) {
                     if (ImGui::MenuItem("UIManager")) {
                         scene.AddSystem(std::make_unique<UIManager>(renderer));
                     }
+                    if (ImGui::MenuItem("CrowdSystem")) {
+                        scene.AddSystem(std::make_unique<CrowdSystem>(renderer));
+                    }
                     ImGui::EndMenu();
                 }
                 ImGui::EndPopup();
@@ -449,6 +473,79 @@ void EngineUI::RenderSceneEditor(Scene& scene) {
             ImGui::TreePop();
         }
 
+        if (ImGui::TreeNode("Physics")) {
+            scene.GetPhysics().DrawImGui();
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("Rendering")) {
+            bool culling = scene.IsCullingEnabled();
+            if (ImGui::Checkbox("View Culling", &culling)) {
+                scene.SetCullingEnabled(culling);
+            }
+            const Scene::DrawStats& stats = scene.GetDrawStats();
+            ImGui::Text("Sprites: %d visible, %d culled", stats.visibleSprites, stats.culledSprites);
+            ImGui::Text("Colliders: %d visible, %d culled", stats.visibleColliders, stats.culledColliders);
+            ImGui::Text("Static grid items: %d", stats.staticItems);
+            ImGui::Text("Tile chunks: %d drawn, %d meshed this frame", stats.visibleTileChunks, stats.uploadedTileChunks);
+
+            bool staticBatching = scene.IsStaticBatchingEnabled();
+            if (ImGui::Checkbox("Static Batching", &staticBatching)) {
+                scene.SetStaticBatchingEnabled(staticBatching);
+            }
+            const StaticSpriteBatch::Stats& batchStats = scene.GetStaticBatchStats();
+            ImGui::Text("Baked: %d sprites in %d chunks, %d runs, %d layers y-ordered",
+                batchStats.sprites, batchStats.chunks, batchStats.batches, batchStats.orderedLayers);
+            ImGui::Text("Chunks: %d visible, %d runs drawn, %d rebuilt last bake",
+                batchStats.visibleChunks, batchStats.recordedBatches, batchStats.rebuiltChunks);
+
+            const RenderQueue::Stats& queueStats = renderer.GetRenderQueue().GetStats();
+            ImGui::Text("Queue: %d commands, sort %.3f ms", queueStats.commands, queueStats.sortMs);
+            ImGui::Text("Binds: %d program, %d VAO, %d texture (%d elided)",
+                queueStats.programBinds, queueStats.vaoBinds, queueStats.textureBinds, queueStats.elidedBinds);
+            ImGui::Text("Draw calls: %d", queueStats.drawCalls);
+
+            ImGui::Separator();
+            SpriteRenderer& spriteRenderer = renderer.GetSpriteRenderer();
+            bool instancing = spriteRenderer.IsInstancing();
+            if (ImGui::Checkbox("Instanced Sprites", &instancing)) {
+                spriteRenderer.SetInstancing(instancing);
+            }
+            if (spriteRenderer.IsInstancing()) {
+                const SpriteRenderer::Stats& spriteStats = spriteRenderer.GetStats();
+                ImGui::Text("Instances: %d in %d draw calls", spriteStats.instances, spriteStats.drawCalls);
+                ImGui::Text("Upload: %.1f KB, submit %.3f ms", spriteStats.uploadBytes / 1024.0f, spriteStats.submitMs);
+            }
+
+            const TextBatch::Stats& textStats = renderer.GetTextBatch().GetStats();
+            ImGui::Text("UI text: %d strings, %d glyphs in %d draw calls", textStats.strings, textStats.glyphs, textStats.drawCalls);
+
+            ImGui::Separator();
+            DebugDraw& debugDraw = renderer.GetDebugDraw();
+            for (int i = 0; i < static_cast<int>(DebugCategory::Count); ++i) {
+                const DebugCategory category = static_cast<DebugCategory>(i);
+                bool shown = debugDraw.IsEnabled(category);
+                if (ImGui::Checkbox(DebugDraw::GetCategoryName(category), &shown)) {
+                    debugDraw.SetEnabled(category, shown);
+                }
+            }
+            const DebugDraw::Stats& debugStats = debugDraw.GetStats();
+            ImGui::Text("Debug: %d lines, %d triangles in %d draw calls", debugStats.lines, debugStats.triangles, debugStats.drawCalls);
+
+            ImGui::InputInt("Benchmark Sprites", &spriteRenderer.benchmarkSprites);
+            if (ImGui::Button("Run Sprite Benchmark")) {
+                spriteRenderer.RunBenchmark(renderer.GetProjection(), spriteRenderer.benchmarkSprites);
+            }
+            for (const SpriteRenderer::BenchmarkResult& result : spriteRenderer.GetBenchmarkResults()) {
+                const float seconds = result.submitMs / 1000.0f;
+                ImGui::Text("%s: submit %.2f ms, finish %.2f ms, %.2f MB (%.0f MB/s)",
+                    result.label.c_str(), result.submitMs, result.finishMs,
+                    result.uploadBytes / (1024.0f * 1024.0f),
+                    seconds > 0.0f ? result.uploadBytes / (1024.0f * 1024.0f) / seconds : 0.0f);
+            }
+            ImGui::TreePop();
+        }
+
         if (ImGui::TreeNode("Agents")) {
             auto& agents = scene.GetAgents();
             for (size_t i = 0; i < agents.size(); ++i) {
@@ -511,6 +608,7 @@ void EngineUI::RenderSceneEditor(Scene& scene) {
                             if (ImGui::MenuItem("Delete Component")) {
                                 // deletion deferred to avoid invalidating iteration
                                 agent->RemoveComponentByPointer(comp);
+                                scene.MarkAgentEdited(*agent);
                                 if (selected.Is(Selection::ComponentObject, comp)) selected.Reset();
                             }
                             ImGui::EndPopup();
@@ -529,12 +627,14 @@ void EngineUI::RenderSceneEditor(Scene& scene) {
 
     // After the ImGui loop, handle deletion once safely
     if (agentToDeleteIndex >= 0 && agentToDeleteIndex < (int)scene.GetAgents().size()) {
-        scene.GetAgents().erase(scene.GetAgents().begin() + agentToDeleteIndex);
+        Agent* doomed = scene.GetAgents()[agentToDeleteIndex].get();
 
-        // Adjust selectedAgentIndex accordingly
-        if(selected.ptr == scene.GetAgents()[agentToDeleteIndex].get()) {
-            selected.Reset(); // Deselect if the deleted agent was selected
-		}
+        // Deselect if the deleted agent or one of its components was selected
+        if (selected.Is(Selection::AgentObject, doomed) ||
+            (selected.kind == Selection::ComponentObject && static_cast<Component*>(selected.ptr)->GetOwner() == doomed)) {
+            selected.Reset();
+        }
+        scene.RemoveAgent(doomed);
 
         agentToDeleteIndex = -1; // reset delete index
     }
@@ -542,7 +642,18 @@ void EngineUI::RenderSceneEditor(Scene& scene) {
     ImGui::SameLine();
 
     if (ImGui::BeginChild("Inspector", ImVec2(0, 0), true)) {
+        // Inspector edits can move or add components on environment agents, only an actual edit is reported to the scene
+        Agent* owner = nullptr;
+        if (selected.kind == Selection::AgentObject) owner = static_cast<Agent*>(selected.ptr);
+        else if (selected.kind == Selection::ComponentObject) owner = static_cast<Component*>(selected.ptr)->GetOwner();
+        if (owner && !dynamic_cast<EnvironmentAgent*>(owner)) owner = nullptr;
+        const uint64_t stamp = owner ? owner->GetEditStamp() : 0;
+
         selected.Draw();
+
+        if (owner && owner->GetEditStamp() != stamp) {
+            scene.MarkAgentEdited(*owner);
+        }
     }
     ImGui::EndChild();
 
@@ -717,13 +828,41 @@ void EngineUI::RenderAgentEditor(Scene& scene) {
     ImGui::End();
 }
 
-void EngineUI::ClearFramePreviews(Animation& anim) {
-    for (auto& branch : anim.data.branches) {
+void EngineUI::ClearFramePreviews() {
+    RenderTargetPool& pool = renderer.GetRenderTargetPool();
+    for (auto& [key, preview] : framePreviews) {
+        pool.Release(preview.target);
+    }
+    framePreviews.clear();
+    pool.Release(agentPreview);
+    agentPreview = nullptr;
+
+    for (auto& branch : currentAnimation.data.branches) {
         for (auto& frame : branch.frames) {
-            if (frame.previewTexture != 0) {
-                glDeleteTextures(1, &frame.previewTexture);
-                frame.previewTexture = 0;
-            }
+            frame.dirty = true;
+        }
+    }
+}
+
+void EngineUI::TrimFramePreviews() {
+    previewFrame++;
+    for (auto it = framePreviews.begin(); it != framePreviews.end();) {
+        if (previewFrame - it->second.lastUsed > PreviewIdleFrames) {
+            renderer.GetRenderTargetPool().Release(it->second.target);
+            it = framePreviews.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void EngineUI::MarkFramePreviewsDirty(size_t firstBranch, size_t firstFrame) {
+    // Previews are keyed by index, so everything after a removed branch or frame has to redraw
+    auto& branches = currentAnimation.data.branches;
+    for (size_t b = firstBranch; b < branches.size(); ++b) {
+        for (size_t f = (b == firstBranch ? firstFrame : 0); f < branches[b].frames.size(); ++f) {
+            branches[b].frames[f].dirty = true;
         }
     }
 }
@@ -741,7 +880,6 @@ void EngineUI::ApplyOverrides(AnimationFrame& frame, Agent& agent) {
             }
         }
     }
-    frame.dirty = true;
 }
 
 void EngineUI::ResetOverrides() {
@@ -780,13 +918,15 @@ void EngineUI::SetupAnimation(const std::string pendingAgentFile) {
     // Reset animation-specific data
     selectedBranch = -1;
     selectedFrame = -1;
-    ClearFramePreviews(currentAnimation);
+    ClearFramePreviews();
+    previewAgentHash = HashAgentFile(pendingAgentFile);
     currentAnimation.data.defaultAgentPath = pendingAgentFile;
 }
 
 void EngineUI::RenderAnimationOverrides(AnimationFrame& frame, ComponentMod& mod) {
     auto& comp = *baseAgent->GetComponentByID(mod.componentID);
-    frame.dirty = comp.DrawAnimatorImGui(mod);
+    if (comp.DrawAnimatorImGui(mod))
+        frame.dirty = true;
 }
 
 void EngineUI::RenderAnimatorEditor(Scene& scene) {
@@ -887,6 +1027,7 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
             }
             if (ImGui::MenuItem("Delete")) {
                 currentAnimation.data.branches.erase(currentAnimation.data.branches.begin() + i);
+                MarkFramePreviewsDirty(i, 0);
                 if (selectedBranch == (int)i) selectedBranch = -1;
             }
             ImGui::EndPopup();
@@ -959,7 +1100,7 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
 
             if (ImGui::ImageButton(
                 ("frame" + std::to_string(i)).c_str(),
-                (ImTextureID)(intptr_t)GetFramePreviewTexture(branch.frames[i], *baseAgent),
+                GetFramePreviewTexture(selectedBranch, i, *baseAgent),
                 ImVec2(64, 64),
                 ImVec2(0, 1),  // UV top-left
                 ImVec2(1, 0)   // UV bottom-right (flipped Y)
@@ -977,6 +1118,7 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
                 }
                 if (ImGui::MenuItem("Delete")) {
                     branch.frames.erase(branch.frames.begin() + i);
+                    MarkFramePreviewsDirty(selectedBranch, i);
                     if (selectedFrame == i) selectedFrame = -1;
                     ImGui::CloseCurrentPopup();
                 }
@@ -989,6 +1131,10 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
             ImGui::PopID();
         }
         ImGui::EndChild();
+
+        const RenderTargetPool::Stats& targetStats = renderer.GetRenderTargetPool().GetStats();
+        ImGui::TextDisabled("Previews: %d cached, render targets %d live, %d created",
+            (int)framePreviews.size(), targetStats.live, targetStats.created);
         if (ImGui::Button("Add Frame")) {
             AnimationFrame newFrame;
             if (baseAgent) {
@@ -1034,7 +1180,7 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
                 // Apply overrides to baseAgent live
                 ApplyOverrides(frame, *baseAgent);
 
-                previewTex = (GLuint)(intptr_t)GetFramePreviewTexture(frame, *baseAgent);
+                previewTex = (GLuint)(intptr_t)GetFramePreviewTexture(selectedBranch, selectedFrame, *baseAgent);
             }
         }
         else {
@@ -1043,7 +1189,11 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
                 baseAgent->LoadFromFile(currentAnimation.data.defaultAgentPath);
             }
 
-            previewTex = baseAgent->RenderAgentToTexture(256, 256);
+            // The default state is edited live, so it redraws every frame into the same target
+            if (!agentPreview)
+                agentPreview = renderer.GetRenderTargetPool().Acquire(256, 256);
+            if (agentPreview && baseAgent->RenderAgentToTexture(*agentPreview))
+                previewTex = agentPreview->texture;
         }
         float texAspect = (float)regionSize.x / (float)regionSize.y;
 
@@ -1076,19 +1226,23 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
                 -relativeY * orthoScale
             };
 
+            const uint64_t defaultStamp = baseAgent->GetEditStamp();
             bool mouseDown = SDL_GetMouseState(NULL, NULL) & SDL_BUTTON_LMASK;
             for (auto& comp : baseAgent->GetComponents()) {
                 comp->HandleMouse(worldMouse, mouseDown);
             }
 
             // Sync updated transform back to override
+            bool frameSelected = false;
             if (selectedBranch >= 0 && selectedBranch < currentAnimation.data.branches.size()) {
                 auto& branch = currentAnimation.data.branches[selectedBranch];
                 if (selectedFrame >= 0 && selectedFrame < branch.frames.size()) {
+                    frameSelected = true;
                     AnimationFrame& frame = branch.frames[selectedFrame];
                     for (auto& mod : frame.componentOverrides) {
                         Component* comp = baseAgent->GetComponentByID(mod.componentID);
-                        if (comp) {
+                        if (comp && (mod.positionOffset != comp->transform.position ||
+                            mod.scale != comp->transform.scale || mod.rotation != comp->transform.rotation)) {
                             mod.positionOffset = comp->transform.position;
                             mod.scale = comp->transform.scale;
                             mod.rotation = comp->transform.rotation;
@@ -1097,6 +1251,11 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
                     }
                 }
             }
+
+            // Every frame is drawn from the default state, so editing it in memory redraws them all
+            if (!frameSelected && baseAgent->GetEditStamp() != defaultStamp) {
+                MarkFramePreviewsDirty(0, 0);
+            }
         }
     }
     else {
@@ -1206,6 +1365,8 @@ void EngineUI::RenderAnimatorEditor(Scene& scene) {
     }
 
     ImGui::End();
+
+    TrimFramePreviews();
 }
 
 void EngineUI::RenderGameView(Scene& scene) {
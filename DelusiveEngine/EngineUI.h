@@ -9,6 +9,7 @@
 #include <imgui/backend/imgui_impl_sdl3.h>
 #include <imgui/backend/imgui_impl_opengl3.h>
 #include <filesystem>
+#include <unordered_map>
 
 enum class EditorMode {
 	SceneEditor,
@@ -80,7 +81,7 @@ public:
 	EngineUI(GameManager&, DelusiveRenderer&);
 	~EngineUI();
 	std::vector<std::string> LoadSceneList();
-	ImTextureID GetFramePreviewTexture(AnimationFrame&, Agent&);
+	ImTextureID GetFramePreviewTexture(int branchIndex, int frameIndex, Agent&);
 	void SetRenderer(const DelusiveRenderer&);
 	void Render(Scene& scene);
 	void RenderTopBar(Scene& scene);
@@ -127,10 +128,24 @@ private:
 	bool confirmAgentSwitch = false;
 	std::string pendingAgentFile;
 
+	//Frame previews keyed by (base agent file hash, branch, frame), redrawn only when the frame is dirty.
+	//Live edits to the default state mark every frame dirty.
+	struct FramePreview {
+		RenderTarget* target = nullptr;
+		int lastUsed = 0;
+	};
+	static constexpr int PreviewIdleFrames = 600;
+	std::unordered_map<uint64_t, FramePreview> framePreviews;
+	uint64_t previewAgentHash = 0;
+	RenderTarget* agentPreview = nullptr;   // live default state view
+	int previewFrame = 0;
+
 	//Helper functions
 	void SwitchMode(Scene&, EditorMode);
 	std::string GetPath(std::string);
-	void ClearFramePreviews(Animation& anim);
+	void ClearFramePreviews();
+	void TrimFramePreviews();
+	void MarkFramePreviewsDirty(size_t firstBranch, size_t firstFrame);
 	void ApplyOverrides(AnimationFrame&, Agent&);
 	void ResetOverrides();
 	void SetupAnimation(const std::string);
@@ -2,17 +2,41 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <tuple>
+#include "DelusiveMacros.h"
+#include "DelusiveUtils.h"
 #define STB_TRUETYPE_IMPLEMENTATION
 #include <stb/stb_truetype.h>
 
 Font::~Font() {
-    // Clean up textures
-    for (auto& [c, ch] : characters) {
-        glDeleteTextures(1, &ch.textureID);
+    if (atlasTexture) glDeleteTextures(1, &atlasTexture);
+}
+
+namespace {
+    constexpr uint32_t SdfCacheMagic = 0x46445344; // "DSDF"
+    constexpr uint32_t SdfCacheVersion = 1;
+
+    std::string SdfCachePath(const std::string& fontPath, uint64_t sourceHash) {
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(sourceHash));
+        return std::string(FONT_CACHE_FOLDER) + std::filesystem::path(fontPath).stem().string() + "_" + hex + ".sdf";
     }
+
+    struct SdfCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        float pixelHeight;
+        int32_t padding;
+        int32_t atlasWidth, atlasHeight;
+    };
 }
 
-bool Font::LoadFromFile(const std::string& path, float pixelHeight) {
+bool Font::LoadFromFile(const std::string& path, float requestedHeight, FontMode _mode) {
     std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         std::cerr << "Failed to open font file: " << path << std::endl;
@@ -32,45 +56,189 @@ bool Font::LoadFromFile(const std::string& path, float pixelHeight) {
         return false;
     }
 
+    mode = _mode;
+    pixelHeight = (mode == FontMode::SDF) ? SdfPixelHeight : requestedHeight;
     scale = stbtt_ScaleForPixelHeight(&fontInfo, pixelHeight);
     int ascentRaw, descent, lineGap;
     stbtt_GetFontVMetrics(&fontInfo, &ascentRaw, &descent, &lineGap);
     ascent = ascentRaw * scale;
+    lineHeight = (ascentRaw - descent + lineGap) * scale;
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GlyphRecord records[128];
+    std::vector<unsigned char> atlas;
 
-    for (unsigned char c = 0; c < 128; ++c) {
-        int w, h, xoff, yoff;
-        unsigned char* bmp = stbtt_GetCodepointBitmap(&fontInfo, 0, scale, c, &w, &h, &xoff, &yoff);
+    // Distance fields are slow to generate, so they are kept on disk keyed by the font's bytes
+    std::string cachePath;
+    uint64_t sourceHash = 0;
+    if (mode == FontMode::SDF) {
+        sourceHash = FnvOffset;
+        HashBytes(sourceHash, ttfBuffer.data(), ttfBuffer.size());
+        cachePath = SdfCachePath(path, sourceHash);
 
-        GLuint texID;
-        glGenTextures(1, &texID);
-        glBindTexture(GL_TEXTURE_2D, texID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, w, h, 0, GL_RED, GL_UNSIGNED_BYTE, bmp);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        std::ifstream cache(cachePath, std::ios::binary);
+        SdfCacheHeader header{};
+        if (cache.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            header.magic == SdfCacheMagic && header.version == SdfCacheVersion &&
+            header.sourceHash == sourceHash && header.pixelHeight == pixelHeight &&
+            header.padding == SdfPadding && header.atlasWidth > 0 && header.atlasHeight > 0) {
+            atlas.resize(static_cast<size_t>(header.atlasWidth) * header.atlasHeight);
+            if (cache.read(reinterpret_cast<char*>(records), sizeof(records)) &&
+                cache.read(reinterpret_cast<char*>(atlas.data()), atlas.size())) {
+                BuildAtlas(atlas, { header.atlasWidth, header.atlasHeight }, records);
+                return true;
+            }
+            std::cerr << "Font cache is truncated, regenerating: " << cachePath << std::endl;
+        }
+    }
+
+    // Rasterize every glyph first so the atlas can be sized before packing
+    unsigned char* pixels[128];
+    int totalArea = 0;
+    int widest = 1;
+    for (int c = 0; c < 128; ++c) {
+        int w = 0, h = 0, xoff = 0, yoff = 0;
+        if (mode == FontMode::SDF) {
+            // 128 marks the outline, one texel of distance is worth 128 / padding steps
+            pixels[c] = stbtt_GetCodepointSDF(&fontInfo, scale, c, SdfPadding, 128, 128.0f / SdfPadding, &w, &h, &xoff, &yoff);
+        }
+        else {
+            pixels[c] = stbtt_GetCodepointBitmap(&fontInfo, 0, scale, c, &w, &h, &xoff, &yoff);
+        }
+        if (!pixels[c]) w = h = 0;
 
         int advWidth, lsb;
         stbtt_GetCodepointHMetrics(&fontInfo, c, &advWidth, &lsb);
 
-        int x0, y0, x1, y1;
-        stbtt_GetCodepointBitmapBox(&fontInfo, c, scale, scale, &x0, &y0, &x1, &y1);
+        // bearing = (x0,y0) RELATIVE TO BASELINE
+        records[c] = { w, h, xoff, -yoff, 0, 0, static_cast<uint32_t>(advWidth * scale) };
+        totalArea += (w + 2) * (h + 2);
+        widest = std::max(widest, w + 2);
+    }
 
-        stbtt_FreeBitmap(bmp, nullptr);
+    // Shelf packing. Each glyph gets a one pixel border copied from its edge, so linear filtering
+    // behaves like the clamp-to-edge per-glyph textures did and never bleeds into a neighbour.
+    int atlasWidth = 64;
+    while (atlasWidth * atlasWidth < totalArea * 2 || atlasWidth < widest) atlasWidth *= 2;
 
-        Character ch{
-            texID,
-            glm::ivec2(x1 - x0, y1 - y0),   // size
-            glm::ivec2(x0, -y0),             // bearing = (x0,y0) RELATIVE TO BASELINE
-            advWidth * scale                 // float
-        };
-        characters[c] = ch;
+    int penX = 0, penY = 0, shelfHeight = 0;
+    for (GlyphRecord& glyph : records) {
+        if (penX + glyph.width + 2 > atlasWidth) {
+            penX = 0;
+            penY += shelfHeight;
+            shelfHeight = 0;
+        }
+        glyph.originX = penX + 1;
+        glyph.originY = penY + 1;
+        penX += glyph.width + 2;
+        shelfHeight = std::max(shelfHeight, glyph.height + 2);
+    }
+    int atlasHeight = 1;
+    while (atlasHeight < penY + shelfHeight) atlasHeight *= 2;
+
+    atlas.assign(static_cast<size_t>(atlasWidth) * atlasHeight, 0);
+    for (int c = 0; c < 128; ++c) {
+        const GlyphRecord& glyph = records[c];
+        if (glyph.width > 0 && glyph.height > 0) {
+            for (int row = -1; row <= glyph.height; ++row) {
+                const unsigned char* source = pixels[c] + std::clamp(row, 0, glyph.height - 1) * glyph.width;
+                unsigned char* destination = &atlas[(static_cast<size_t>(glyph.originY) + row) * atlasWidth + glyph.originX];
+                std::copy_n(source, glyph.width, destination);
+                destination[-1] = source[0];
+                destination[glyph.width] = source[glyph.width - 1];
+            }
+        }
+        if (mode == FontMode::SDF) stbtt_FreeSDF(pixels[c], nullptr);
+        else stbtt_FreeBitmap(pixels[c], nullptr);
+    }
+
+    BuildAtlas(atlas, { atlasWidth, atlasHeight }, records);
+
+    if (mode == FontMode::SDF) {
+        std::error_code error;
+        std::filesystem::create_directories(FONT_CACHE_FOLDER, error);
+        std::ofstream cache(cachePath, std::ios::binary | std::ios::trunc);
+        const SdfCacheHeader header{ SdfCacheMagic, SdfCacheVersion, sourceHash, pixelHeight, SdfPadding, atlasWidth, atlasHeight };
+        if (!cache.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !cache.write(reinterpret_cast<const char*>(records), sizeof(records)) ||
+            !cache.write(reinterpret_cast<const char*>(atlas.data()), atlas.size())) {
+            std::cerr << "Failed to write font cache: " << cachePath << std::endl;
+        }
     }
 
     return true;
 }
+
+void Font::BuildAtlas(const std::vector<unsigned char>& atlas, glm::ivec2 size, const GlyphRecord (&records)[128]) {
+    if (atlasTexture) glDeleteTextures(1, &atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, size.x, size.y, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    atlasSize = size;
+
+    const glm::vec2 texel(1.0f / size.x, 1.0f / size.y);
+    characters.clear();
+    for (int c = 0; c < 128; ++c) {
+        const GlyphRecord& glyph = records[c];
+        const glm::ivec2 origin(glyph.originX, glyph.originY);
+        const glm::ivec2 extent(glyph.width, glyph.height);
+
+        characters[static_cast<char>(c)] = Character{
+            atlasTexture,
+            extent,
+            glm::ivec2(glyph.bearingX, glyph.bearingY),
+            glyph.advance,
+            glm::vec2(origin) * texel,
+            glm::vec2(origin + extent) * texel
+        };
+    }
+}
+
+std::shared_ptr<Font> Font::Acquire(const std::string& path, float pixelHeight, FontMode mode) {
+    // Weak entries so an atlas is freed with its last label
+    static std::map<std::tuple<std::string, float, FontMode>, std::weak_ptr<Font>> loaded;
+
+    const auto key = std::make_tuple(path, mode == FontMode::SDF ? SdfPixelHeight : pixelHeight, mode);
+    if (auto existing = loaded[key].lock()) return existing;
+
+    auto font = std::make_shared<Font>();
+    if (!font->LoadFromFile(path, pixelHeight, mode)) {
+        loaded.erase(key);
+        return nullptr;
+    }
+    loaded[key] = font;
+    return font;
+}
+
+void Font::AppendQuads(const std::string& text, glm::vec2 position, float textScale,
+    const glm::vec4& color, std::vector<TextVertex>& out) const {
+    float x = position.x;
+    const float y = position.y;
+
+    for (char c : text) {
+        const Character& ch = GetCharacter(c);
+
+        if (ch.size.x > 0 && ch.size.y > 0) {
+            const float xpos = x + ch.bearing.x * textScale;
+            const float ypos = y - (ch.size.y - ch.bearing.y) * textScale;
+            const float w = ch.size.x * textScale;
+            const float h = ch.size.y * textScale;
+
+            const TextVertex bottomLeft{ { xpos, ypos }, { ch.uvMin.x, ch.uvMax.y }, color };
+            const TextVertex topLeft{ { xpos, ypos + h }, { ch.uvMin.x, ch.uvMin.y }, color };
+            const TextVertex topRight{ { xpos + w, ypos + h }, { ch.uvMax.x, ch.uvMin.y }, color };
+            const TextVertex bottomRight{ { xpos + w, ypos }, { ch.uvMax.x, ch.uvMax.y }, color };
+            out.insert(out.end(), { bottomLeft, topLeft, topRight, bottomLeft, topRight, bottomRight });
+        }
+
+        x += ch.advance * textScale;
+    }
+}
+
 const Character& Font::GetCharacter(char c) const {
     auto it = characters.find(c);
     if (it != characters.end()) {
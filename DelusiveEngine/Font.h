@@ -4,29 +4,78 @@
 #include <glm/glm.hpp>
 #include <GL/glew.h>
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <stb/stb_truetype.h>
 
 struct Character {
-    GLuint textureID;
+    GLuint textureID;    // the font's atlas
     glm::ivec2 size;     // Width, Height
     glm::ivec2 bearing;  // Offset from baseline
     GLuint advance;      // Advance to next glyph
+    glm::vec2 uvMin;     // Atlas rect, v grows downwards like the glyph bitmap
+    glm::vec2 uvMax;
 };
 
+//Screen-space text vertex, shared by every text path
+struct TextVertex {
+    glm::vec2 position;
+    glm::vec2 uv;
+    glm::vec4 color;
+};
+
+//Bitmap rasterizes coverage at the requested height. SDF stores a signed distance to the
+//outline at SdfPixelHeight instead, which the text_sdf shader thresholds at any draw size.
+enum class FontMode { Bitmap, SDF };
+
 class Font {
 public:
+    static constexpr float SdfPixelHeight = 48.0f;
+    static constexpr int SdfPadding = 6;     // texels of distance kept around each outline
+
     Font() = default;
     ~Font();
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    //SDF mode ignores pixelHeight and uses SdfPixelHeight, reading/writing FONT_CACHE_FOLDER
+    bool LoadFromFile(const std::string& path, float pixelHeight, FontMode mode = FontMode::Bitmap);
+    //Shares one loaded atlas between every user of the same file, height and mode
+    static std::shared_ptr<Font> Acquire(const std::string& path, float pixelHeight, FontMode mode);
 
-    bool LoadFromFile(const std::string& path, float pixelHeight);
     const Character& GetCharacter(char c) const;
     float GetAscent() const { return ascent; }
+    float GetLineHeight() const { return lineHeight; }  // baseline to baseline
+    float GetPixelHeight() const { return pixelHeight; }
+    bool IsSDF() const { return mode == FontMode::SDF; }
+    GLuint GetAtlasTexture() const { return atlasTexture; }
+    glm::ivec2 GetAtlasSize() const { return atlasSize; }
+
+    //Appends two triangles per visible glyph, baseline starting at position
+    void AppendQuads(const std::string& text, glm::vec2 position, float scale,
+        const glm::vec4& color, std::vector<TextVertex>& out) const;
 
 private:
+    //Placement of one glyph in the atlas, also the on-disk layout of the SDF cache
+    struct GlyphRecord {
+        int32_t width, height;
+        int32_t bearingX, bearingY;
+        int32_t originX, originY;
+        uint32_t advance;
+    };
+
+    void BuildAtlas(const std::vector<unsigned char>& atlas, glm::ivec2 size, const GlyphRecord (&records)[128]);
+
     std::unordered_map<char, Character> characters;
     stbtt_fontinfo fontInfo;
 
     float ascent = 0.0f;
+    float lineHeight = 0.0f;
     float scale = 1.0f;
+    float pixelHeight = 0.0f;
+    FontMode mode = FontMode::Bitmap;
     std::vector<unsigned char> ttfBuffer;
-};
\ No newline at end of file
+
+    GLuint atlasTexture = 0;
+    glm::ivec2 atlasSize = { 0, 0 };
+};
@@ -1,6 +1,8 @@
 #include "HitboxCollider.h"
 
-void HitboxCollider::OnCollision(ColliderComponent* col){
+void HitboxCollider::OnContact(ContactPhase phase, ColliderComponent* col){
+	if (phase != ContactPhase::Begin) return;
+
 	if (col->GetColliderType() == ColliderType::Hurtbox) {
 		std::cout << "[Hitbox] Damaged by enemy agent." << std::endl;
 		//Call damage here
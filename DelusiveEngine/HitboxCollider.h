@@ -6,8 +6,7 @@ class HitboxCollider : public ColliderComponent {
 public:
 
 	std::unique_ptr<Component> Clone() const override {
-		//TODO: Properly deep copy values
-		return std::make_unique<HitboxCollider>();
+		return CloneCollider<HitboxCollider>();
 	}
 
 	ColliderType GetColliderType() const override {
@@ -15,7 +14,7 @@ public:
 	}
 
 	void Update(float) override {};
-	void OnCollision(ColliderComponent*) override;
+	void OnContact(ContactPhase, ColliderComponent*) override;
 
 	const char* GetType() const override {
 		return "HitboxCollider";
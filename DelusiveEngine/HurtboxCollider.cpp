@@ -1,7 +1,9 @@
 #include "HurtboxCollider.h"
 
-void HurtboxCollider::OnCollision(ColliderComponent* col) {
-	//TODO: Prevent self hits
+void HurtboxCollider::OnContact(ContactPhase phase, ColliderComponent* col) {
+	//Once per hit, not once per overlapping frame
+	if (phase != ContactPhase::Begin) return;
+
 	if (col->GetColliderType() == ColliderType::Hitbox) {
 		std::cout << "[Hurtbox] Damaging enemy agent." << std::endl;
 		//Call damage here
@@ -5,8 +5,7 @@
 class HurtboxCollider : public ColliderComponent {
 public:
 	std::unique_ptr<Component> Clone() const override {
-		//TODO: Properly copy over values
-		return std::make_unique<HurtboxCollider>();
+		return CloneCollider<HurtboxCollider>();
 	}
 
 	ColliderType GetColliderType() const override {
@@ -18,7 +17,7 @@ public:
 	}
 
 	void Update(float) override {};
-	void OnCollision(ColliderComponent*) override;
+	void OnContact(ContactPhase, ColliderComponent*) override;
 
 	//void Serialize(std::ofstream& out) const override;
 	//void Deserialize(std::ifstream& in) override;
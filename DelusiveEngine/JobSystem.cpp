@@ -0,0 +1,170 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct ParallelBatch {
+		const std::function<void(int, int)>* job = nullptr;
+		int count = 0;
+		int grainSize = 1;
+		int chunkCount = 0;
+		std::atomic<int> nextChunk{ 0 };
+		std::atomic<int> finishedChunks{ 0 };
+	};
+
+	struct WorkerPool {
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+		std::mutex dispatchMutex; // one batch in flight at a time
+		ParallelBatch* batch = nullptr;
+		unsigned long long generation = 0;
+		int activeWorkers = 0;
+		int requestedWorkers = -1;
+		bool started = false;
+		bool stopping = false;
+
+		~WorkerPool() { Stop(); }
+
+		void Start();
+		void Stop();
+		void WorkerLoop();
+	};
+
+	thread_local bool insideJob = false;
+
+	WorkerPool& Pool() {
+		static WorkerPool pool;
+		return pool;
+	}
+
+	void RunChunks(ParallelBatch& batch) {
+		insideJob = true;
+		while (true) {
+			int chunk = batch.nextChunk.fetch_add(1);
+			if (chunk >= batch.chunkCount) break;
+
+			int begin = chunk * batch.grainSize;
+			int end = std::min(begin + batch.grainSize, batch.count);
+			(*batch.job)(begin, end);
+			batch.finishedChunks.fetch_add(1);
+		}
+		insideJob = false;
+	}
+
+	void WorkerPool::Start() {
+		int count = requestedWorkers;
+		if (count < 0) {
+			count = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+		}
+		count = std::max(count, 0);
+
+		stopping = false;
+		for (int i = 0; i < count; ++i) {
+			workers.emplace_back(&WorkerPool::WorkerLoop, this);
+		}
+		started = true;
+	}
+
+	void WorkerPool::Stop() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& worker : workers) {
+			if (worker.joinable()) worker.join();
+		}
+		workers.clear();
+		started = false;
+	}
+
+	void WorkerPool::WorkerLoop() {
+		unsigned long long seen = 0;
+		while (true) {
+			ParallelBatch* current = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stopping || (batch && generation != seen); });
+				if (stopping) return;
+
+				seen = generation;
+				current = batch;
+				++activeWorkers;
+			}
+
+			RunChunks(*current);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--activeWorkers;
+			}
+			finished.notify_all();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(int count, int grainSize, const std::function<void(int, int)>& job) {
+	if (count <= 0) return;
+	grainSize = std::max(grainSize, 1);
+
+	WorkerPool& pool = Pool();
+	if (insideJob || count <= grainSize) {
+		job(0, count);
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatch(pool.dispatchMutex);
+	if (!pool.started) pool.Start();
+	if (pool.workers.empty()) {
+		job(0, count);
+		return;
+	}
+
+	ParallelBatch batch;
+	batch.job = &job;
+	batch.count = count;
+	batch.grainSize = grainSize;
+	batch.chunkCount = (count + grainSize - 1) / grainSize;
+
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		pool.batch = &batch;
+		++pool.generation;
+	}
+	pool.wake.notify_all();
+
+	RunChunks(batch);
+
+	// Detach the batch before it leaves scope so late wakers cannot pick it up
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	pool.finished.wait(lock, [&] {
+		return batch.finishedChunks.load() == batch.chunkCount && pool.activeWorkers == 0;
+	});
+	pool.batch = nullptr;
+}
+
+int JobSystem::GetWorkerCount() {
+	WorkerPool& pool = Pool();
+	std::lock_guard<std::mutex> dispatch(pool.dispatchMutex);
+	if (!pool.started) pool.Start();
+	return static_cast<int>(pool.workers.size());
+}
+
+void JobSystem::SetWorkerCount(int count) {
+	WorkerPool& pool = Pool();
+	std::lock_guard<std::mutex> dispatch(pool.dispatchMutex);
+	pool.Stop();
+	pool.requestedWorkers = count;
+}
+
+void JobSystem::Shutdown() {
+	WorkerPool& pool = Pool();
+	std::lock_guard<std::mutex> dispatch(pool.dispatchMutex);
+	pool.Stop();
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <functional>
+
+// Small fork-join worker pool shared by the engine systems.
+// ParallelFor splits [0, count) into chunks of grainSize and blocks until every chunk has run.
+// The calling thread works on chunks too, and calls made from inside a job run inline.
+class JobSystem {
+public:
+	static void ParallelFor(int count, int grainSize, const std::function<void(int begin, int end)>& job);
+
+	static int GetWorkerCount();
+	static void SetWorkerCount(int); // -1 picks hardware_concurrency - 1
+	static void Shutdown();
+};
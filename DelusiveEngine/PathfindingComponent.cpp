@@ -1,19 +1,71 @@
 #include "PathfindingComponent.h"
 #include "PathfindingSystem.h"
+#include "Agent.h"
+#include "Scene.h"
+#include "RigidbodyComponent.h"
+#include "DelusiveRegistry.h"
 #include <glm/glm.hpp>
 #include <fstream>
 
 PathfindingComponent::PathfindingComponent() {
+    name = "New PathfindingComponent";
+    RegisterProperties();
+}
 
+void PathfindingComponent::RegisterProperties() {
+    Component::RegisterProperties();
+    registry->Register("speed", &speed);
+    registry->Register("radius", &radius);
 }
 
 std::unique_ptr<Component> PathfindingComponent::Clone() const{
-    //TODO: Make a proper deep copy
-	return std::make_unique<PathfindingComponent>();
+    auto copy = std::make_unique<PathfindingComponent>();
+    copy->SetName(GetName());
+    copy->SetEnabled(IsEnabled());
+    copy->speed = speed;
+    copy->radius = radius;
+    copy->debugColor = debugColor;
+    return copy;
 }
 
 void PathfindingComponent::Update(float deltaTime) {
+    if (!owner || !enabled) return;
+
+    Transform& agentTransform = owner->GetTransform();
+    Steering& steering = owner->steering;
+
+    if (!currentPath.empty()) {
+        AdvanceIfClose(agentTransform.position, radius);
 
+        if (PathComplete()) {
+            currentPath.clear();
+            currentWaypoint = 0;
+            steering.preferredVelocity = glm::vec2(0.0f);
+        }
+        else {
+            glm::vec2 toTarget = GetNextTarget() - agentTransform.position;
+            float distance = glm::length(toTarget);
+
+            // Ease into the final waypoint instead of overshooting it
+            float desiredSpeed = speed;
+            if (currentWaypoint + 1 == static_cast<int>(currentPath.size()) && deltaTime > 0.0f) {
+                desiredSpeed = std::min(speed, distance / deltaTime);
+            }
+            steering.preferredVelocity = distance > 0.0001f ? toTarget / distance * desiredSpeed : glm::vec2(0.0f);
+        }
+    }
+
+    // A CrowdSystem answers with a collision-free velocity, otherwise follow the preferred one.
+    // The answer is only good for this frame, so a crowd that stops ticking is not followed forever.
+    glm::vec2 velocity = steering.active ? steering.velocity : steering.preferredVelocity;
+    crowdSteered = steering.active;
+    steering.active = false;
+    if (RigidbodyComponent* body = owner->GetComponentOfType<RigidbodyComponent>()) {
+        body->SetVelocity(velocity);
+    }
+    else {
+        agentTransform.position += velocity * deltaTime;
+    }
 }
 
 void PathfindingComponent::DrawImGui() {
@@ -31,8 +83,15 @@ void PathfindingComponent::DrawImGui() {
         }
     }
 
+    ImGui::DragFloat("Speed", &speed, 0.1f, 0.0f, 100.0f);
+    ImGui::DragFloat("Radius", &radius, 0.01f, 0.0f, 10.0f);
+    if (owner) {
+        ImGui::Text("Velocity: (%.2f, %.2f)%s", owner->steering.velocity.x, owner->steering.velocity.y,
+            crowdSteered ? " [crowd]" : "");
+    }
+
     if (ImGui::Button("Clear Path")) {
-        currentPath.clear();
+        SetPath({});
     }
 
     if (ImGui::Button("Delete Component")) {
@@ -40,6 +99,36 @@ void PathfindingComponent::DrawImGui() {
     }
 }
 
+void PathfindingComponent::SetPath(const std::vector<glm::vec2>& newPath) {
+    currentPath = newPath;
+    currentWaypoint = 0;
+}
+
 void PathfindingComponent::RequestPath(glm::vec2 start, glm::vec2 end) {
-    //currentPath = pathfindingSystem.FindPath(start, end);
+    if (!owner || !owner->GetScene()) return;
+
+    PathfindingSystem* pathfinding = owner->GetScene()->GetSystem<PathfindingSystem>();
+    if (!pathfinding) {
+        std::cerr << "[PathfindingComponent] No PathfindingSystem in scene" << std::endl;
+        return;
+    }
+
+    SetPath(pathfinding->FindPath(start, end, PathMode::Smoothed));
+}
+
+glm::vec2 PathfindingComponent::GetNextTarget() const {
+    if (PathComplete()) {
+        return owner ? owner->GetTransform().position : glm::vec2(0.0f);
+    }
+    return currentPath[currentWaypoint];
+}
+
+void PathfindingComponent::AdvanceIfClose(glm::vec2 position, float threshold) {
+    while (!PathComplete() && glm::distance(position, currentPath[currentWaypoint]) <= threshold) {
+        ++currentWaypoint;
+    }
+}
+
+bool PathfindingComponent::PathComplete() const {
+    return currentWaypoint >= static_cast<int>(currentPath.size());
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ public:
 
 	//Virtual function overrides
 	std::unique_ptr<Component> Clone() const override;
+	void RegisterProperties() override;
 	void DrawImGui() override;
 	void Update(float deltaTime) override;
 	void Draw(const glm::mat4& projection) const override {};
@@ -21,15 +22,20 @@ public:
 	//Pathfinding logic
 	void SetPath(const std::vector<glm::vec2>& newPath);
 	void RequestPath(glm::vec2, glm::vec2);
-	void GetNextTarget() const;
+	glm::vec2 GetNextTarget() const;
 	void AdvanceIfClose(glm::vec2 position, float threshold = 0.1f);
-	void PathComplete() const;
-	
+	bool PathComplete() const;
+
+	//Crowd parameters read by the CrowdSystem
+	float GetSpeed() const { return speed; }
+	float GetRadius() const { return radius; }
 
 private:
 	std::vector<glm::vec2> currentPath;
 	float speed = 5.0f;
-	int currentWaypoint = 0; //TODO: Implement waypoints
+	float radius = 0.4f;
+	int currentWaypoint = 0;
+	bool crowdSteered = false; // the last update followed a CrowdSystem velocity
 
 	glm::vec4 debugColor = glm::vec4(1, 1, 0, 1);
 };
\ No newline at end of file
@@ -1,9 +1,27 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include "PathfindingSystem.h"
+#include "Scene.h"
+#include "EnvironmentAgent.h"
+#include "SolidCollider.h"
+#include "TilemapComponent.h"
+#include "JobSystem.h"
+#include "DelusiveUtils.h"
 #include <limits>
 #include <algorithm>
+#include <iterator>
 #include <cmath>
+#include <chrono>
+#include <tuple>
 #include <glm/gtx/hash.hpp>
+#include <cstdio>
+#include <random>
+
+namespace {
+	constexpr int SmoothingCheckMaps = 40;
+	constexpr int SmoothingCheckPaths = 50;
+	constexpr int SmoothingCheckWidth = 48;
+	constexpr int SmoothingCheckHeight = 36;
+}
 
 PathfindingSystem::PathfindingSystem(DelusiveRenderer& _renderer) 
 	: SceneSystem(_renderer)
@@ -15,35 +33,86 @@ PathfindingSystem::PathfindingSystem(DelusiveRenderer& _renderer)
 void PathfindingSystem::RegisterProperties() {
 	SceneSystem::RegisterProperties();
 
+	registry.Register("agentRadius", &agentRadius);
+	registry.Register("autoRebake", &autoRebake);
+	registry.Register("pathCacheCapacity", &pathCacheCapacity);
+	registry.Register("cellSize", &cellSize);
+	registry.Register("navOrigin", &savedOrigin);
+	registry.Register("navBounds", &savedBounds);
+	registry.Register("navCells", &savedCells);
+}
 
+void PathfindingSystem::Serialize(std::ostream& out) const {
+	savedOrigin = worldOrigin;
+	savedBounds.clear();
+	savedCells.clear();
+
+	if (!cells.empty()) {
+		savedBounds = { gridMin.x, gridMin.y, gridExtent.x, gridExtent.y };
+		savedCells.assign((cells.size() + 15) / 16, 0);
+		for (size_t i = 0; i < cells.size(); ++i) {
+			if (!cells[i]) continue;
+			uint32_t code = cells[i]->walkable ? 1u : 2u;
+			uint32_t packed = static_cast<uint32_t>(savedCells[i / 16]) | (code << ((i % 16) * 2));
+			savedCells[i / 16] = static_cast<int>(packed);
+		}
+	}
+
+	SceneSystem::Serialize(out);
 }
 
-std::unique_ptr<SceneSystem> PathfindingSystem::Clone() const {
-	auto clone = std::make_unique<PathfindingSystem>(renderer);
+void PathfindingSystem::Deserialize(std::istream& in) {
+	SceneSystem::Deserialize(in);
 
-	// Clone all nodes
-	std::unordered_map<const Node*, Node*> originalToClone;
-	for (const auto& originalNodePtr : allNodes) {
-		if (!originalNodePtr) continue;
+	std::vector<Node> nodes;
+	if (savedBounds.size() == 4) {
+		glm::ivec2 savedMin(savedBounds[0], savedBounds[1]);
+		glm::ivec2 savedExtent(savedBounds[2], savedBounds[3]);
 
-		// Copy node
-		auto newNode = std::make_unique<Node>(*originalNodePtr);
+		for (int y = 0; y < savedExtent.y; ++y) {
+			for (int x = 0; x < savedExtent.x; ++x) {
+				size_t i = static_cast<size_t>(y) * savedExtent.x + x;
+				if (i / 16 >= savedCells.size()) break;
 
-		// Keep track of mapping from original to cloned node
-		originalToClone[originalNodePtr.get()] = newNode.get();
+				uint32_t code = (static_cast<uint32_t>(savedCells[i / 16]) >> ((i % 16) * 2)) & 3u;
+				if (code == 0) continue;
 
-		// Store it in clone->allNodes
-		clone->allNodes.push_back(std::move(newNode));
+				glm::vec2 worldPos = savedOrigin + glm::vec2(x, y) * cellSize;
+				nodes.emplace_back(savedMin + glm::ivec2(x, y), worldPos, code == 1);
+			}
+		}
 	}
 
-	// Rebuild gridMap with cloned node pointers
-	for (const auto& [pos, originalNode] : gridMap) {
-		auto it = originalToClone.find(originalNode);
-		if (it != originalToClone.end()) {
-			clone->gridMap[pos] = it->second;
-		}
+	BuildNavGrid(nodes, cellSize);
+}
+
+void PathfindingSystem::Update(float) {
+	// The scene reports edited environment agents, so an idle frame does no work here
+	if (!bakedShapesValid) {
+		SnapshotShapes();
+	}
+	else if (autoRebake) {
+		RebakeEdited();
+	}
+}
+
+std::unique_ptr<SceneSystem> PathfindingSystem::Clone() const {
+	auto clone = std::make_unique<PathfindingSystem>(renderer);
+
+	// Copy node data and let the clone rebuild its own links and lookup tables
+	std::vector<Node> nodes;
+	nodes.reserve(allNodes.size());
+	for (const auto& originalNodePtr : allNodes) {
+		if (!originalNodePtr) continue;
+		nodes.emplace_back(originalNodePtr->gridPos, originalNodePtr->worldPos, originalNodePtr->walkable);
 	}
 
+	clone->BuildNavGrid(nodes, cellSize);
+	clone->agentRadius = agentRadius;
+	clone->autoRebake = autoRebake;
+	clone->pathCacheCapacity = pathCacheCapacity;
+	// Baked shapes are keyed by this scene's agents, the clone snapshots its own
+
 	return clone;
 }
 
@@ -54,20 +123,20 @@ void PathfindingSystem::DrawImGui() {
 	ImGui::Text("Nodes: %zu", allNodes.size());
 	ImGui::Text("GridMap Size: %zu", gridMap.size());
 
-	// Toggle debug draw
-	static bool drawGrid = true;
+	// Same switch as the NavGrid category in the debug draw menu
+	bool drawGrid = renderer.GetDebugDraw().IsEnabled(DebugCategory::NavGrid);
 	if (ImGui::Checkbox("Draw NavGrid", &drawGrid)) {
-		// You can hook this into your Scene debug-draw flag instead of static
+		renderer.GetDebugDraw().SetEnabled(DebugCategory::NavGrid, drawGrid);
 	}
 
 	// Grid build parameters
 	static int gridWidth = 20;
 	static int gridHeight = 20;
-	static float cellSize = 1.0f;
+	static float buildCellSize = 1.0f;
 
 	ImGui::InputInt("Grid Width", &gridWidth);
 	ImGui::InputInt("Grid Height", &gridHeight);
-	ImGui::InputFloat("Cell Size", &cellSize);
+	ImGui::InputFloat("Cell Size", &buildCellSize);
 
 	if (ImGui::Button("Build Grid")) {
 		std::vector<Node> newNodes;
@@ -76,11 +145,55 @@ void PathfindingSystem::DrawImGui() {
 		for (int y = 0; y < gridHeight; ++y) {
 			for (int x = 0; x < gridWidth; ++x) {
 				glm::ivec2 gridPos(x, y);
-				glm::vec2 worldPos = glm::vec2(x * cellSize, y * cellSize);
+				glm::vec2 worldPos = glm::vec2(x * buildCellSize, y * buildCellSize);
 				newNodes.emplace_back(gridPos, worldPos, true);
 			}
 		}
-		BuildNavGrid(newNodes);
+		BuildNavGrid(newNodes, buildCellSize);
+	}
+
+	ImGui::SeparatorText("Baking");
+	ImGui::DragFloat("Agent Radius", &agentRadius, 0.05f, 0.0f, 100.0f);
+	ImGui::Checkbox("Auto Rebake", &autoRebake);
+
+	if (ImGui::Button("Bake From Colliders")) {
+		BakeFromColliders();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Rebake")) {
+		RebakeChanged();
+	}
+	ImGui::Text("Last bake: %d cells changed in %.2f ms", lastBakeCells, lastBakeMs);
+
+	ImGui::SeparatorText("Path Smoothing");
+	if (ImGui::Button("Run Smoothing Check")) {
+		RunSmoothingCheck();
+	}
+	if (!smoothingResult.empty()) {
+		ImGui::Text("%s", smoothingResult.c_str());
+	}
+
+	ImGui::SeparatorText("Path Cache");
+	if (ImGui::DragInt("Capacity", &pathCacheCapacity, 1.0f, 0, 65536)) {
+		pathCacheCapacity = std::max(pathCacheCapacity, 0);
+		while (static_cast<int>(pathCache.size()) > pathCacheCapacity) {
+			pathCacheLookup.erase(pathCache.back().key);
+			pathCache.pop_back();
+		}
+	}
+
+	uint64_t lookups = cacheHits + cacheMisses;
+	float hitRate = lookups > 0 ? 100.0f * static_cast<float>(cacheHits) / lookups : 0.0f;
+	ImGui::Text("Entries: %zu / %d", pathCache.size(), pathCacheCapacity);
+	ImGui::Text("Hits: %llu  Misses: %llu  Hit rate: %.1f%%",
+		static_cast<unsigned long long>(cacheHits), static_cast<unsigned long long>(cacheMisses), hitRate);
+	ImGui::Text("Invalidated: %llu", static_cast<unsigned long long>(cacheInvalidations));
+	if (ImGui::Button("Reset Stats")) {
+		cacheHits = cacheMisses = cacheInvalidations = 0;
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clear Cache")) {
+		ClearPathCache();
 	}
 
 	// Manual walkability editing
@@ -92,7 +205,7 @@ void PathfindingSystem::DrawImGui() {
 		Node* node = it->second;
 		bool walkable = node->walkable;
 		if (ImGui::Checkbox("Walkable", &walkable)) {
-			node->walkable = walkable;
+			SetWalkable(selectedTile, walkable);
 		}
 	}
 	else {
@@ -101,14 +214,14 @@ void PathfindingSystem::DrawImGui() {
 
 	// Optional clear button
 	if (ImGui::Button("Clear Grid")) {
-		gridMap.clear();
-		allNodes.clear();
+		BuildNavGrid({});
 	}
 }
 
-void PathfindingSystem::BuildNavGrid(const std::vector<Node>& nodes) {
+void PathfindingSystem::BuildNavGrid(const std::vector<Node>& nodes, float _cellSize) {
 	gridMap.clear();
 	allNodes.clear();
+	cellSize = _cellSize > 0.0f ? _cellSize : 1.0f;
 
 	for (const Node& n : nodes) {
 		auto node = std::make_unique<Node>(n.gridPos, n.worldPos, n.walkable);
@@ -117,47 +230,565 @@ void PathfindingSystem::BuildNavGrid(const std::vector<Node>& nodes) {
 	}
 
 	for (const auto& pair : gridMap) {
-		Node* node = pair.second;
-		glm::ivec2 directions[4] = {
-			{1,0}, {-1,0}, {0,1}, {0,-1}
-		};
-
-		for (const glm::ivec2& dir : directions) {
-			glm::ivec2 neighborPos = node->gridPos + dir;
-			auto it = gridMap.find(neighborPos);
-			if (it != gridMap.end() && it->second->walkable) {
-				node->neighbors.push_back(it->second);
+		LinkNeighbors(pair.second);
+	}
+
+	RebuildLookup();
+
+	// A new grid has not been baked against anything yet
+	bakedShapes.clear();
+	bakedShapesValid = false;
+}
+
+bool PathfindingSystem::BakedShape::operator<(const BakedShape& other) const {
+	return std::tie(shape, a.x, a.y, b.x, b.y, radius)
+		< std::tie(other.shape, other.a.x, other.a.y, other.b.x, other.b.y, other.radius);
+}
+
+bool PathfindingSystem::BakedShape::operator==(const BakedShape& other) const {
+	return shape == other.shape && a == other.a && b == other.b && radius == other.radius;
+}
+
+std::vector<PathfindingSystem::BakedShape> PathfindingSystem::CollectShapes(Agent& agent) {
+	std::vector<BakedShape> shapes;
+
+	// Includes the merged solids of tilemaps
+	for (ColliderComponent* collider : agent.GetColliders()) {
+		if (!collider->IsEnabled() || collider->GetColliderType() != ColliderType::Solid) continue;
+
+		BakedShape baked{ collider->GetShapeType(), glm::vec2(0.0f), glm::vec2(0.0f), 0.0f };
+		switch (baked.shape) {
+		case ShapeType::Box: {
+			const Zone bounds = collider->GetWorldBounds();
+			baked.a = bounds.min;
+			baked.b = bounds.max;
+			break;
+		}
+		case ShapeType::Circle:
+			collider->GetWorldCircle(baked.a, baked.radius);
+			break;
+		case ShapeType::Line:
+			collider->GetWorldSegment(baked.a, baked.b);
+			break;
+		}
+		shapes.push_back(baked);
+	}
+
+	// Tiles that only keep pathing agents out have no collider
+	std::vector<Zone> blockers;
+	for (TilemapComponent* tilemap : agent.GetComponentsOfType<TilemapComponent>()) {
+		tilemap->GetNavBlockers(blockers);
+	}
+	for (const Zone& blocker : blockers) {
+		shapes.push_back({ ShapeType::Box, blocker.min, blocker.max, 0.0f });
+	}
+
+	std::sort(shapes.begin(), shapes.end());
+	return shapes;
+}
+
+std::unordered_map<const Agent*, std::vector<PathfindingSystem::BakedShape>> PathfindingSystem::CollectAllShapes() {
+	std::unordered_map<const Agent*, std::vector<BakedShape>> shapes;
+	if (!scene) return shapes;
+
+	for (auto& agent : scene->GetAgents()) {
+		if (!agent || !dynamic_cast<EnvironmentAgent*>(agent.get())) continue;
+		shapes[agent.get()] = CollectShapes(*agent);
+	}
+	return shapes;
+}
+
+// Local cell range covered by a shape once inflated by the agent radius and half a cell
+bool PathfindingSystem::ShapeCellRange(const BakedShape& shape, glm::ivec2& outMin, glm::ivec2& outMax) const {
+	if (cells.empty()) return false;
+
+	glm::vec2 lo, hi;
+	switch (shape.shape) {
+	case ShapeType::Box:
+		lo = shape.a;
+		hi = shape.b;
+		break;
+	case ShapeType::Circle:
+		lo = shape.a - glm::vec2(shape.radius);
+		hi = shape.a + glm::vec2(shape.radius);
+		break;
+	default:
+		lo = glm::min(shape.a, shape.b);
+		hi = glm::max(shape.a, shape.b);
+		break;
+	}
+
+	const float clearance = agentRadius + 0.5f * cellSize;
+	lo -= glm::vec2(clearance);
+	hi += glm::vec2(clearance);
+
+	outMin = glm::max(glm::ivec2(glm::ceil((lo - worldOrigin) / cellSize)), glm::ivec2(0));
+	outMax = glm::min(glm::ivec2(glm::floor((hi - worldOrigin) / cellSize)), gridExtent - glm::ivec2(1));
+	return outMin.x <= outMax.x && outMin.y <= outMax.y;
+}
+
+// Rasterizes shapes into the local cell rectangle [regionMin, regionMax].
+// A cell is blocked when its lattice point lies within agentRadius + half a cell of any shape.
+int PathfindingSystem::BakeRegion(glm::ivec2 regionMin, glm::ivec2 regionMax, const std::vector<BakedShape>& shapes) {
+	regionMin = glm::max(regionMin, glm::ivec2(0));
+	regionMax = glm::min(regionMax, gridExtent - glm::ivec2(1));
+	if (cells.empty() || regionMin.x > regionMax.x || regionMin.y > regionMax.y) return 0;
+
+	const glm::ivec2 size = regionMax - regionMin + glm::ivec2(1);
+	const float clearance = agentRadius + 0.5f * cellSize;
+
+	// Bucket shapes by row so each row only tests geometry that can reach it
+	struct RowEntry {
+		int shape;
+		int minX;
+		int maxX;
+	};
+	std::vector<std::vector<RowEntry>> rows(size.y);
+	for (int i = 0; i < static_cast<int>(shapes.size()); ++i) {
+		glm::ivec2 lo, hi;
+		if (!ShapeCellRange(shapes[i], lo, hi)) continue;
+
+		lo = glm::max(lo, regionMin);
+		hi = glm::min(hi, regionMax);
+		for (int y = lo.y; y <= hi.y; ++y) {
+			if (lo.x <= hi.x) rows[y - regionMin.y].push_back({ i, lo.x, hi.x });
+		}
+	}
+
+	auto touches = [clearance](const BakedShape& shape, glm::vec2 point) {
+		switch (shape.shape) {
+		case ShapeType::Box: {
+			glm::vec2 outside = glm::max(glm::max(shape.a - point, point - shape.b), glm::vec2(0.0f));
+			return glm::dot(outside, outside) <= clearance * clearance;
+		}
+		case ShapeType::Circle: {
+			glm::vec2 offset = point - shape.a;
+			float reach = shape.radius + clearance;
+			return glm::dot(offset, offset) <= reach * reach;
+		}
+		case ShapeType::Line: {
+			glm::vec2 segment = shape.b - shape.a;
+			float lengthSq = glm::dot(segment, segment);
+			float t = lengthSq > 0.0f ? glm::clamp(glm::dot(point - shape.a, segment) / lengthSq, 0.0f, 1.0f) : 0.0f;
+			glm::vec2 offset = point - (shape.a + segment * t);
+			return glm::dot(offset, offset) <= clearance * clearance;
+		}
+		}
+		return false;
+	};
+
+	std::vector<uint8_t> blocked(static_cast<size_t>(size.x) * size.y, 0);
+	JobSystem::ParallelFor(size.y, 8, [&](int begin, int end) {
+		for (int row = begin; row < end; ++row) {
+			for (const RowEntry& entry : rows[row]) {
+				const BakedShape& shape = shapes[entry.shape];
+				for (int x = entry.minX; x <= entry.maxX; ++x) {
+					uint8_t& cell = blocked[static_cast<size_t>(row) * size.x + (x - regionMin.x)];
+					if (cell) continue;
+
+					glm::vec2 point = worldOrigin + glm::vec2(x, regionMin.y + row) * cellSize;
+					cell = touches(shape, point) ? 1 : 0;
+				}
 			}
 		}
+	});
+
+	std::vector<Node*> changed;
+	for (int y = 0; y < size.y; ++y) {
+		for (int x = 0; x < size.x; ++x) {
+			Node* node = cells[(regionMin.y + y) * gridExtent.x + regionMin.x + x];
+			if (node && node->walkable == (blocked[static_cast<size_t>(y) * size.x + x] != 0)) {
+				changed.push_back(node);
+			}
+		}
+	}
+
+	// Small edits go through the incremental path, large ones rebuild everything once
+	if (changed.size() > cells.size() / 8) {
+		for (Node* node : changed) {
+			node->walkable = !node->walkable;
+		}
+		for (const auto& node : allNodes) {
+			LinkNeighbors(node.get());
+		}
+		RebuildLookup();
 	}
+	else {
+		for (Node* node : changed) {
+			SetWalkable(node->gridPos, !node->walkable);
+		}
+	}
+
+	return static_cast<int>(changed.size());
 }
 
-Node* PathfindingSystem::GetClosestNode(glm::vec2 worldPos) const {
-	Node* closest = nullptr;
-	float bestDist = std::numeric_limits<float>::max();
+void PathfindingSystem::BakeFromColliders() {
+	auto start = std::chrono::steady_clock::now();
+
+	bakedShapes = CollectAllShapes();
+	bakedShapesValid = true;
+	editedAgents.clear();
+	removedShapes.clear();
+
+	std::vector<BakedShape> shapes;
+	for (const auto& [agent, agentShapes] : bakedShapes) {
+		shapes.insert(shapes.end(), agentShapes.begin(), agentShapes.end());
+	}
+	lastBakeCells = BakeRegion(glm::ivec2(0), gridExtent - glm::ivec2(1), shapes);
+
+	lastBakeMs = MillisecondsSince(start);
+}
+
+void PathfindingSystem::OnAgentEdited(Agent& agent) {
+	if (dynamic_cast<EnvironmentAgent*>(&agent)) {
+		editedAgents.insert(&agent);
+	}
+}
+
+void PathfindingSystem::OnAgentRemoved(Agent& agent) {
+	editedAgents.erase(&agent);
+	auto it = bakedShapes.find(&agent);
+	if (it == bakedShapes.end()) return;
+	removedShapes.insert(removedShapes.end(), it->second.begin(), it->second.end());
+	bakedShapes.erase(it);
+}
+
+// Loaded or cloned grids were baked earlier, so just take a snapshot to diff against
+void PathfindingSystem::SnapshotShapes() {
+	bakedShapes = CollectAllShapes();
+	bakedShapesValid = true;
+	editedAgents.clear();
+	removedShapes.clear();
+}
+
+// Re-bakes the cells around shapes that appeared, disappeared or moved against the current bakedShapes
+int PathfindingSystem::RebakeShapes(const std::vector<BakedShape>& changed) {
+	std::vector<BakedShape> shapes;
+	for (const auto& [agent, agentShapes] : bakedShapes) {
+		shapes.insert(shapes.end(), agentShapes.begin(), agentShapes.end());
+	}
+
+	int cells = 0;
+	for (const BakedShape& shape : changed) {
+		glm::ivec2 lo, hi;
+		if (ShapeCellRange(shape, lo, hi)) {
+			cells += BakeRegion(lo, hi, shapes);
+		}
+	}
+	return cells;
+}
+
+bool PathfindingSystem::RebakeEdited() {
+	if (editedAgents.empty() && removedShapes.empty()) return false;
+	if (!bakedShapesValid) {
+		SnapshotShapes();
+		return false;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	// A moved shape shows up at both its old and new spot
+	std::vector<BakedShape> changedShapes = std::move(removedShapes);
+	removedShapes.clear();
+	for (Agent* edited : editedAgents) {
+		std::vector<BakedShape> shapes = CollectShapes(*edited);
+		std::vector<BakedShape>& baked = bakedShapes[edited];
+		std::set_symmetric_difference(baked.begin(), baked.end(), shapes.begin(), shapes.end(),
+			std::back_inserter(changedShapes));
+		baked = std::move(shapes);
+	}
+	editedAgents.clear();
+	if (changedShapes.empty()) return false;
+
+	lastBakeCells = RebakeShapes(changedShapes);
+	lastBakeMs = MillisecondsSince(start);
+	return true;
+}
+
+bool PathfindingSystem::RebakeChanged() {
+	if (!bakedShapesValid) {
+		SnapshotShapes();
+		return false;
+	}
+	auto start = std::chrono::steady_clock::now();
+
+	std::unordered_map<const Agent*, std::vector<BakedShape>> shapes = CollectAllShapes();
+	editedAgents.clear();
+
+	std::vector<BakedShape> changedShapes = std::move(removedShapes);
+	removedShapes.clear();
+	const std::vector<BakedShape> none;
+	for (const auto& [agent, agentShapes] : shapes) {
+		auto it = bakedShapes.find(agent);
+		const std::vector<BakedShape>& baked = it != bakedShapes.end() ? it->second : none;
+		std::set_symmetric_difference(baked.begin(), baked.end(), agentShapes.begin(), agentShapes.end(),
+			std::back_inserter(changedShapes));
+	}
+	// Agents that went away without a notification
+	for (const auto& [agent, agentShapes] : bakedShapes) {
+		if (!shapes.count(agent)) {
+			changedShapes.insert(changedShapes.end(), agentShapes.begin(), agentShapes.end());
+		}
+	}
+	bakedShapes = std::move(shapes);
+	if (changedShapes.empty()) return false;
+
+	lastBakeCells = RebakeShapes(changedShapes);
+	lastBakeMs = MillisecondsSince(start);
+	return true;
+}
+
+void PathfindingSystem::LinkNeighbors(Node* node) {
+	node->neighbors.clear();
+
+	glm::ivec2 directions[4] = {
+		{1,0}, {-1,0}, {0,1}, {0,-1}
+	};
+
+	for (const glm::ivec2& dir : directions) {
+		glm::ivec2 neighborPos = node->gridPos + dir;
+		auto it = gridMap.find(neighborPos);
+		if (it != gridMap.end() && it->second->walkable) {
+			node->neighbors.push_back(it->second);
+		}
+	}
+}
+
+int PathfindingSystem::CellIndex(glm::ivec2 gridPos) const {
+	glm::ivec2 local = gridPos - gridMin;
+	if (local.x < 0 || local.y < 0 || local.x >= gridExtent.x || local.y >= gridExtent.y) {
+		return -1;
+	}
+	return local.y * gridExtent.x + local.x;
+}
+
+glm::ivec2 PathfindingSystem::WorldToCell(glm::vec2 worldPos) const {
+	// Nodes sit on lattice points, so rounding picks the nearest one
+	glm::vec2 local = (worldPos - worldOrigin) / cellSize;
+	return gridMin + glm::ivec2(glm::floor(local + glm::vec2(0.5f)));
+}
+
+void PathfindingSystem::RebuildLookup() {
+	ClearPathCache();
+	regionStamps.clear();
+	regionCount = { 0, 0 };
+
+	cells.clear();
+	nearestWalkable.clear();
+	walkableDistance.clear();
+	gridMin = { 0, 0 };
+	gridExtent = { 0, 0 };
+	worldOrigin = { 0.0f, 0.0f };
+
+	if (allNodes.empty()) return;
+
+	glm::ivec2 gridMax = allNodes.front()->gridPos;
+	gridMin = gridMax;
+	for (const auto& node : allNodes) {
+		gridMin = glm::min(gridMin, node->gridPos);
+		gridMax = glm::max(gridMax, node->gridPos);
+	}
+
+	gridExtent = gridMax - gridMin + glm::ivec2(1);
+	const Node* anchor = allNodes.front().get();
+	worldOrigin = anchor->worldPos - glm::vec2(anchor->gridPos - gridMin) * cellSize;
+
+	const size_t cellCount = static_cast<size_t>(gridExtent.x) * gridExtent.y;
+	cells.assign(cellCount, nullptr);
+	nearestWalkable.assign(cellCount, -1);
+	walkableDistance.assign(cellCount, std::numeric_limits<int>::max());
+
+	regionCount = (gridExtent + glm::ivec2(CacheRegionSize - 1)) / CacheRegionSize;
+	regionStamps.assign(static_cast<size_t>(regionCount.x) * regionCount.y, 0);
+
+	std::vector<int> seeds;
+	for (const auto& node : allNodes) {
+		int index = CellIndex(node->gridPos);
+		cells[index] = node.get();
+		if (node->walkable) {
+			nearestWalkable[index] = index;
+			walkableDistance[index] = 0;
+			seeds.push_back(index);
+		}
+	}
+
+	PropagateNearest(seeds);
+}
+
+// Chamfer (3-4) distance transform seeded from cells whose nearestWalkable is already known.
+// Seeds may carry different distances, so a heap keeps the expansion ordered.
+void PathfindingSystem::PropagateNearest(const std::vector<int>& seeds) {
+	struct Entry {
+		int distance;
+		int index;
+		bool operator>(const Entry& other) const {
+			return distance > other.distance;
+		}
+	};
+
+	static const glm::ivec3 steps[8] = {
+		{ 1, 0, 3 }, { -1, 0, 3 }, { 0, 1, 3 }, { 0, -1, 3 },
+		{ 1, 1, 4 }, { -1, 1, 4 }, { 1, -1, 4 }, { -1, -1, 4 }
+	};
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<>> frontier;
+	for (int index : seeds) {
+		frontier.push({ walkableDistance[index], index });
+	}
+
+	while (!frontier.empty()) {
+		Entry current = frontier.top();
+		frontier.pop();
+		if (current.distance != walkableDistance[current.index]) continue; // stale entry
+
+		glm::ivec2 local(current.index % gridExtent.x, current.index / gridExtent.x);
+		for (const glm::ivec3& step : steps) {
+			glm::ivec2 next = local + glm::ivec2(step.x, step.y);
+			if (next.x < 0 || next.y < 0 || next.x >= gridExtent.x || next.y >= gridExtent.y) continue;
+
+			int nextIndex = next.y * gridExtent.x + next.x;
+			int nextDistance = current.distance + step.z;
+			if (nextDistance < walkableDistance[nextIndex]) {
+				walkableDistance[nextIndex] = nextDistance;
+				nearestWalkable[nextIndex] = nearestWalkable[current.index];
+				frontier.push({ nextDistance, nextIndex });
+			}
+		}
+	}
+}
+
+bool PathfindingSystem::IsWalkable(glm::ivec2 gridPos) const {
+	int index = CellIndex(gridPos);
+	return index >= 0 && cells[index] && cells[index]->walkable;
+}
+
+void PathfindingSystem::SetWalkable(glm::ivec2 gridPos, bool walkable) {
+	int index = CellIndex(gridPos);
+	if (index < 0 || !cells[index]) return;
+
+	Node* node = cells[index];
+	if (node->walkable == walkable) return;
+	node->walkable = walkable;
+
+	glm::ivec2 cacheRegion = (gridPos - gridMin) / CacheRegionSize;
+	regionStamps[cacheRegion.y * regionCount.x + cacheRegion.x] = ++editStamp;
+
+	// Neighbor lists only hold walkable nodes, so relink the edited node and everything around it
+	LinkNeighbors(node);
+	glm::ivec2 directions[4] = {
+		{1,0}, {-1,0}, {0,1}, {0,-1}
+	};
+	for (const glm::ivec2& dir : directions) {
+		int neighborIndex = CellIndex(gridPos + dir);
+		if (neighborIndex >= 0 && cells[neighborIndex]) {
+			LinkNeighbors(cells[neighborIndex]);
+		}
+	}
+
+	if (walkable) {
+		nearestWalkable[index] = index;
+		walkableDistance[index] = 0;
+		PropagateNearest({ index });
+		return;
+	}
+
+	// Cells that resolved to this node form a connected region around it.
+	// Clear that region, then regrow it from the valid cells along its border.
+	std::vector<int> region;
+	std::vector<int> stack = { index };
+	nearestWalkable[index] = -2; // visited marker while collecting
+	while (!stack.empty()) {
+		int current = stack.back();
+		stack.pop_back();
+		region.push_back(current);
+
+		glm::ivec2 local(current % gridExtent.x, current / gridExtent.x);
+		for (int dy = -1; dy <= 1; ++dy) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				glm::ivec2 next = local + glm::ivec2(dx, dy);
+				if (next.x < 0 || next.y < 0 || next.x >= gridExtent.x || next.y >= gridExtent.y) continue;
+
+				int nextIndex = next.y * gridExtent.x + next.x;
+				if (nearestWalkable[nextIndex] == index) {
+					nearestWalkable[nextIndex] = -2;
+					stack.push_back(nextIndex);
+				}
+			}
+		}
+	}
 
-	for (const auto& nodePtr : allNodes) {
-		if (!nodePtr->walkable) continue;
-		float d = glm::distance(worldPos, nodePtr->worldPos);
-		if (d < bestDist) {
-			bestDist = d;
-			closest = nodePtr.get();
+	std::vector<int> seeds;
+	for (int cell : region) {
+		nearestWalkable[cell] = -1;
+		walkableDistance[cell] = std::numeric_limits<int>::max();
+	}
+	for (int cell : region) {
+		glm::ivec2 local(cell % gridExtent.x, cell / gridExtent.x);
+		for (int dy = -1; dy <= 1; ++dy) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				glm::ivec2 next = local + glm::ivec2(dx, dy);
+				if (next.x < 0 || next.y < 0 || next.x >= gridExtent.x || next.y >= gridExtent.y) continue;
+
+				int nextIndex = next.y * gridExtent.x + next.x;
+				if (nearestWalkable[nextIndex] >= 0) {
+					seeds.push_back(nextIndex);
+				}
+			}
 		}
 	}
 
-	return closest;
+	PropagateNearest(seeds);
+}
+
+Node* PathfindingSystem::GetClosestNode(glm::vec2 worldPos) const {
+	if (cells.empty()) return nullptr;
+
+	// Positions outside the grid resolve through the nearest edge cell
+	glm::ivec2 local = glm::clamp(WorldToCell(worldPos) - gridMin, glm::ivec2(0), gridExtent - glm::ivec2(1));
+	int nearest = nearestWalkable[local.y * gridExtent.x + local.x];
+
+	return nearest >= 0 ? cells[nearest] : nullptr;
 }
 
 float PathfindingSystem::Heuristic(const Node* a, const Node* b) const {
 	return glm::distance(a->worldPos, b->worldPos);
 }
 
-std::vector<glm::vec2> PathfindingSystem::FindPath(glm::vec2 startWorld, glm::vec2 endWorld) {
+std::vector<glm::vec2> PathfindingSystem::FindPath(glm::vec2 startWorld, glm::vec2 endWorld, PathMode mode) {
 	Node* start = GetClosestNode(startWorld);
 	Node* goal = GetClosestNode(endWorld);
 
 	if (!start || !goal) return {};
 
+	PathCacheKey key{ start->gridPos, goal->gridPos, mode };
+	if (pathCacheCapacity > 0) {
+		auto it = pathCacheLookup.find(key);
+		if (it != pathCacheLookup.end()) {
+			if (IsCacheEntryValid(*it->second)) {
+				++cacheHits;
+				pathCache.splice(pathCache.begin(), pathCache, it->second);
+				return it->second->path;
+			}
+
+			++cacheInvalidations;
+			pathCache.erase(it->second);
+			pathCacheLookup.erase(it);
+		}
+		++cacheMisses;
+	}
+
+	std::vector<glm::vec2> path = SearchPath(start, goal);
+	if (mode != PathMode::Grid) {
+		path = SmoothPath(path, mode);
+	}
+
+	if (pathCacheCapacity > 0 && !path.empty()) {
+		StorePath(key, path);
+	}
+	return path;
+}
+
+std::vector<glm::vec2> PathfindingSystem::SearchPath(Node* start, Node* goal) const {
 	std::unordered_map<Node*, Node*> cameFrom;
 	std::unordered_map<Node*, float> costSoFar;
 
@@ -195,6 +826,8 @@ std::vector<glm::vec2> PathfindingSystem::FindPath(glm::vec2 startWorld, glm::ve
 	}
 
 	std::vector<glm::vec2> path;
+	if (!cameFrom.contains(goal)) return path; // unreachable
+
 	Node* step = goal;
 
 	while (step != nullptr) {
@@ -206,21 +839,304 @@ std::vector<glm::vec2> PathfindingSystem::FindPath(glm::vec2 startWorld, glm::ve
 	return path;
 }
 
-void PathfindingSystem::DrawDebug(const glm::mat4 projection) const {
+std::size_t PathfindingSystem::PathCacheKeyHash::operator()(const PathCacheKey& key) const noexcept {
+	std::size_t h = std::hash<glm::ivec2>()(key.start);
+	h ^= std::hash<glm::ivec2>()(key.goal) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= static_cast<std::size_t>(key.mode) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+}
+
+bool PathfindingSystem::IsCacheEntryValid(const PathCacheEntry& entry) const {
+	for (int y = entry.regionMin.y; y <= entry.regionMax.y; ++y) {
+		for (int x = entry.regionMin.x; x <= entry.regionMax.x; ++x) {
+			if (regionStamps[y * regionCount.x + x] > entry.stamp) return false;
+		}
+	}
+	return true;
+}
+
+void PathfindingSystem::StorePath(const PathCacheKey& key, const std::vector<glm::vec2>& path) {
+	// Edits next to the path can open shortcuts, so watch one extra region around it
+	glm::ivec2 cellMin = WorldToCell(path.front()) - gridMin;
+	glm::ivec2 cellMax = cellMin;
+	for (const glm::vec2& point : path) {
+		glm::ivec2 cell = WorldToCell(point) - gridMin;
+		cellMin = glm::min(cellMin, cell);
+		cellMax = glm::max(cellMax, cell);
+	}
+
+	PathCacheEntry entry;
+	entry.key = key;
+	entry.path = path;
+	entry.regionMin = glm::max(cellMin / CacheRegionSize - glm::ivec2(1), glm::ivec2(0));
+	entry.regionMax = glm::min(cellMax / CacheRegionSize + glm::ivec2(1), regionCount - glm::ivec2(1));
+	entry.stamp = editStamp;
+
+	pathCache.push_front(std::move(entry));
+	pathCacheLookup[key] = pathCache.begin();
+
+	while (static_cast<int>(pathCache.size()) > pathCacheCapacity) {
+		pathCacheLookup.erase(pathCache.back().key);
+		pathCache.pop_back();
+	}
+}
+
+void PathfindingSystem::ClearPathCache() {
+	pathCache.clear();
+	pathCacheLookup.clear();
+}
+
+// Supercover walk between two cells. Every cell the segment touches must be walkable,
+// and a segment passing exactly through a corner needs both side cells clear.
+bool PathfindingSystem::HasLineOfSight(glm::ivec2 from, glm::ivec2 to) const {
+	glm::ivec2 delta = to - from;
+	glm::ivec2 step(delta.x > 0 ? 1 : -1, delta.y > 0 ? 1 : -1);
+	int nx = std::abs(delta.x);
+	int ny = std::abs(delta.y);
+
+	glm::ivec2 cell = from;
+	if (!IsWalkable(cell)) return false;
+
+	for (int ix = 0, iy = 0; ix < nx || iy < ny;) {
+		int decision = (1 + 2 * ix) * ny - (1 + 2 * iy) * nx;
+		if (decision == 0) {
+			if (!IsWalkable(cell + glm::ivec2(step.x, 0)) || !IsWalkable(cell + glm::ivec2(0, step.y))) {
+				return false;
+			}
+			cell += step;
+			++ix;
+			++iy;
+		}
+		else if (decision < 0) {
+			cell.x += step.x;
+			++ix;
+		}
+		else {
+			cell.y += step.y;
+			++iy;
+		}
+
+		if (!IsWalkable(cell)) return false;
+	}
+	return true;
+}
+
+std::vector<glm::vec2> PathfindingSystem::SmoothPath(const std::vector<glm::vec2>& path, PathMode mode) const {
+	if (mode == PathMode::Grid || path.size() < 3) return path;
+
+	std::vector<glm::vec2> smoothed = StringPull(path);
+	if (mode == PathMode::Spline) {
+		return CatmullRom(smoothed);
+	}
+	return smoothed;
+}
+
+// Keeps only the waypoints where the line of sight from the previous kept waypoint breaks
+std::vector<glm::vec2> PathfindingSystem::StringPull(const std::vector<glm::vec2>& path) const {
+	std::vector<glm::vec2> result;
+	result.push_back(path.front());
+
+	size_t anchor = 0;
+	glm::ivec2 anchorCell = WorldToCell(path.front());
+	for (size_t i = 2; i < path.size(); ++i) {
+		if (!HasLineOfSight(anchorCell, WorldToCell(path[i]))) {
+			anchor = i - 1;
+			anchorCell = WorldToCell(path[anchor]);
+			result.push_back(path[anchor]);
+		}
+	}
+
+	result.push_back(path.back());
+	return result;
+}
+
+// Resamples roughly once per cell along a Catmull-Rom curve through the waypoints.
+// Spans whose curve would clip a blocked cell fall back to the straight segment. The cell walk alone
+// misses chords that cut across the corner of a blocked cell, so each chord is also tested exactly.
+std::vector<glm::vec2> PathfindingSystem::CatmullRom(const std::vector<glm::vec2>& points) const {
+	if (points.size() < 3) return points;
+
+	std::vector<glm::vec2> result;
+	result.push_back(points.front());
+
+	std::vector<glm::vec2> span;
+	for (size_t i = 0; i + 1 < points.size(); ++i) {
+		const glm::vec2& p0 = points[i > 0 ? i - 1 : i];
+		const glm::vec2& p1 = points[i];
+		const glm::vec2& p2 = points[i + 1];
+		const glm::vec2& p3 = points[i + 2 < points.size() ? i + 2 : i + 1];
+
+		int samples = std::max(1, static_cast<int>(std::ceil(glm::distance(p1, p2) / cellSize)));
+
+		span.clear();
+		bool clear = true;
+		glm::ivec2 previousCell = WorldToCell(p1);
+		glm::vec2 previousPoint = p1;
+		for (int s = 1; s <= samples && clear; ++s) {
+			float t = static_cast<float>(s) / samples;
+			float t2 = t * t;
+			float t3 = t2 * t;
+			glm::vec2 point = 0.5f * ((2.0f * p1) + (-p0 + p2) * t
+				+ (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+				+ (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+
+			if (s == samples) point = p2; // land exactly on the waypoint
+			glm::ivec2 cell = WorldToCell(point);
+			clear = HasLineOfSight(previousCell, cell) && !CrossesBlockedCell(previousPoint, point);
+			previousCell = cell;
+			previousPoint = point;
+			span.push_back(point);
+		}
+
+		if (clear) {
+			result.insert(result.end(), span.begin(), span.end());
+		}
+		else {
+			result.push_back(p2);
+		}
+	}
+
+	return result;
+}
+
+// Exact segment test against every blocked cell square near it, independent of the grid walk in
+// HasLineOfSight. The squares grow by a hair, so slipping through the corner point between two
+// diagonal blocked cells counts as a hit.
+bool PathfindingSystem::CrossesBlockedCell(glm::vec2 from, glm::vec2 to) const {
+	const glm::ivec2 low = glm::min(WorldToCell(from), WorldToCell(to)) - glm::ivec2(1);
+	const glm::ivec2 high = glm::max(WorldToCell(from), WorldToCell(to)) + glm::ivec2(1);
+	const float margin = cellSize * 1e-4f;
+	const glm::vec2 direction = to - from;
+
+	for (int y = low.y; y <= high.y; ++y) {
+		for (int x = low.x; x <= high.x; ++x) {
+			const glm::ivec2 cell(x, y);
+			if (IsWalkable(cell)) continue;
+
+			const glm::vec2 center = worldOrigin + glm::vec2(cell - gridMin) * cellSize;
+			const glm::vec2 boxMin = center - glm::vec2(0.5f * cellSize + margin);
+			const glm::vec2 boxMax = center + glm::vec2(0.5f * cellSize + margin);
+
+			float enter = 0.0f;
+			float exit = 1.0f;
+			bool separated = false;
+			for (int axis = 0; axis < 2 && !separated; ++axis) {
+				if (std::abs(direction[axis]) < 1e-9f) {
+					separated = from[axis] < boxMin[axis] || from[axis] > boxMax[axis];
+					continue;
+				}
+				float t0 = (boxMin[axis] - from[axis]) / direction[axis];
+				float t1 = (boxMax[axis] - from[axis]) / direction[axis];
+				if (t0 > t1) std::swap(t0, t1);
+				enter = std::max(enter, t0);
+				exit = std::min(exit, t1);
+				separated = enter > exit;
+			}
+			if (!separated) return true;
+		}
+	}
+	return false;
+}
+
+// Seeded random maps with scattered blocks and wall runs. Every smoothed and spline path must keep
+// the grid path's endpoints, keep line of sight on each segment and never clip a blocked cell.
+bool PathfindingSystem::RunSmoothingCheck() {
+	auto start = std::chrono::steady_clock::now();
+
+	PathfindingSystem check(renderer);
+	check.pathCacheCapacity = 0;
+	std::mt19937 rng(2024);
+	const float checkCellSize = 0.5f;
+	const glm::vec2 checkOrigin(-7.25f, 3.5f);
+
+	int paths = 0;
+	std::string failure;
+	for (int map = 0; map < SmoothingCheckMaps && failure.empty(); ++map) {
+		std::vector<uint8_t> blocked(SmoothingCheckWidth * SmoothingCheckHeight, 0);
+		for (uint8_t& cell : blocked) {
+			cell = rng() % 100 < 15;
+		}
+		for (int wall = 0; wall < 12; ++wall) {
+			const bool horizontal = rng() % 2 == 0;
+			const int length = 4 + static_cast<int>(rng() % 16);
+			int x = static_cast<int>(rng() % SmoothingCheckWidth);
+			int y = static_cast<int>(rng() % SmoothingCheckHeight);
+			for (int i = 0; i < length && x < SmoothingCheckWidth && y < SmoothingCheckHeight; ++i) {
+				blocked[y * SmoothingCheckWidth + x] = 1;
+				horizontal ? ++x : ++y;
+			}
+		}
+
+		std::vector<Node> nodes;
+		for (int y = 0; y < SmoothingCheckHeight; ++y) {
+			for (int x = 0; x < SmoothingCheckWidth; ++x) {
+				nodes.emplace_back(glm::ivec2(x, y), checkOrigin + glm::vec2(x, y) * checkCellSize,
+					blocked[y * SmoothingCheckWidth + x] == 0);
+			}
+		}
+		check.BuildNavGrid(nodes, checkCellSize);
+
+		for (int p = 0; p < SmoothingCheckPaths && failure.empty(); ++p) {
+			const glm::vec2 from = checkOrigin + glm::vec2(rng() % SmoothingCheckWidth, rng() % SmoothingCheckHeight) * checkCellSize;
+			const glm::vec2 to = checkOrigin + glm::vec2(rng() % SmoothingCheckWidth, rng() % SmoothingCheckHeight) * checkCellSize;
+			const std::vector<glm::vec2> grid = check.FindPath(from, to);
+			if (grid.size() < 2) continue;
+			++paths;
+
+			for (PathMode mode : { PathMode::Smoothed, PathMode::Spline }) {
+				const std::vector<glm::vec2> smoothed = check.SmoothPath(grid, mode);
+				const char* problem = nullptr;
+				if (smoothed.size() < 2 || smoothed.front() != grid.front() || smoothed.back() != grid.back()) {
+					problem = "moved an endpoint";
+				}
+				for (size_t i = 1; i < smoothed.size() && !problem; ++i) {
+					if (!check.HasLineOfSight(check.WorldToCell(smoothed[i - 1]), check.WorldToCell(smoothed[i]))) {
+						problem = "lost line of sight";
+					}
+					else if (check.CrossesBlockedCell(smoothed[i - 1], smoothed[i])) {
+						problem = "cut a blocked corner";
+					}
+				}
+				if (problem) {
+					char buffer[128];
+					snprintf(buffer, sizeof(buffer), "Map %d path %d (%s) %s", map, p,
+						mode == PathMode::Spline ? "spline" : "smoothed", problem);
+					failure = buffer;
+					break;
+				}
+			}
+		}
+	}
+
+	char buffer[160];
+	if (failure.empty()) {
+		snprintf(buffer, sizeof(buffer), "Passed: %d paths on %d maps (%.1f ms)", paths, SmoothingCheckMaps,
+			MillisecondsSince(start));
+	}
+	else {
+		snprintf(buffer, sizeof(buffer), "Failed: %s", failure.c_str());
+	}
+	smoothingResult = buffer;
+	return failure.empty();
+}
+
+void PathfindingSystem::DrawDebug(const glm::mat4& projection) const {
+	if (!renderer.GetDebugDraw().IsEnabled(DebugCategory::NavGrid)) return;
+
 	for (const auto& pair : gridMap) {
 		const glm::ivec2& gridPos = pair.first;
 		const Node* node = pair.second;
 
-		glm::vec2 worldPos = glm::vec2(gridPos);
+		// Nodes sit on lattice points, the inverse of WorldToCell
+		glm::vec2 worldPos = worldOrigin + glm::vec2(gridPos - gridMin) * cellSize;
 		glm::vec4 color;
 
-		// Color based on walkability or node state (you can expand this)
 		if (node->walkable)
 			color = glm::vec4(0.2f, 0.8f, 0.2f, 0.5f); // Green
 		else
 			color = glm::vec4(0.8f, 0.2f, 0.2f, 0.5f); // Red
 
-		// Draw a unit-size square at node center
-		renderer.DebugDrawRect(worldPos + glm::vec2(0.5f), 1.0f, color);
+		// One cell-sized square centered on the node
+		renderer.GetDebugDraw().Rect(DebugCategory::NavGrid, worldPos, glm::vec2(cellSize), color);
 	}
 }
\ No newline at end of file
@@ -2,10 +2,12 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <queue>
+#include <list>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include "SceneSystem.h"
+#include "PhysicsTypes.h"
 
 struct Node {
 	glm::ivec2 gridPos;
@@ -27,6 +29,13 @@ namespace std {
 	};
 }
 
+//Post-processing applied to a grid path
+enum class PathMode {
+	Grid,     // every node along the A* result
+	Smoothed, // string-pulled to the corners that need them
+	Spline    // smoothed, then resampled along a Catmull-Rom curve
+};
+
 class PathfindingSystem : public SceneSystem {
 public:
 	PathfindingSystem(DelusiveRenderer&);
@@ -34,23 +43,139 @@ public:
 	void RegisterProperties() override;
 	std::string GetType() const override { return "PathfindingSystem"; }
 
-	void BuildNavGrid(const std::vector<Node>&);
-	std::vector<glm::vec2> FindPath(glm::vec2, glm::vec2);
+	void BuildNavGrid(const std::vector<Node>&, float cellSize = 1.0f);
+	std::vector<glm::vec2> FindPath(glm::vec2, glm::vec2, PathMode mode = PathMode::Grid);
+
+	//Line-of-sight string pulling over the walkability grid, optionally followed by spline resampling
+	std::vector<glm::vec2> SmoothPath(const std::vector<glm::vec2>&, PathMode) const;
+	bool HasLineOfSight(glm::ivec2, glm::ivec2) const;
+	//Smooths paths on seeded generated maps and checks endpoints, line of sight and corner clearance.
+	//Returns true when every path passed; the summary is shown under Path Smoothing in the inspector.
+	bool RunSmoothingCheck();
+
+	//Walkability editing keeps neighbor links and the nearest-walkable table in sync
+	void SetWalkable(glm::ivec2, bool);
+	bool IsWalkable(glm::ivec2) const;
+	glm::ivec2 WorldToCell(glm::vec2) const;
 
-	//TODO: Implement later as needed
-	void Update(float) override {};
+	//Walkability baked from the SolidColliders of EnvironmentAgents.
+	//Baking overwrites hand-painted walkability inside the baked area.
+	void BakeFromColliders();
+	bool RebakeEdited();  // re-bakes around the agents the scene reported as edited or removed
+	bool RebakeChanged(); // compares every environment collider against the last bake
+	void SetAgentRadius(float radius) { agentRadius = radius; }
+	void ClearPathCache();
+	float GetAgentRadius() const { return agentRadius; }
+
+	void Update(float) override;
+	void OnAgentEdited(Agent&) override;
+	void OnAgentRemoved(Agent&) override;
 	void Draw(const glm::mat4&) override {};
 	void Reset() override {};
 	void DrawImGui() override;
 
 	std::unique_ptr<SceneSystem> Clone() const override;
 
-	void DrawDebug(const glm::mat4 projection) const;
+	void Serialize(std::ostream&) const override;
+	void Deserialize(std::istream&) override;
+
+	void DrawDebug(const glm::mat4& projection) const override;
 
 private:
 	std::unordered_map<glm::ivec2, Node*> gridMap;
 	std::vector<std::unique_ptr<Node>>  allNodes;
 
+	//Dense lookup over the bounding rectangle of the grid
+	glm::ivec2 gridMin = { 0, 0 };
+	glm::ivec2 gridExtent = { 0, 0 };
+	glm::vec2 worldOrigin = { 0.0f, 0.0f }; // world position of gridMin
+	float cellSize = 1.0f;
+	std::vector<Node*> cells;               // nullptr where the rectangle has no node
+	std::vector<int> nearestWalkable;       // cell index of the closest walkable cell, -1 if none
+	std::vector<int> walkableDistance;      // chamfer distance to nearestWalkable
+
+	//LRU cache of path results keyed by resolved start/goal cell and mode.
+	//Entries remember the regions around their path and go stale once any of them is edited.
+	static constexpr int CacheRegionSize = 16;
+
+	struct PathCacheKey {
+		glm::ivec2 start;
+		glm::ivec2 goal;
+		PathMode mode;
+
+		bool operator==(const PathCacheKey&) const = default;
+	};
+
+	struct PathCacheKeyHash {
+		std::size_t operator()(const PathCacheKey&) const noexcept;
+	};
+
+	struct PathCacheEntry {
+		PathCacheKey key;
+		std::vector<glm::vec2> path;
+		glm::ivec2 regionMin;
+		glm::ivec2 regionMax;
+		uint32_t stamp;
+	};
+
+	int pathCacheCapacity = 256;
+	std::list<PathCacheEntry> pathCache; // most recently used first
+	std::unordered_map<PathCacheKey, std::list<PathCacheEntry>::iterator, PathCacheKeyHash> pathCacheLookup;
+	std::vector<uint32_t> regionStamps;  // edit stamp of the last walkability change per region
+	glm::ivec2 regionCount = { 0, 0 };
+	uint32_t editStamp = 0;
+	uint64_t cacheHits = 0;
+	uint64_t cacheMisses = 0;
+	uint64_t cacheInvalidations = 0;
+
+	bool IsCacheEntryValid(const PathCacheEntry&) const;
+	void StorePath(const PathCacheKey&, const std::vector<glm::vec2>&);
+
+	//World-space collider geometry as seen by the last bake
+	struct BakedShape {
+		ShapeType shape;
+		glm::vec2 a;        // box min, circle center or segment start
+		glm::vec2 b;        // box max or segment end
+		float radius = 0.0f;
+
+		bool operator<(const BakedShape&) const;
+		bool operator==(const BakedShape&) const;
+	};
+
+	float agentRadius = 0.0f;
+	bool autoRebake = true;
+	std::unordered_map<const Agent*, std::vector<BakedShape>> bakedShapes; // sorted, per environment agent
+	bool bakedShapesValid = false;          // false until a bake or the first sync after loading
+	std::unordered_set<Agent*> editedAgents; // reported by the scene, waiting for RebakeEdited
+	std::vector<BakedShape> removedShapes;  // of agents removed since the last rebake
+	float lastBakeMs = 0.0f;
+	int lastBakeCells = 0;
+
+	//Serialized mirror of the grid, refreshed by Serialize
+	mutable glm::vec2 savedOrigin = { 0.0f, 0.0f };
+	mutable std::vector<int> savedBounds;  // min x, min y, width, height
+	mutable std::vector<int> savedCells;   // 2 bits per cell: 0 none, 1 walkable, 2 blocked
+
+	static std::vector<BakedShape> CollectShapes(Agent&);
+	std::unordered_map<const Agent*, std::vector<BakedShape>> CollectAllShapes();
+	void SnapshotShapes();
+	int RebakeShapes(const std::vector<BakedShape>& changed); // returns cells changed
+	int BakeRegion(glm::ivec2 regionMin, glm::ivec2 regionMax, const std::vector<BakedShape>&); // returns cells changed
+	bool ShapeCellRange(const BakedShape&, glm::ivec2& outMin, glm::ivec2& outMax) const;
+
+	int CellIndex(glm::ivec2) const;
+	void RebuildLookup();
+	void LinkNeighbors(Node*);
+	void PropagateNearest(const std::vector<int>& seeds);
+
+	std::string smoothingResult;
+
+	std::vector<glm::vec2> StringPull(const std::vector<glm::vec2>&) const;
+	std::vector<glm::vec2> CatmullRom(const std::vector<glm::vec2>&) const;
+	bool CrossesBlockedCell(glm::vec2 from, glm::vec2 to) const;
+
+	std::vector<glm::vec2> SearchPath(Node* start, Node* goal) const;
+
 	Node* GetClosestNode(glm::vec2) const;
 	float Heuristic(const Node* a, const Node* b) const;
 };
\ No newline at end of file
@@ -1,43 +1,1143 @@
 #include "PhysicsSystem.h"
 #include "DelusiveComponents.h"
+#include "DelusiveUtils.h"
+#include "EnvironmentAgent.h"
+#include "EnemyAgent.h"
+#include "JobSystem.h"
+#include "RigidbodyComponent.h"
+#include "ShapeCast.h"
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <imgui/imgui.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
 
-void PhysicsSystem::HandleCollisions(const std::vector<std::unique_ptr<Agent>>& agents) {
-	for (size_t i = 0; i < agents.size(); ++i) {
-		auto* agentA = agents[i].get();
-		auto collidersA = agentA->GetComponentsOfType<ColliderComponent>();
-
-		for (auto* colA : collidersA) {
-			for (size_t j = i + 1; j < agents.size(); ++j) {
-				auto* agentB = agents[j].get();
-				auto collidersB = agentB->GetComponentsOfType<ColliderComponent>();
-
-				for (auto* colB : collidersB) {
-					if (colA->GetOwner() == colB->GetOwner()) continue;
-					//printf("A type: %d, B type: %d\n", colA->GetColliderType(), colB->GetColliderType());
-
-					bool isHit =
-						(colA->GetColliderType() == ColliderType::Hitbox && colB->GetColliderType() == ColliderType::Hurtbox)
-						|| (colA->GetColliderType() == ColliderType::Hurtbox && colB->GetColliderType() == ColliderType::Hitbox)
-						|| (colA->GetColliderType() == ColliderType::Solid && (colB->GetColliderType() == ColliderType::Solid || colB->GetColliderType() == ColliderType::Trigger))
-						|| (colA->GetColliderType() == ColliderType::Trigger && colB->GetColliderType() == ColliderType::Solid)
-						;
-
- 					if (isHit && CheckAABBCollision(colA, colB)) {
-						//Notify
-						colA->OnCollision(colB);
-						colB->OnCollision(colA);
-
-						if (colA->GetColliderType() == ColliderType::Solid) {
-							ResolveSolidCollision(colA, colB);
-						}
-						else if (colB->GetColliderType() == ColliderType::Solid) {
-							ResolveSolidCollision(colB, colA);
-						}
-					}
+namespace {
+	constexpr float PointQueryTolerance = 0.01f;
+	constexpr int BroadphaseGrain = 128;  // colliders per job chunk
+	constexpr int NarrowphaseGrain = 512; // pairs per job chunk
+	constexpr int MaxSweepIterations = 3; // slides after a time of impact
+	constexpr float SweepSkin = 0.005f;   // gap left in front of a surface after a sweep
+	constexpr int DeterminismAgents = 240;
+	constexpr int DeterminismSteps = 300;
+
+	// Stands in for std::uniform_real_distribution, whose output differs between standard libraries
+	float UnitHash(uint32_t seed) {
+		seed = (seed ^ 61u) ^ (seed >> 16);
+		seed *= 9u;
+		seed ^= seed >> 4;
+		seed *= 0x27d4eb2du;
+		seed ^= seed >> 15;
+		return static_cast<float>(seed & 0xFFFFFFu) / static_cast<float>(0x1000000);
+	}
+
+	// Four walls around a 30 unit arena followed by bouncing boxes and circles, all derived from the index
+	std::unique_ptr<Agent> MakeDeterminismAgent(int index) {
+		const float arena = 30.0f;
+		std::unique_ptr<Agent> agent;
+		ColliderComponent* collider = nullptr;
+
+		if (index < 4) {
+			agent = std::make_unique<EnvironmentAgent>("Wall");
+			collider = agent->AddComponent<SolidCollider>();
+			bool vertical = index >= 2;
+			float side = (index % 2) ? arena : 0.0f;
+			agent->transform.position = vertical ? glm::vec2(side, 0.5f * arena) : glm::vec2(0.5f * arena, side);
+			collider->transform.scale = vertical ? glm::vec2(1.0f, arena + 1.0f) : glm::vec2(arena + 1.0f, 1.0f);
+		}
+		else {
+			auto random = [index](uint32_t salt) { return UnitHash(static_cast<uint32_t>(index) * 7919u + salt); };
+			agent = std::make_unique<EnemyAgent>("Body");
+			collider = agent->AddComponent<SolidCollider>();
+			collider->SetShapeType(index % 2 ? ShapeType::Circle : ShapeType::Box);
+			collider->transform.scale = glm::vec2(0.5f + 0.7f * random(1), 0.5f + 0.7f * random(2));
+			agent->transform.position = glm::vec2(2.0f + (arena - 4.0f) * random(3), 2.0f + (arena - 4.0f) * random(4));
+			agent->transform.rotation = 6.2831853f * random(5);
+
+			RigidbodyComponent* body = agent->AddComponent<RigidbodyComponent>();
+			body->SetMass(0.5f + 1.5f * random(6));
+			body->SetRestitution(0.3f);
+			body->SetLinearDamping(0.1f);
+			body->SetVelocity(glm::vec2(12.0f * random(7) - 6.0f, 12.0f * random(8) - 6.0f));
+		}
+
+		agent->SetID(static_cast<uint64_t>(index) + 1);
+		return agent;
+	}
+
+	glm::vec2 ZoneCenter(const Zone& zone) {
+		return 0.5f * (zone.min + zone.max);
+	}
+
+	bool Ccw(glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+		return (c.y - a.y) * (b.x - a.x) > (b.y - a.y) * (c.x - a.x);
+	}
+
+	bool SegmentsIntersect(glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d) {
+		return (Ccw(a, c, d) != Ccw(b, c, d)) && (Ccw(a, b, c) != Ccw(a, b, d));
+	}
+
+	bool PointInZone(glm::vec2 point, const Zone& zone) {
+		return point.x >= zone.min.x && point.x <= zone.max.x && point.y >= zone.min.y && point.y <= zone.max.y;
+	}
+
+	ColliderData Translated(ColliderData data, glm::vec2 offset) {
+		data.bounds.min += offset;
+		data.bounds.max += offset;
+		data.center += offset;
+		data.end += offset;
+		return data;
+	}
+
+	// Distance b has to move along axis (or against it) to leave a, keeping the shallowest axis seen
+	bool OverlapAxis(glm::vec2 axis, float minA, float maxA, float minB, float maxB, glm::vec2& normal, float& depth) {
+		float forward = maxA - minB;
+		float backward = maxB - minA;
+		if (forward <= 0.0f || backward <= 0.0f) return false;
+
+		float overlap = std::min(forward, backward);
+		if (overlap < depth) {
+			depth = overlap;
+			normal = forward < backward ? axis : -axis;
+		}
+		return true;
+	}
+
+	bool BoxBoxManifold(const Zone& a, const Zone& b, glm::vec2& normal, float& depth) {
+		depth = FLT_MAX;
+		return OverlapAxis({ 1.0f, 0.0f }, a.min.x, a.max.x, b.min.x, b.max.x, normal, depth) &&
+			OverlapAxis({ 0.0f, 1.0f }, a.min.y, a.max.y, b.min.y, b.max.y, normal, depth);
+	}
+
+	bool CircleCircleManifold(glm::vec2 centerA, float radiusA, glm::vec2 centerB, float radiusB, glm::vec2& normal, float& depth) {
+		glm::vec2 delta = centerB - centerA;
+		float distance = glm::length(delta);
+		depth = radiusA + radiusB - distance;
+		if (depth <= 0.0f) return false;
+		normal = distance > 0.0f ? delta / distance : glm::vec2(0.0f, 1.0f);
+		return true;
+	}
+
+	bool BoxCircleManifold(const Zone& box, glm::vec2 center, float radius, glm::vec2& normal, float& depth) {
+		glm::vec2 closest = glm::clamp(center, box.min, box.max);
+		glm::vec2 delta = center - closest;
+		float distanceSq = glm::length2(delta);
+
+		// Center inside the box: push out through the nearest side
+		if (distanceSq == 0.0f) {
+			depth = FLT_MAX;
+			return OverlapAxis({ 1.0f, 0.0f }, box.min.x, box.max.x, center.x - radius, center.x + radius, normal, depth) &&
+				OverlapAxis({ 0.0f, 1.0f }, box.min.y, box.max.y, center.y - radius, center.y + radius, normal, depth);
+		}
+
+		float distance = std::sqrt(distanceSq);
+		depth = radius - distance;
+		if (depth <= 0.0f) return false;
+		normal = delta / distance;
+		return true;
+	}
+
+	bool SegmentCircleManifold(glm::vec2 start, glm::vec2 end, glm::vec2 center, float radius, glm::vec2& normal, float& depth) {
+		glm::vec2 segment = end - start;
+		float lengthSq = glm::dot(segment, segment);
+		float t = lengthSq > 0.0f ? glm::clamp(glm::dot(center - start, segment) / lengthSq, 0.0f, 1.0f) : 0.0f;
+		glm::vec2 delta = center - (start + segment * t);
+		float distance = glm::length(delta);
+
+		depth = radius - distance;
+		if (depth <= 0.0f) return false;
+		if (distance > 0.0f) normal = delta / distance;
+		else if (lengthSq > 0.0f) normal = glm::normalize(glm::vec2(-segment.y, segment.x));
+		else normal = glm::vec2(0.0f, 1.0f);
+		return true;
+	}
+
+	// Separating axes are the box axes and the segment's normal
+	bool SegmentBoxManifold(glm::vec2 start, glm::vec2 end, const Zone& box, glm::vec2& normal, float& depth) {
+		depth = FLT_MAX;
+		if (!OverlapAxis({ 1.0f, 0.0f }, std::min(start.x, end.x), std::max(start.x, end.x), box.min.x, box.max.x, normal, depth) ||
+			!OverlapAxis({ 0.0f, 1.0f }, std::min(start.y, end.y), std::max(start.y, end.y), box.min.y, box.max.y, normal, depth)) {
+			return false;
+		}
+
+		glm::vec2 segment = end - start;
+		if (glm::length2(segment) == 0.0f) return true;
+
+		glm::vec2 axis = glm::normalize(glm::vec2(-segment.y, segment.x));
+		float offset = glm::dot(axis, start);
+		glm::vec2 halfSize = 0.5f * (box.max - box.min);
+		float boxCenter = glm::dot(axis, ZoneCenter(box));
+		float boxExtent = std::abs(axis.x) * halfSize.x + std::abs(axis.y) * halfSize.y;
+		return OverlapAxis(axis, offset, offset, boxCenter - boxExtent, boxCenter + boxExtent, normal, depth);
+	}
+}
+
+void PhysicsSystem::Clear() {
+	staticTree.Clear();
+	dynamicTree.Clear();
+	agentTree.Clear();
+	proxies.clear();
+	agentProxies.clear();
+	colliders.clear();
+	pairs.clear();
+	contacts.Clear();
+	contactEvents.Clear();
+	solver.Reset();
+	bodyIndices.clear();
+	layers.Reset();
+}
+
+void PhysicsSystem::HandleCollisions(const std::vector<std::unique_ptr<Agent>>& agents, float deltaTime) {
+	GatherBodies(agents);
+	SyncColliders(agents);
+	for (ColliderData& data : colliders) {
+		auto it = bodyIndices.find(data.owner);
+		if (it == bodyIndices.end()) continue;
+		data.body = it->second;
+		data.sleeping = !solver.IsAwake(data.body);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	BuildPairs();
+	lastBroadphaseMs = MillisecondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	RunNarrowphase();
+	lastNarrowphaseMs = MillisecondsSince(start);
+
+	++step;
+	beginCount = 0;
+	endCount = 0;
+
+	// Contacts and resolution stay on this thread, in pair order, so results never depend on thread count
+	for (int hit : hits) {
+		const ColliderData& a = colliders[pairs[hit].first];
+		const ColliderData& b = colliders[pairs[hit].second];
+
+		// New touches and any solid contact wake a sleeping body, the pair only exists if the other side is active
+		ContactPhase phase = UpdateContact(a, b);
+		if (phase == ContactPhase::Begin || (a.type == ColliderType::Solid && b.type == ColliderType::Solid)) {
+			solver.Wake(a.body);
+			solver.Wake(b.body);
+		}
+		ResolveSolids(a, b);
+	}
+
+	// Every body moves in the same pass, once the contacts of this step are known
+	solver.IntegrateVelocities(deltaTime);
+	solver.SolveVelocities(velocityIterations);
+	solver.IntegratePositions(deltaTime);
+	solver.SolvePositions(positionIterations);
+	solver.UpdateSleep(deltaTime);
+	solver.WriteBack();
+
+	EndStaleContacts();
+	SolveContinuous(agents);
+	StoreSweepStarts();
+
+	if (deterministic) {
+		stepChecksum = ComputeChecksum(agents);
+	}
+}
+
+const std::vector<Agent*>& PhysicsSystem::OrderAgents(const std::vector<std::unique_ptr<Agent>>& agents) {
+	agentOrder.clear();
+	for (const auto& agent : agents) {
+		if (agent) agentOrder.push_back(agent.get());
+	}
+
+	// IDs survive saving, loading and replays, the order agents were added in does not
+	if (deterministic) {
+		std::stable_sort(agentOrder.begin(), agentOrder.end(), [](const Agent* a, const Agent* b) {
+			return a->GetID() < b->GetID();
+		});
+	}
+	return agentOrder;
+}
+
+uint64_t PhysicsSystem::ComputeChecksum(const std::vector<std::unique_ptr<Agent>>& agents) {
+	uint64_t hash = FnvOffset;
+
+	for (Agent* agent : OrderAgents(agents)) {
+		const Transform& transform = agent->GetTransform();
+		HashValue(hash, agent->GetID());
+		HashValue(hash, transform.position);
+		HashValue(hash, transform.rotation);
+
+		if (RigidbodyComponent* body = agent->GetComponentOfType<RigidbodyComponent>()) {
+			HashValue(hash, body->GetVelocity());
+			HashValue(hash, body->IsAwake());
+		}
+	}
+	HashValue(hash, static_cast<uint32_t>(contacts.GetContacts().size()));
+	return hash;
+}
+
+bool PhysicsSystem::RunDeterminismCheck() {
+	auto run = [](bool shuffled, std::vector<uint64_t>& checksums) {
+		std::vector<int> order(DeterminismAgents);
+		std::iota(order.begin(), order.end(), 0);
+		if (shuffled) {
+			std::shuffle(order.begin(), order.end(), std::mt19937(2024));
+		}
+
+		std::vector<std::unique_ptr<Agent>> agents;
+		for (int index : order) {
+			agents.push_back(MakeDeterminismAgent(index));
+		}
+
+		PhysicsSystem physics;
+		physics.deterministic = true;
+		for (int s = 0; s < DeterminismSteps; ++s) {
+			physics.HandleCollisions(agents, 1.0f / 60.0f);
+			physics.contactEvents.Clear(); // nobody listens to the synthetic scene
+			checksums.push_back(physics.stepChecksum);
+		}
+	};
+
+	std::vector<uint64_t> ordered, shuffled;
+	run(false, ordered);
+	run(true, shuffled);
+
+	auto mismatch = std::mismatch(ordered.begin(), ordered.end(), shuffled.begin());
+	char buffer[128];
+	if (mismatch.first == ordered.end()) {
+		snprintf(buffer, sizeof(buffer), "Identical over %d steps (%016llx)", DeterminismSteps,
+			static_cast<unsigned long long>(ordered.back()));
+	}
+	else {
+		snprintf(buffer, sizeof(buffer), "Diverged at step %d", static_cast<int>(mismatch.first - ordered.begin()));
+	}
+	determinismResult = buffer;
+	return mismatch.first == ordered.end();
+}
+
+void PhysicsSystem::GatherBodies(const std::vector<std::unique_ptr<Agent>>& agents) {
+	solver.Reset();
+	bodyIndices.clear();
+
+	for (Agent* agent : OrderAgents(agents)) {
+		if (dynamic_cast<EnvironmentAgent*>(agent)) continue;
+
+		RigidbodyComponent* body = agent->GetComponentOfType<RigidbodyComponent>();
+		if (!body || !body->IsEnabled()) continue;
+		bodyIndices[agent] = solver.AddBody(body, agent);
+	}
+}
+
+void PhysicsSystem::ResolveSolids(const ColliderData& a, const ColliderData& b) {
+	bool aSolid = a.type == ColliderType::Solid;
+	bool bSolid = b.type == ColliderType::Solid;
+
+	// Solids touching a body become solver contacts. A side without a body is immovable to the solver.
+	if (aSolid && bSolid && (a.body != RigidbodySolver::WorldBody || b.body != RigidbodySolver::WorldBody)) {
+		glm::vec2 normal;
+		float depth;
+		if (ComputeManifold(a, b, normal, depth)) {
+			solver.AddContact(a.body, b.body, normal, depth);
+		}
+		return;
+	}
+
+	// Static geometry never gets pushed, and bodies only move through the solver
+	if (aSolid && bSolid) {
+		if (a.isStatic) ResolveSolidCollision(b.collider, a.collider);
+		else ResolveSolidCollision(a.collider, b.collider);
+	}
+	else if (aSolid) {
+		if (!a.isStatic && a.body == RigidbodySolver::WorldBody) ResolveSolidCollision(a.collider, b.collider);
+	}
+	else if (bSolid) {
+		if (!b.isStatic && b.body == RigidbodySolver::WorldBody) ResolveSolidCollision(b.collider, a.collider);
+	}
+}
+
+// Continuous colliders are swept from where the last step left them to where the agent moved
+// this tick, against static solids. Only flagged colliders that moved far enough pay for it.
+void PhysicsSystem::SolveContinuous(const std::vector<std::unique_ptr<Agent>>& agents) {
+	continuousSweeps = 0;
+	continuousHits = 0;
+
+	for (Agent* agent : OrderAgents(agents)) {
+		if (dynamic_cast<EnvironmentAgent*>(agent)) continue;
+
+		for (ColliderComponent* collider : agent->GetColliders()) {
+			if (!collider->IsEnabled() || !collider->IsContinuous() || collider->GetColliderType() != ColliderType::Solid) continue;
+
+			auto it = proxies.find(collider);
+			if (it == proxies.end() || !it->second.hasSweepStart) continue;
+
+			ColliderData current = BuildColliderData(collider, false);
+			glm::vec2 motion = ZoneCenter(current.bounds) - it->second.sweepStart;
+
+			// The discrete test already catches anything that moved less than a quarter of its size
+			glm::vec2 size = current.bounds.max - current.bounds.min;
+			float threshold = 0.25f * std::min(size.x, size.y);
+			if (glm::length2(motion) <= threshold * threshold) continue;
+
+			++continuousSweeps;
+			glm::vec2 travelled = SweepStatic(Translated(current, -motion), motion);
+			if (travelled != motion) {
+				agent->transform.position += travelled - motion;
+				++continuousHits;
+			}
+		}
+	}
+}
+
+// Moves as far as possible along motion, sliding along whatever gets hit first
+glm::vec2 PhysicsSystem::SweepStatic(const ColliderData& moving, glm::vec2 motion) const {
+	glm::vec2 travelled(0.0f);
+	glm::vec2 remaining = motion;
+
+	for (int iteration = 0; iteration < MaxSweepIterations; ++iteration) {
+		float length = glm::length(remaining);
+		if (length < 1e-6f) break;
+
+		ColliderData shape = Translated(moving, travelled);
+		Zone swept = DynamicAABBTree::Combine(shape.bounds, { shape.bounds.min + remaining, shape.bounds.max + remaining });
+
+		float toi = 1.0f;
+		glm::vec2 normal(0.0f);
+		staticTree.Query(swept, [&](int proxyID) {
+			const ColliderData& target = colliders[static_cast<const ProxyRecord*>(staticTree.GetUserData(proxyID))->dataIndex];
+			if (target.type != ColliderType::Solid || !ShouldCollide(shape, target)) return true;
+
+			float t;
+			glm::vec2 n;
+			if (ShapeCast::Sweep(shape, remaining, target, t, n) && t < toi) {
+				toi = t;
+				normal = n;
+			}
+			return true;
+		});
+
+		if (toi >= 1.0f) {
+			travelled += remaining;
+			break;
+		}
+
+		// Stop just short of the surface, then keep the tangential part of what is left
+		float safe = std::max(0.0f, toi - SweepSkin / length);
+		travelled += remaining * safe;
+		remaining *= 1.0f - safe;
+		remaining -= glm::dot(remaining, normal) * normal;
+	}
+	return travelled;
+}
+
+void PhysicsSystem::StoreSweepStarts() {
+	for (const ColliderData& data : colliders) {
+		if (!data.continuous || data.isStatic) continue;
+
+		ProxyRecord& record = proxies[data.collider];
+		record.sweepStart = ZoneCenter(BuildColliderData(data.collider, false).bounds);
+		record.hasSweepStart = true;
+	}
+}
+
+ContactPhase PhysicsSystem::UpdateContact(const ColliderData& a, const ColliderData& b) {
+	uint64_t key = ContactTable::MakeKey(a.id, b.id);
+	Contact* contact = contacts.Find(key);
+	ContactPhase phase = ContactPhase::Stay;
+
+	if (!contact) {
+		contact = &contacts.Insert(key);
+		contact->a = a.collider;
+		contact->b = b.collider;
+		contact->idA = a.id;
+		contact->idB = b.id;
+		contact->agentA = a.owner->GetID();
+		contact->agentB = b.owner->GetID();
+		contact->layerA = a.layer;
+		contact->layerB = b.layer;
+		phase = ContactPhase::Begin;
+		++beginCount;
+	}
+
+	contact->lastStep = step;
+	contact->stayA = a.wantsStay;
+	contact->stayB = b.wantsStay;
+	// Most pairs only care about Begin and End, so resting contacts queue nothing
+	if (phase == ContactPhase::Begin || contact->stayA || contact->stayB) {
+		contactEvents.Push({ phase, *contact });
+	}
+	return phase;
+}
+
+// Contacts not refreshed this step have separated or lost a collider
+void PhysicsSystem::EndStaleContacts() {
+	auto& active = contacts.GetContacts();
+
+	// Backwards so the swap-remove only moves contacts already visited
+	for (int i = static_cast<int>(active.size()) - 1; i >= 0; --i) {
+		Contact& contact = active[i];
+		if (contact.lastStep == step) continue;
+
+		// Pairs between sleeping bodies and static geometry were never tested, they still touch
+		if (IsInactive(contact.a, contact.idA) && IsInactive(contact.b, contact.idB)) {
+			contact.lastStep = step;
+			continue;
+		}
+
+		ContactEvent event{ ContactPhase::End, contact };
+		event.removedA = !IsAlive(contact.a, contact.idA);
+		event.removedB = !IsAlive(contact.b, contact.idB);
+		contactEvents.Push(event);
+		++endCount;
+
+		contacts.Remove(i);
+	}
+}
+
+bool PhysicsSystem::IsAlive(ColliderComponent* collider, uint32_t colliderID) const {
+	auto it = proxies.find(collider);
+	return it != proxies.end() && it->second.colliderID == colliderID;
+}
+
+bool PhysicsSystem::IsInactive(ColliderComponent* collider, uint32_t colliderID) const {
+	auto it = proxies.find(collider);
+	if (it == proxies.end() || it->second.colliderID != colliderID) return false;
+
+	// Uses the flag from the sync, which is what decided whether the pair was tested
+	const ColliderData& data = colliders[it->second.dataIndex];
+	return data.isStatic || data.sleeping;
+}
+
+void PhysicsSystem::DispatchContacts() {
+	// Each agent's scripts are looked up once per dispatch rather than once per event.
+	// Agents can gain or lose scripts between steps, so nothing is kept across dispatches.
+	dispatchScripts.clear();
+	auto scriptsOf = [this](Agent* agent) -> const std::vector<ScriptComponent*>& {
+		auto [it, inserted] = dispatchScripts.try_emplace(agent);
+		if (inserted) it->second = agent->GetComponentsOfType<ScriptComponent>();
+		return it->second;
+	};
+
+	ContactEvent event;
+	while (contactEvents.Pop(event)) {
+		const Contact& contact = event.contact;
+
+		auto deliver = [&](ColliderComponent* self, bool selfRemoved, bool selfStay, ColliderComponent* other,
+			bool otherRemoved, uint64_t otherAgent, int selfLayer, int otherLayer) {
+			if (selfRemoved || (event.phase == ContactPhase::Stay && !selfStay)) return;
+
+			self->OnContact(event.phase, otherRemoved ? nullptr : other);
+
+			ContactInfo info;
+			info.phase = event.phase;
+			info.otherAgentID = otherAgent;
+			info.selfLayer = selfLayer;
+			info.otherLayer = otherLayer;
+			info.otherRemoved = otherRemoved;
+			for (ScriptComponent* script : scriptsOf(self->GetOwner())) {
+				script->OnContact(info);
+			}
+		};
+
+		deliver(contact.a, event.removedA, contact.stayA, contact.b, event.removedB, contact.agentB, contact.layerA, contact.layerB);
+		deliver(contact.b, event.removedB, contact.stayB, contact.a, event.removedA, contact.agentA, contact.layerB, contact.layerA);
+	}
+}
+
+ColliderData PhysicsSystem::BuildColliderData(ColliderComponent* collider, bool isStatic) const {
+	ColliderData data;
+	data.collider = collider;
+	data.owner = collider->GetOwner();
+	data.type = collider->GetColliderType();
+	data.shape = collider->GetShapeType();
+	data.bounds = { collider->GetMin(), collider->GetMax() };
+	data.isStatic = isStatic;
+	data.continuous = collider->IsContinuous();
+	data.wantsStay = collider->WantsStayEvents();
+
+	int layer = collider->GetLayer();
+	data.layer = layer;
+	data.category = 1u << layer;
+	data.mask = layers.masks[layer] & collider->GetCollisionMask();
+
+	if (data.shape == ShapeType::Circle) {
+		collider->GetWorldCircle(data.center, data.radius);
+		data.bounds = { data.center - glm::vec2(data.radius), data.center + glm::vec2(data.radius) };
+	}
+	else if (data.shape == ShapeType::Line) {
+		collider->GetWorldSegment(data.center, data.end);
+		data.bounds = { glm::min(data.center, data.end), glm::max(data.center, data.end) };
+	}
+	else {
+		data.center = ZoneCenter(data.bounds);
+	}
+	return data;
+}
+
+void PhysicsSystem::SyncColliders(const std::vector<std::unique_ptr<Agent>>& agents) {
+	++colliderFrame;
+	colliders.clear();
+	staticCategories = 0;
+	dynamicCategories = 0;
+
+	for (Agent* agent : OrderAgents(agents)) {
+		bool isStatic = dynamic_cast<EnvironmentAgent*>(agent) != nullptr;
+
+		for (ColliderComponent* collider : agent->GetColliders()) {
+			if (!collider->IsEnabled()) continue;
+
+			ColliderData data = BuildColliderData(collider, isStatic);
+
+			auto [it, inserted] = proxies.try_emplace(collider);
+			ProxyRecord& record = it->second;
+			if (!inserted && record.isStatic != isStatic) {
+				(record.isStatic ? staticTree : dynamicTree).DestroyProxy(record.proxyID);
+				inserted = true;
+			}
+
+			DynamicAABBTree& tree = isStatic ? staticTree : dynamicTree;
+			if (inserted) {
+				record.proxyID = tree.CreateProxy(data.bounds, &record);
+				record.isStatic = isStatic;
+				if (record.colliderID == 0) record.colliderID = nextColliderID++;
+			}
+			else {
+				tree.MoveProxy(record.proxyID, data.bounds, ZoneCenter(data.bounds) - ZoneCenter(record.bounds));
+			}
+
+			record.bounds = data.bounds;
+			data.id = record.colliderID;
+			record.dataIndex = static_cast<int>(colliders.size());
+			record.lastSeen = colliderFrame;
+			(isStatic ? staticCategories : dynamicCategories) |= data.category;
+			colliders.push_back(data);
+		}
+	}
+
+	// Drop proxies of colliders that were removed or disabled
+	for (auto it = proxies.begin(); it != proxies.end();) {
+		if (it->second.lastSeen != colliderFrame) {
+			(it->second.isStatic ? staticTree : dynamicTree).DestroyProxy(it->second.proxyID);
+			it = proxies.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	BuildShapeArrays();
+}
+
+void PhysicsSystem::BuildShapeArrays() {
+	shapes.Resize(colliders.size());
+	for (int i = 0; i < static_cast<int>(colliders.size()); ++i) {
+		shapes.Set(i, colliders[i]);
+	}
+}
+
+void PhysicsSystem::SyncAgentBounds(const std::vector<std::unique_ptr<Agent>>& agents) {
+	++agentFrame;
+
+	for (const auto& agent : agents) {
+		if (!agent) continue;
+
+		// Same box Agent::HandleMouse tests against
+		const Transform& agentTransform = agent->GetTransform();
+		glm::vec2 halfSize = glm::abs(agentTransform.scale) * 0.5f;
+		Zone bounds = { agentTransform.position - halfSize, agentTransform.position + halfSize };
+
+		auto [it, inserted] = agentProxies.try_emplace(agent.get());
+		AgentProxy& proxy = it->second;
+		if (inserted) {
+			proxy.proxyID = agentTree.CreateProxy(bounds, agent.get());
+		}
+		else {
+			agentTree.MoveProxy(proxy.proxyID, bounds, ZoneCenter(bounds) - ZoneCenter(proxy.bounds));
+		}
+		proxy.bounds = bounds;
+		proxy.lastSeen = agentFrame;
+	}
+
+	for (auto it = agentProxies.begin(); it != agentProxies.end();) {
+		if (it->second.lastSeen != agentFrame) {
+			agentTree.DestroyProxy(it->second.proxyID);
+			it = agentProxies.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+// Candidate pairs from the trees: dynamic against dynamic and dynamic against static
+// Tree queries are read-only, so chunks of colliders run on the job system.
+// Each chunk writes its own buffer and the buffers are joined in chunk order.
+void PhysicsSystem::BuildPairs() {
+	pairs.clear();
+
+	int count = static_cast<int>(colliders.size());
+	int chunkCount = (count + BroadphaseGrain - 1) / BroadphaseGrain;
+	if (static_cast<int>(pairBuffers.size()) < chunkCount) pairBuffers.resize(chunkCount);
+
+	JobSystem::ParallelFor(count, BroadphaseGrain, [&](int begin, int end) {
+		auto& buffer = pairBuffers[begin / BroadphaseGrain];
+		buffer.clear();
+
+		for (int i = begin; i < end; ++i) {
+			const ColliderData& a = colliders[i];
+			// Static and sleeping colliders never look for pairs, they are only found by active ones
+			if (a.isStatic || a.sleeping || a.mask == 0) continue;
+
+			auto visit = [&](const DynamicAABBTree& tree, int proxyID) {
+				int j = static_cast<const ProxyRecord*>(tree.GetUserData(proxyID))->dataIndex;
+				const ColliderData& b = colliders[j];
+
+				// Layer filter first, it is the cheapest rejection
+				if (!ShouldCollide(a, b)) return true;
+				// Pairs between two active colliders are found from both sides, keep one
+				if (!b.isStatic && !b.sleeping && j <= i) return true;
+				if (a.owner && a.owner == b.owner) return true;
+				if (!DynamicAABBTree::Overlaps(a.bounds, b.bounds)) return true;
+
+				buffer.emplace_back(std::min(i, j), std::max(i, j));
+				return true;
+			};
+
+			// Skip whole trees that hold nothing this collider accepts
+			if (a.mask & dynamicCategories) {
+				dynamicTree.Query(a.bounds, [&](int proxyID) { return visit(dynamicTree, proxyID); });
+			}
+			if (a.mask & staticCategories) {
+				staticTree.Query(a.bounds, [&](int proxyID) { return visit(staticTree, proxyID); });
+			}
+		}
+	});
+
+	for (int chunk = 0; chunk < chunkCount; ++chunk) {
+		pairs.insert(pairs.end(), pairBuffers[chunk].begin(), pairBuffers[chunk].end());
+	}
+
+	// Keep the old agent-order processing so resolution stays predictable
+	std::sort(pairs.begin(), pairs.end());
+}
+
+// Shape tests only read the cached ColliderData. Hit lists come back per chunk and are
+// joined in chunk order, which keeps them sorted by pair.
+void PhysicsSystem::RunNarrowphase() {
+	hits.clear();
+
+	int count = static_cast<int>(pairs.size());
+	int chunkCount = (count + NarrowphaseGrain - 1) / NarrowphaseGrain;
+	if (static_cast<int>(hitBuffers.size()) < chunkCount) hitBuffers.resize(chunkCount);
+
+	ShapeBatchKernel kernel = ShapeBatch::GetKernel();
+	JobSystem::ParallelFor(count, NarrowphaseGrain, [&](int begin, int end) {
+		auto& buffer = hitBuffers[begin / NarrowphaseGrain];
+		buffer.clear();
+		NarrowphaseRange(begin, end, kernel, buffer);
+	});
+
+	for (int chunk = 0; chunk < chunkCount; ++chunk) {
+		hits.insert(hits.end(), hitBuffers[chunk].begin(), hitBuffers[chunk].end());
+	}
+}
+
+// Pairs are sorted, so each collider's candidates sit next to each other. Runs of up to
+// ShapeBatch::Width box/circle candidates go through the kernel, lines take the per-pair path.
+void PhysicsSystem::NarrowphaseRange(int begin, int end, ShapeBatchKernel kernel, std::vector<int>& out) const {
+	int p = begin;
+	while (p < end) {
+		int a = pairs[p].first;
+		if (!ShapeBatch::IsBatchable(colliders[a].shape) || !ShapeBatch::IsBatchable(colliders[pairs[p].second].shape)) {
+			if (CheckCollision(colliders[a], colliders[pairs[p].second])) out.push_back(p);
+			++p;
+			continue;
+		}
+
+		int candidates[ShapeBatch::Width];
+		int count = 0;
+		int first = p;
+		while (p < end && count < ShapeBatch::Width && pairs[p].first == a
+			&& ShapeBatch::IsBatchable(colliders[pairs[p].second].shape)) {
+			candidates[count++] = pairs[p++].second;
+		}
+
+		// Short runs are cheaper one pair at a time than a padded batch
+		if (!kernel || count < ShapeBatch::MinBatch) {
+			for (int k = 0; k < count; ++k) {
+				if (CheckCollision(colliders[a], colliders[candidates[k]])) out.push_back(first + k);
+			}
+			continue;
+		}
+
+		uint32_t result = kernel(shapes, a, candidates, count);
+		for (int k = 0; k < count; ++k) {
+			if ((result >> k) & 1u) out.push_back(first + k);
+		}
+	}
+}
+
+// Single-threaded narrowphase over the benchmark pairs, per-pair functions against each kernel
+void PhysicsSystem::BenchmarkKernels() {
+	const int repeats = 50;
+	int count = static_cast<int>(pairs.size());
+	if (count == 0) return;
+
+	std::vector<int> reference;
+	std::vector<int> batched;
+	reference.reserve(count);
+	batched.reserve(count);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repeats; ++r) {
+		reference.clear();
+		for (int p = 0; p < count; ++p) {
+			if (CheckCollision(colliders[pairs[p].first], colliders[pairs[p].second])) reference.push_back(p);
+		}
+	}
+	kernelResults.emplace_back("Per pair", MillisecondsSince(start) * 1e6f / (static_cast<float>(repeats) * count));
+
+	std::vector<std::pair<std::string, ShapeBatchKernel>> kernels = { { "Batch scalar", &ShapeBatch::TestScalar } };
+	if (ShapeBatch::HasSSE()) kernels.emplace_back("Batch SSE2", &ShapeBatch::TestSSE);
+	if (ShapeBatch::HasAVX2()) kernels.emplace_back("Batch AVX2", &ShapeBatch::TestAVX2);
+
+	for (const auto& [label, kernel] : kernels) {
+		start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; ++r) {
+			batched.clear();
+			NarrowphaseRange(0, count, kernel, batched);
+		}
+		kernelResults.emplace_back(label, MillisecondsSince(start) * 1e6f / (static_cast<float>(repeats) * count));
+
+		if (batched != reference) {
+			std::cerr << "[PhysicsSystem] " << label << " disagrees with the per-pair tests" << std::endl;
+		}
+	}
+}
+
+// Boxes and circles packed densely enough for several candidates each. The colliders are
+// synthetic (no components), so only the broadphase and narrowphase are timed.
+void PhysicsSystem::RunBenchmark() {
+	PhysicsSystem bench;
+	std::vector<ProxyRecord> records(benchmarkColliders);
+
+	std::mt19937 rng(1234);
+	float extent = std::sqrt(static_cast<float>(benchmarkColliders)) * 0.75f;
+	std::uniform_real_distribution<float> position(0.0f, extent);
+	std::uniform_real_distribution<float> size(0.3f, 1.2f);
+
+	for (int i = 0; i < benchmarkColliders; ++i) {
+		ColliderData data;
+		data.isStatic = (i % 5) == 0;
+		data.layer = DefaultLayerFor(ColliderType::Solid);
+		data.category = 1u << data.layer;
+		data.mask = data.category;
+		data.center = glm::vec2(position(rng), position(rng));
+
+		if (i % 2) {
+			data.shape = ShapeType::Circle;
+			data.radius = 0.5f * size(rng);
+			data.bounds = { data.center - glm::vec2(data.radius), data.center + glm::vec2(data.radius) };
+		}
+		else {
+			glm::vec2 halfSize(0.5f * size(rng), 0.5f * size(rng));
+			data.bounds = { data.center - halfSize, data.center + halfSize };
+		}
+
+		ProxyRecord& record = records[i];
+		record.isStatic = data.isStatic;
+		record.dataIndex = i;
+		record.proxyID = (data.isStatic ? bench.staticTree : bench.dynamicTree).CreateProxy(data.bounds, &record);
+		(data.isStatic ? bench.staticCategories : bench.dynamicCategories) |= data.category;
+		bench.colliders.push_back(data);
+	}
+	bench.BuildShapeArrays();
+
+	const int steps = 10;
+	int previousWorkers = JobSystem::GetWorkerCount();
+	benchmarkResults.clear();
+	kernelResults.clear();
+
+	for (int threads : { 1, 2, 4, 8, 16 }) {
+		JobSystem::SetWorkerCount(threads - 1);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int s = 0; s < steps; ++s) {
+			bench.BuildPairs();
+			bench.RunNarrowphase();
+		}
+		benchmarkResults.emplace_back(threads, MillisecondsSince(start) / steps);
+	}
+
+	JobSystem::SetWorkerCount(previousWorkers);
+
+	bench.BenchmarkKernels();
+	kernelResults = bench.kernelResults;
+
+	char buffer[128];
+	snprintf(buffer, sizeof(buffer), "%d colliders, %d pairs, %d contacts", benchmarkColliders,
+		bench.GetPairCount(), static_cast<int>(bench.hits.size()));
+	benchmarkScene = buffer;
+}
+
+void PhysicsSystem::DrawImGui() {
+	ImGui::Text("Colliders: %d  Pairs: %d", static_cast<int>(colliders.size()), GetPairCount());
+	ImGui::Text("Contacts: %d  Began: %d  Ended: %d", GetContactCount(), beginCount, endCount);
+	ImGui::Text("Continuous sweeps: %d  Hits: %d", continuousSweeps, continuousHits);
+	ImGui::Text("Bodies: %d  Active: %d  Sleeping: %d  Islands: %d", solver.GetBodyCount(),
+		solver.GetAwakeCount(), solver.GetSleepingCount(), solver.GetIslandCount());
+	ImGui::Text("Body contacts: %d", solver.GetContactCount());
+	ImGui::SliderInt("Velocity Iterations", &velocityIterations, 1, 32);
+	ImGui::SliderInt("Position Iterations", &positionIterations, 1, 16);
+	ImGui::Text("Broadphase: %.3f ms  Narrowphase: %.3f ms (%d workers)",
+		lastBroadphaseMs, lastNarrowphaseMs, JobSystem::GetWorkerCount() + 1);
+
+	if (ImGui::TreeNode("Determinism")) {
+		ImGui::Checkbox("Deterministic", &deterministic);
+#ifndef DELUSIVE_DETERMINISTIC
+		ImGui::TextDisabled("Strict float path off, rebuild with DELUSIVE_DETERMINISTIC for cross-machine results");
+#endif
+		if (deterministic) {
+			ImGui::Text("Step checksum: %016llx", static_cast<unsigned long long>(stepChecksum));
+		}
+		if (ImGui::Button("Run Determinism Check")) {
+			RunDeterminismCheck();
+		}
+		if (!determinismResult.empty()) {
+			ImGui::Text("%s", determinismResult.c_str());
+		}
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Benchmark")) {
+		ImGui::InputInt("Colliders", &benchmarkColliders);
+		benchmarkColliders = std::clamp(benchmarkColliders, 1, 200000);
+		if (ImGui::Button("Run Benchmark")) {
+			RunBenchmark();
+		}
+		if (!benchmarkScene.empty()) {
+			ImGui::Text("%s", benchmarkScene.c_str());
+		}
+		for (const auto& [threads, ms] : benchmarkResults) {
+			ImGui::Text("%2d threads: %.3f ms (x%.2f)", threads, ms, benchmarkResults.front().second / ms);
+		}
+		if (!kernelResults.empty()) {
+			ImGui::Text("Narrowphase kernel in use: %s", ShapeBatch::GetKernelName());
+			for (const auto& [label, nanoseconds] : kernelResults) {
+				ImGui::Text("%s: %.2f ns/pair", label.c_str(), nanoseconds);
+			}
+		}
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Layer Names")) {
+		for (int i = FirstUserLayer; i < MaxCollisionLayers; ++i) {
+			char buffer[64];
+			strncpy_s(buffer, layers.names[i].c_str(), sizeof(buffer));
+			ImGui::PushID(i);
+			if (ImGui::InputText(("Layer " + std::to_string(i)).c_str(), buffer, sizeof(buffer))) {
+				layers.names[i] = buffer;
+			}
+			ImGui::PopID();
+		}
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Layer Matrix")) {
+		// Only named layers are shown; lower triangle since rows are symmetric
+		std::vector<int> shown;
+		for (int i = 0; i < MaxCollisionLayers; ++i) {
+			if (!layers.names[i].empty()) shown.push_back(i);
+		}
+
+		for (size_t row = 0; row < shown.size(); ++row) {
+			int a = shown[row];
+			ImGui::PushID(a);
+			for (size_t column = 0; column <= row; ++column) {
+				int b = shown[column];
+				bool collides = layers.Collides(a, b);
+				ImGui::PushID(b);
+				if (ImGui::Checkbox("##collides", &collides)) {
+					layers.SetCollides(a, b, collides);
+				}
+				if (ImGui::IsItemHovered()) {
+					ImGui::SetTooltip("%s / %s", layers.names[a].c_str(), layers.names[b].c_str());
 				}
+				ImGui::PopID();
+				ImGui::SameLine();
 			}
+			ImGui::Text("%s", layers.names[a].c_str());
+			ImGui::PopID();
+		}
+		ImGui::TreePop();
+	}
+}
+
+void PhysicsSystem::SerializeLayers(std::ostream& out) const {
+	out << "[Physics]" << "\n";
+	for (int i = 0; i < MaxCollisionLayers; ++i) {
+		if (layers.names[i].empty() && layers.masks[i] == 0) continue;
+		out << "layer " << i << " " << layers.masks[i] << " " << layers.names[i] << "\n";
+	}
+	out << "[/Physics]" << "\n";
+}
+
+void PhysicsSystem::DeserializeLayers(std::istream& in) {
+	// Layers present in the file replace the defaults entirely
+	layers.names.fill("");
+	layers.masks.fill(0);
+
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line == "[/Physics]") break;
+
+		std::istringstream iss(line);
+		std::string token;
+		int index;
+		uint32_t mask;
+		if (!(iss >> token >> index >> mask) || token != "layer") continue;
+		if (index < 0 || index >= MaxCollisionLayers) {
+			std::cerr << "[PhysicsSystem] Layer index out of range: " << index << std::endl;
+			continue;
+		}
+
+		std::string layerName;
+		std::getline(iss, layerName);
+		if (!layerName.empty() && layerName[0] == ' ') layerName.erase(0, 1);
+
+		layers.names[index] = layerName;
+		layers.masks[index] = mask;
+	}
+}
+
+template<typename Callback>
+void PhysicsSystem::QueryTrees(const Zone& bounds, Callback&& callback, uint32_t layerMask) const {
+	for (const DynamicAABBTree* tree : { &staticTree, &dynamicTree }) {
+		if (!(layerMask & (tree == &staticTree ? staticCategories : dynamicCategories))) continue;
+
+		tree->Query(bounds, [&](int proxyID) {
+			const ProxyRecord* record = static_cast<const ProxyRecord*>(tree->GetUserData(proxyID));
+			callback(colliders[record->dataIndex]);
+			return true;
+		});
+	}
+}
+
+void PhysicsSystem::QueryOverlap(const Zone& bounds, std::vector<ColliderComponent*>& out, const QueryFilter& filter) const {
+	QueryTrees(bounds, [&](const ColliderData& data) {
+		if (PassesFilter(data, filter) && OverlapsZone(data, bounds)) out.push_back(data.collider);
+	}, filter.layerMask);
+}
+
+void PhysicsSystem::QueryCircle(glm::vec2 center, float radius, std::vector<ColliderComponent*>& out, const QueryFilter& filter) const {
+	ColliderData circle;
+	circle.shape = ShapeType::Circle;
+	circle.center = center;
+	circle.radius = radius;
+	circle.bounds = { center - glm::vec2(radius), center + glm::vec2(radius) };
+
+	QueryTrees(circle.bounds, [&](const ColliderData& data) {
+		if (PassesFilter(data, filter) && CheckCollision(circle, data)) out.push_back(data.collider);
+	}, filter.layerMask);
+}
+
+void PhysicsSystem::QueryPoint(glm::vec2 point, std::vector<ColliderComponent*>& out) const {
+	Zone bounds = { point - glm::vec2(PointQueryTolerance), point + glm::vec2(PointQueryTolerance) };
+	QueryTrees(bounds, [&](const ColliderData& data) {
+		bool inside = false;
+		switch (data.shape) {
+		case ShapeType::Box:
+			inside = PointInZone(point, data.bounds);
+			break;
+		case ShapeType::Circle:
+			inside = glm::length2(point - data.center) <= data.radius * data.radius;
+			break;
+		case ShapeType::Line:
+			inside = OverlapsZone(data, bounds);
+			break;
 		}
+		if (inside) out.push_back(data.collider);
+	});
+}
+
+bool PhysicsSystem::RayCast(glm::vec2 from, glm::vec2 to, RayHit& hit, const QueryFilter& filter) const {
+	hit = RayHit();
+	bool found = false;
+
+	for (const DynamicAABBTree* tree : { &staticTree, &dynamicTree }) {
+		if (!(filter.layerMask & (tree == &staticTree ? staticCategories : dynamicCategories))) continue;
+
+		// Clipped to the best hit so far, so the second tree only visits what could be closer.
+		// The tree works in fractions of the clipped segment, hits are kept in fractions of the full one.
+		float clip = hit.fraction;
+		glm::vec2 end = from + (to - from) * clip;
+		tree->RayCast(from, end, [&](int proxyID, glm::vec2, glm::vec2, float maxFraction) {
+			const ProxyRecord* record = static_cast<const ProxyRecord*>(tree->GetUserData(proxyID));
+			const ColliderData& data = colliders[record->dataIndex];
+			if (!PassesFilter(data, filter)) return maxFraction;
+
+			float fraction;
+			glm::vec2 normal;
+			if (!RayCastShape(data, from, to, fraction, normal) || fraction >= hit.fraction) {
+				return maxFraction;
+			}
+
+			found = true;
+			hit.collider = data.collider;
+			hit.fraction = fraction;
+			hit.point = from + (to - from) * fraction;
+			hit.normal = normal;
+			return fraction / clip;
+		});
 	}
+	return found;
+}
+
+bool PhysicsSystem::CircleCast(glm::vec2 from, glm::vec2 to, float radius, RayHit& hit, const QueryFilter& filter) const {
+	hit = RayHit();
+	bool found = false;
+
+	ColliderData moving;
+	moving.shape = ShapeType::Circle;
+	moving.center = from;
+	moving.radius = radius;
+	moving.bounds = { from - glm::vec2(radius), from + glm::vec2(radius) };
+
+	glm::vec2 motion = to - from;
+	Zone swept = { glm::min(from, to) - glm::vec2(radius), glm::max(from, to) + glm::vec2(radius) };
+
+	QueryTrees(swept, [&](const ColliderData& data) {
+		if (!PassesFilter(data, filter)) return;
+
+		float fraction;
+		glm::vec2 normal;
+		float depth;
+		// Sweeps ignore shapes they start in, a query reports them at the start
+		if (ComputeManifold(data, moving, normal, depth)) {
+			fraction = 0.0f;
+		}
+		else if (!ShapeCast::Sweep(moving, motion, data, fraction, normal)) {
+			return;
+		}
+		if (fraction >= hit.fraction) return;
+
+		found = true;
+		hit.collider = data.collider;
+		hit.fraction = fraction;
+		hit.normal = normal;
+		hit.point = from + motion * fraction - normal * radius;
+	}, filter.layerMask);
+	return found;
+}
+
+void PhysicsSystem::QueryAgentsAtPoint(glm::vec2 point, std::vector<Agent*>& out) const {
+	agentTree.QueryPoint(point, [&](int proxyID) {
+		Agent* agent = static_cast<Agent*>(agentTree.GetUserData(proxyID));
+		if (PointInZone(point, agentProxies.at(agent).bounds)) {
+			out.push_back(agent);
+		}
+		return true;
+	});
 }
 
 void PhysicsSystem::ResolveSolidCollision(ColliderComponent* solid, ColliderComponent* other) {
@@ -55,9 +1155,9 @@ void PhysicsSystem::ResolveSolidCollision(ColliderComponent* solid, ColliderComp
 	solid->GetOwner()->transform.position -= delta;
 }
 
-bool PhysicsSystem::CheckAABBCollision(ColliderComponent* a, ColliderComponent* b) {
-	ShapeType sa = a->GetShapeType();
-	ShapeType sb = b->GetShapeType();
+bool PhysicsSystem::CheckCollision(const ColliderData& a, const ColliderData& b) {
+	ShapeType sa = a.shape;
+	ShapeType sb = b.shape;
 
 	if (sa == ShapeType::Box && sb == ShapeType::Box)
 		return CheckBoxBoxCollision(a, b);
@@ -82,101 +1182,111 @@ bool PhysicsSystem::CheckAABBCollision(ColliderComponent* a, ColliderComponent*
 	return false;
 }
 
-bool PhysicsSystem::CheckBoxBoxCollision(ColliderComponent* a, ColliderComponent* b) {
-	glm::vec2 aMin = a->GetMin();
-	glm::vec2 aMax = a->GetMax();
-	glm::vec2 bMin = b->GetMin();
-	glm::vec2 bMax = b->GetMax();
-
-	return (aMin.x < bMax.x && aMax.x > bMin.x &&
-		aMin.y < bMax.y && aMax.y > bMin.y);
+bool PhysicsSystem::CheckBoxBoxCollision(const ColliderData& a, const ColliderData& b) {
+	return (a.bounds.min.x < b.bounds.max.x && a.bounds.max.x > b.bounds.min.x &&
+		a.bounds.min.y < b.bounds.max.y && a.bounds.max.y > b.bounds.min.y);
 }
 
-bool PhysicsSystem::CheckCircleCircleCollision(ColliderComponent* circle, ColliderComponent* box) {
-	glm::vec2 centerA = circle->transform.position;
-	glm::vec2 centerB = box->transform.position;
-	float radiusA = circle->transform.scale.x * 0.5f;
-	float radiusB = box->transform.scale.x * 0.5f;
-
-	float distSq = glm::length2(centerA - centerB);
-	float radiusSum = radiusA + radiusB;
-
-	return distSq <= radiusSum * radiusSum;
+bool PhysicsSystem::CheckCircleCircleCollision(const ColliderData& a, const ColliderData& b) {
+	float radiusSum = a.radius + b.radius;
+	return glm::length2(a.center - b.center) <= radiusSum * radiusSum;
 }
 
-bool PhysicsSystem::CheckBoxCircleCollision(ColliderComponent* box, ColliderComponent* circle) {
-	glm::vec2 boxMin = box->GetMin();
-	glm::vec2 boxMax = box->GetMax();
-	glm::vec2 circleCenter = circle->transform.position;
-	float radius = circle->transform.scale.x * 0.5f;
-
+bool PhysicsSystem::CheckBoxCircleCollision(const ColliderData& box, const ColliderData& circle) {
 	// Clamp circle center to nearest point inside box
-	glm::vec2 closest = glm::clamp(circleCenter, boxMin, boxMax);
-	glm::vec2 delta = circleCenter - closest;
-
-	return glm::length2(delta) <= radius * radius;
+	glm::vec2 closest = glm::clamp(circle.center, box.bounds.min, box.bounds.max);
+	return glm::length2(circle.center - closest) <= circle.radius * circle.radius;
 }
 
-bool PhysicsSystem::CheckLineLineCollision(ColliderComponent* a, ColliderComponent* b) {
-	glm::vec2 p1 = a->transform.position;
-	glm::vec2 d1 = glm::vec2(cos(a->transform.rotation), sin(a->transform.rotation)) * a->transform.scale.x;
-	glm::vec2 p2 = b->transform.position;
-	glm::vec2 d2 = glm::vec2(cos(b->transform.rotation), sin(b->transform.rotation)) * b->transform.scale.x;
-
-	glm::vec2 q1 = p1 + d1;
-	glm::vec2 q2 = p2 + d2;
+bool PhysicsSystem::CheckLineLineCollision(const ColliderData& a, const ColliderData& b) {
+	return SegmentsIntersect(a.center, a.end, b.center, b.end);
+}
 
-	// Line segment intersection check
-	auto ccw = [](glm::vec2 A, glm::vec2 B, glm::vec2 C) {
-		return (C.y - A.y) * (B.x - A.x) > (B.y - A.y) * (C.x - A.x);
-		};
+bool PhysicsSystem::CheckLineCircleCollision(const ColliderData& line, const ColliderData& circle) {
+	// Project point onto segment
+	glm::vec2 seg = line.end - line.center;
+	float lengthSq = glm::dot(seg, seg);
+	float t = lengthSq > 0.0f ? glm::clamp(glm::dot(circle.center - line.center, seg) / lengthSq, 0.0f, 1.0f) : 0.0f;
+	glm::vec2 closest = line.center + seg * t;
 
-	return (ccw(p1, p2, q2) != ccw(q1, p2, q2)) &&
-		(ccw(p1, q1, p2) != ccw(p1, q1, q2));
+	return glm::length2(circle.center - closest) <= circle.radius * circle.radius;
 }
 
-bool PhysicsSystem::CheckLineCircleCollision(ColliderComponent* line, ColliderComponent* circle) {
-	glm::vec2 p1 = line->transform.position;
-	glm::vec2 dir = glm::vec2(cos(line->transform.rotation), sin(line->transform.rotation));
-	glm::vec2 p2 = p1 + dir * line->transform.scale.x;
+bool PhysicsSystem::CheckLineBoxCollision(const ColliderData& line, const ColliderData& box) {
+	float t;
+	glm::vec2 normal;
+	return ShapeCast::SegmentBox(line.center, line.end, box.bounds, t, normal);
+}
 
-	glm::vec2 circleCenter = circle->transform.position;
-	float radius = circle->transform.scale.x * 0.5f;
+bool PhysicsSystem::ComputeManifold(const ColliderData& a, const ColliderData& b, glm::vec2& normal, float& depth) {
+	ShapeType sa = a.shape;
+	ShapeType sb = b.shape;
+	bool found = false;
+	bool flip = false;
 
-	// Project point onto segment
-	glm::vec2 seg = p2 - p1;
-	glm::vec2 toCenter = circleCenter - p1;
+	if (sa == ShapeType::Box && sb == ShapeType::Box)
+		found = BoxBoxManifold(a.bounds, b.bounds, normal, depth);
+	else if (sa == ShapeType::Circle && sb == ShapeType::Circle)
+		found = CircleCircleManifold(a.center, a.radius, b.center, b.radius, normal, depth);
+	else if (sa == ShapeType::Box && sb == ShapeType::Circle)
+		found = BoxCircleManifold(a.bounds, b.center, b.radius, normal, depth);
+	else if (sa == ShapeType::Circle && sb == ShapeType::Box)
+		found = flip = BoxCircleManifold(b.bounds, a.center, a.radius, normal, depth);
+	else if (sa == ShapeType::Line && sb == ShapeType::Circle)
+		found = SegmentCircleManifold(a.center, a.end, b.center, b.radius, normal, depth);
+	else if (sa == ShapeType::Circle && sb == ShapeType::Line)
+		found = flip = SegmentCircleManifold(b.center, b.end, a.center, a.radius, normal, depth);
+	else if (sa == ShapeType::Line && sb == ShapeType::Box)
+		found = SegmentBoxManifold(a.center, a.end, b.bounds, normal, depth);
+	else if (sa == ShapeType::Box && sb == ShapeType::Line)
+		found = flip = SegmentBoxManifold(b.center, b.end, a.bounds, normal, depth);
+	// Two segments have no area to push apart
 
-	float t = glm::clamp(glm::dot(toCenter, seg) / glm::dot(seg, seg), 0.0f, 1.0f);
-	glm::vec2 closest = p1 + seg * t;
+	if (flip) normal = -normal;
+	return found;
+}
 
-	glm::vec2 delta = circleCenter - closest;
-	return glm::length2(delta) <= radius * radius;
+bool PhysicsSystem::OverlapsZone(const ColliderData& data, const Zone& zone) {
+	switch (data.shape) {
+	case ShapeType::Circle: {
+		glm::vec2 closest = glm::clamp(data.center, zone.min, zone.max);
+		return glm::length2(data.center - closest) <= data.radius * data.radius;
+	}
+	case ShapeType::Line: {
+		float t;
+		glm::vec2 normal;
+		return ShapeCast::SegmentBox(data.center, data.end, zone, t, normal);
+	}
+	default:
+		return DynamicAABBTree::Overlaps(data.bounds, zone);
+	}
 }
 
-bool PhysicsSystem::CheckLineBoxCollision(ColliderComponent* line, ColliderComponent* box) {
-	glm::vec2 p1 = line->transform.position;
-	glm::vec2 dir = glm::vec2(cos(line->transform.rotation), sin(line->transform.rotation));
-	glm::vec2 p2 = p1 + dir * line->transform.scale.x;
+bool PhysicsSystem::RayCastShape(const ColliderData& data, glm::vec2 from, glm::vec2 to, float& fraction, glm::vec2& normal) {
+	glm::vec2 ray = to - from;
 
-	glm::vec2 boxMin = box->GetMin();
-	glm::vec2 boxMax = box->GetMax();
+	switch (data.shape) {
+	case ShapeType::Box:
+		return ShapeCast::SegmentBox(from, to, data.bounds, fraction, normal);
 
-	// Check for intersection with each of the 4 box edges
-	auto IntersectsSegment = [](glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d) {
-		auto ccw = [](glm::vec2 A, glm::vec2 B, glm::vec2 C) {
-			return (C.y - A.y) * (B.x - A.x) > (B.y - A.y) * (C.x - A.x);
-			};
-		return (ccw(a, c, d) != ccw(b, c, d)) && (ccw(a, b, c) != ccw(a, b, d));
-		};
+	case ShapeType::Circle:
+		return ShapeCast::SegmentCircle(from, to, data.center, data.radius, fraction, normal);
 
-	glm::vec2 bl = { boxMin.x, boxMin.y };
-	glm::vec2 br = { boxMax.x, boxMin.y };
-	glm::vec2 tr = { boxMax.x, boxMax.y };
-	glm::vec2 tl = { boxMin.x, boxMax.y };
+	case ShapeType::Line: {
+		glm::vec2 segment = data.end - data.center;
+		float denominator = ray.x * segment.y - ray.y * segment.x;
+		if (std::fabs(denominator) < 1e-8f) return false;
 
-	return IntersectsSegment(p1, p2, bl, br) ||
-		IntersectsSegment(p1, p2, br, tr) ||
-		IntersectsSegment(p1, p2, tr, tl) ||
-		IntersectsSegment(p1, p2, tl, bl);
-}
\ No newline at end of file
+		glm::vec2 offset = data.center - from;
+		float t = (offset.x * segment.y - offset.y * segment.x) / denominator;
+		float u = (offset.x * ray.y - offset.y * ray.x) / denominator;
+		if (t < 0.0f || t > 1.0f || u < 0.0f || u > 1.0f) return false;
+
+		fraction = t;
+		normal = glm::normalize(glm::vec2(-segment.y, segment.x));
+		if (glm::dot(normal, ray) > 0.0f) normal = -normal;
+		return true;
+	}
+	}
+	return false;
+}
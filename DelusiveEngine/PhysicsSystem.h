@@ -1,19 +1,176 @@
 #pragma once
 #define GLM_ENABLE_EXPERIMENTAL
 #include "ColliderComponent.h"
+#include "DynamicAABBTree.h"
+#include "ContactTable.h"
+#include "ShapeBatch.h"
+#include "RigidbodySolver.h"
+#include <Delusive/PhysicsQuery.h>
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
 
+class ScriptComponent;
+
+struct RayHit {
+	ColliderComponent* collider = nullptr;
+	glm::vec2 point = glm::vec2(0.0f);
+	glm::vec2 normal = glm::vec2(0.0f);
+	float fraction = 1.0f; // along the cast segment
+};
+
+//Per-scene collision pipeline. Colliders of EnvironmentAgents live in a static tree and
+//everything else in a dynamic tree, so static pairs are never generated.
+//Agents with a RigidbodyComponent are integrated and resolved by the impulse solver,
+//the rest keep the push-out resolution.
 class PhysicsSystem {
 public:
-	static void HandleCollisions(const std::vector<std::unique_ptr<Agent>>&);
+	void HandleCollisions(const std::vector<std::unique_ptr<Agent>>&, float deltaTime);
+	//Delivers the Begin/Stay/End events queued by the last step to colliders and scripts
+	void DispatchContacts();
+	void Clear();
+
+	//Brings the collider cache and trees up to date without running a step
+	void SyncColliders(const std::vector<std::unique_ptr<Agent>>&);
+	//Agent transform bounds used for editor picking
+	void SyncAgentBounds(const std::vector<std::unique_ptr<Agent>>&);
+
+	//Queries run against the colliders from the last step or sync. They only read, so they are
+	//safe to run from several jobs at once between steps.
+	void QueryOverlap(const Zone&, std::vector<ColliderComponent*>&, const QueryFilter& = {}) const;
+	void QueryCircle(glm::vec2 center, float radius, std::vector<ColliderComponent*>&, const QueryFilter& = {}) const;
+	void QueryPoint(glm::vec2, std::vector<ColliderComponent*>&) const;
+	bool RayCast(glm::vec2 from, glm::vec2 to, RayHit&, const QueryFilter& = {}) const;
+	//hit.normal is the surface normal, hit.point where the circle touches it
+	bool CircleCast(glm::vec2 from, glm::vec2 to, float radius, RayHit&, const QueryFilter& = {}) const;
+	void QueryAgentsAtPoint(glm::vec2, std::vector<Agent*>&) const;
+
+	CollisionLayers& GetLayers() { return layers; }
+	const CollisionLayers& GetLayers() const { return layers; }
+	void DrawImGui();
+	void SerializeLayers(std::ostream&) const;
+	void DeserializeLayers(std::istream&);
+
+	const std::vector<ColliderData>& GetColliderData() const { return colliders; }
+	int GetPairCount() const { return static_cast<int>(pairs.size()); }
+	int GetContactCount() const { return static_cast<int>(contacts.GetContacts().size()); }
+	int GetBodyCount() const { return solver.GetBodyCount(); }
+	int GetActiveBodyCount() const { return solver.GetAwakeCount(); }
+	int GetSleepingBodyCount() const { return solver.GetSleepingCount(); }
+
+	//Synthetic stress scene run at 1, 2, 4, 8 and 16 threads, results are shown in the Benchmark inspector section
+	void RunBenchmark();
+
+	//Deterministic mode walks agents in ID order instead of vector order and hashes agent transforms and
+	//body state after every step, for comparing replays and rollback resimulation
+	bool IsDeterministic() const { return deterministic; }
+	void SetDeterministic(bool _deterministic) { deterministic = _deterministic; }
+	uint64_t GetStepChecksum() const { return stepChecksum; }
+	uint64_t ComputeChecksum(const std::vector<std::unique_ptr<Agent>>&);
+	//Steps a synthetic scene twice, the second time with agents added in shuffled order, and compares checksums.
+	//Returns true when they match; the summary is shown in the Determinism inspector section
+	bool RunDeterminismCheck();
+
 private:
-	static bool CheckAABBCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckBoxBoxCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckCircleCircleCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckBoxCircleCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckLineLineCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckLineCircleCollision(ColliderComponent*, ColliderComponent*);
-	static bool CheckLineBoxCollision(ColliderComponent*, ColliderComponent*);
+	struct ProxyRecord {
+		int proxyID = DynamicAABBTree::NullNode;
+		uint32_t colliderID = 0;
+		glm::vec2 sweepStart = glm::vec2(0.0f); // continuous colliders: center at the end of the last step
+		bool hasSweepStart = false;
+		bool isStatic = false;
+		int dataIndex = -1;
+		uint32_t lastSeen = 0;
+		Zone bounds = { glm::vec2(0.0f), glm::vec2(0.0f) };
+	};
+
+	struct AgentProxy {
+		int proxyID = DynamicAABBTree::NullNode;
+		uint32_t lastSeen = 0;
+		Zone bounds = { glm::vec2(0.0f), glm::vec2(0.0f) };
+	};
+
+	CollisionLayers layers;
+	DynamicAABBTree staticTree;
+	DynamicAABBTree dynamicTree;
+	DynamicAABBTree agentTree;
+	std::unordered_map<ColliderComponent*, ProxyRecord> proxies;
+	std::unordered_map<Agent*, AgentProxy> agentProxies;
+	std::vector<ColliderData> colliders;
+	ShapeArrays shapes; // SoA mirror of colliders for the batched tests
+	std::vector<std::pair<int, int>> pairs;
+	std::vector<int> hits; // indices into pairs that passed the narrowphase
+	std::vector<std::vector<std::pair<int, int>>> pairBuffers; // one per job chunk
+	std::vector<std::vector<int>> hitBuffers;
+	ContactTable contacts;
+	ContactEventBuffer contactEvents;
+	RigidbodySolver solver;
+	std::unordered_map<Agent*, int> bodyIndices;
+	int velocityIterations = 8;
+	int positionIterations = 3;
+	uint32_t nextColliderID = 1;
+	uint32_t step = 0;
+	int beginCount = 0;
+	int endCount = 0;
+	int continuousSweeps = 0;
+	int continuousHits = 0;
+	float lastBroadphaseMs = 0.0f;
+	float lastNarrowphaseMs = 0.0f;
+	int benchmarkColliders = 20000;
+	std::vector<std::pair<int, float>> benchmarkResults; // thread count, ms per step
+	std::string benchmarkScene; // collider, pair and contact counts of the last run
+	std::vector<std::pair<std::string, float>> kernelResults; // narrowphase path, ns per pair
+	uint32_t staticCategories = 0;  // union of layer bits in each tree
+	uint32_t dynamicCategories = 0;
+	uint32_t colliderFrame = 0;
+	uint32_t agentFrame = 0;
+#ifdef DELUSIVE_DETERMINISTIC
+	bool deterministic = true;
+#else
+	bool deterministic = false;
+#endif
+	uint64_t stepChecksum = 0;
+	std::string determinismResult;
+	std::vector<Agent*> agentOrder;
+	std::unordered_map<Agent*, std::vector<ScriptComponent*>> dispatchScripts; // per agent, only during DispatchContacts
+
+	const std::vector<Agent*>& OrderAgents(const std::vector<std::unique_ptr<Agent>>&);
+	void GatherBodies(const std::vector<std::unique_ptr<Agent>>&);
+	void ResolveSolids(const ColliderData&, const ColliderData&);
+	void SolveContinuous(const std::vector<std::unique_ptr<Agent>>&);
+	glm::vec2 SweepStatic(const ColliderData&, glm::vec2 motion) const;
+	void StoreSweepStarts();
+	void BuildPairs();
+	void RunNarrowphase();
+	void BuildShapeArrays();
+	void NarrowphaseRange(int begin, int end, ShapeBatchKernel, std::vector<int>& out) const;
+	void BenchmarkKernels();
+	ContactPhase UpdateContact(const ColliderData&, const ColliderData&);
+	void EndStaleContacts();
+	bool IsAlive(ColliderComponent*, uint32_t colliderID) const;
+	//Static, or asleep when the step started
+	bool IsInactive(ColliderComponent*, uint32_t colliderID) const;
+	template<typename Callback> void QueryTrees(const Zone&, Callback&&, uint32_t layerMask = ~0u) const;
+
+	ColliderData BuildColliderData(ColliderComponent*, bool isStatic) const;
+	static bool ShouldCollide(const ColliderData& a, const ColliderData& b) {
+		return (a.category & b.mask) && (b.category & a.mask);
+	}
+	static bool PassesFilter(const ColliderData& data, const QueryFilter& filter) {
+		return (data.category & filter.layerMask) &&
+			(filter.ignoreAgentID == 0 || !data.owner || data.owner->GetID() != filter.ignoreAgentID);
+	}
+	static bool CheckCollision(const ColliderData&, const ColliderData&);
+	static bool CheckBoxBoxCollision(const ColliderData&, const ColliderData&);
+	static bool CheckCircleCircleCollision(const ColliderData&, const ColliderData&);
+	static bool CheckBoxCircleCollision(const ColliderData& box, const ColliderData& circle);
+	static bool CheckLineLineCollision(const ColliderData&, const ColliderData&);
+	static bool CheckLineCircleCollision(const ColliderData& line, const ColliderData& circle);
+	static bool CheckLineBoxCollision(const ColliderData& line, const ColliderData& box);
+	//Contact normal from a to b and overlap depth for the solver
+	static bool ComputeManifold(const ColliderData& a, const ColliderData& b, glm::vec2& normal, float& depth);
+	static bool OverlapsZone(const ColliderData&, const Zone&);
+	static bool RayCastShape(const ColliderData&, glm::vec2 from, glm::vec2 to, float& fraction, glm::vec2& normal);
 	static void ResolveSolidCollision(ColliderComponent*, ColliderComponent*);
-};
\ No newline at end of file
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+
+class Agent;
+class ColliderComponent;
+
+enum class ColliderType {
+	Solid,
+	Hitbox,
+	Hurtbox,
+	Trigger
+};
+
+enum class ShapeType {
+	Box,
+	Circle,
+	Line
+};
+
+struct Zone {
+	glm::vec2 min, max;
+};
+
+//Built-in layers line up with ColliderType, user layers start after them
+constexpr int MaxCollisionLayers = 32;
+constexpr int FirstUserLayer = 4;
+
+inline int DefaultLayerFor(ColliderType type) {
+	return static_cast<int>(type);
+}
+
+//Scene-wide table of which layers interact. Rows are kept symmetric.
+struct CollisionLayers {
+	std::array<std::string, MaxCollisionLayers> names;
+	std::array<uint32_t, MaxCollisionLayers> masks;
+
+	CollisionLayers() { Reset(); }
+
+	void Reset() {
+		names.fill("");
+		masks.fill(0);
+		names[static_cast<int>(ColliderType::Solid)] = "Solid";
+		names[static_cast<int>(ColliderType::Hitbox)] = "Hitbox";
+		names[static_cast<int>(ColliderType::Hurtbox)] = "Hurtbox";
+		names[static_cast<int>(ColliderType::Trigger)] = "Trigger";
+
+		// Same pairs the old type checks allowed
+		SetCollides(DefaultLayerFor(ColliderType::Solid), DefaultLayerFor(ColliderType::Solid), true);
+		SetCollides(DefaultLayerFor(ColliderType::Solid), DefaultLayerFor(ColliderType::Trigger), true);
+		SetCollides(DefaultLayerFor(ColliderType::Hitbox), DefaultLayerFor(ColliderType::Hurtbox), true);
+	}
+
+	bool Collides(int a, int b) const {
+		return (masks[a] >> b) & 1u;
+	}
+
+	void SetCollides(int a, int b, bool collides) {
+		if (collides) {
+			masks[a] |= 1u << b;
+			masks[b] |= 1u << a;
+		}
+		else {
+			masks[a] &= ~(1u << b);
+			masks[b] &= ~(1u << a);
+		}
+	}
+};
+
+//World-space snapshot of one enabled collider, rebuilt at the start of every physics step
+struct ColliderData {
+	ColliderComponent* collider = nullptr;
+	uint32_t id = 0;                    // stable for the collider's lifetime in the scene
+	Agent* owner = nullptr;
+	ColliderType type = ColliderType::Solid;
+	ShapeType shape = ShapeType::Box;
+	Zone bounds = { glm::vec2(0.0f), glm::vec2(0.0f) };
+	glm::vec2 center = glm::vec2(0.0f); // circle center or segment start
+	glm::vec2 end = glm::vec2(0.0f);    // segment end
+	float radius = 0.0f;
+	int layer = 0;
+	uint32_t category = 0;              // single layer bit
+	uint32_t mask = 0;                  // layers this collider accepts
+	bool isStatic = false;              // owned by an EnvironmentAgent
+	bool continuous = false;            // swept against static solids between steps
+	bool wantsStay = false;             // gets a Stay event every step it keeps touching
+	int body = 0;                       // RigidbodySolver index of the owner, 0 when it has none
+	bool sleeping = false;              // owner's body is asleep, pairs with other inactive colliders are skipped
+};
@@ -1,5 +1,6 @@
 #include "PlayerAgent.h"
 #include "DelusiveRenderer.h"
+#include "RigidbodyComponent.h"
 
 PlayerAgent::PlayerAgent(const std::string& agentName) {
 	SetName(agentName);
@@ -58,8 +59,13 @@ void PlayerAgent::Update(float deltaTime) {
     // If dodging, override with dodge impulse
     glm::vec2 finalVelocity = velocity + impulse;
 
-    // Move player
-    transform.position += finalVelocity * deltaTime;
+    // Move player, through the physics step when it has a body
+    if (RigidbodyComponent* body = GetComponentOfType<RigidbodyComponent>()) {
+        body->SetVelocity(finalVelocity);
+    }
+    else {
+        transform.position += finalVelocity * deltaTime;
+    }
 
     // Update all components
     for (auto& comp : components) {
@@ -84,7 +84,7 @@ public:
                 out << value->texturePath;
             }
             else if constexpr (std::is_same_v<T, DelusiveFont>) {
-                out << value->fontSize << " " << std::quoted(value->fontPath);
+                out << value->fontSize << " " << std::quoted(value->fontPath) << " " << (value->sdf ? 1 : 0);
             }
             else if constexpr (std::is_same_v<T, DelusiveScript>) {
                 out << value->scriptName;
@@ -142,6 +142,16 @@ public:
             }
             else if constexpr (std::is_same_v<T, DelusiveFont>) {
                 in >> value->fontSize >> std::quoted(value->fontPath);
+                // Older files end at the path, leave the next property name unread
+                const auto mark = in.tellg();
+                int sdf = 0;
+                if (in >> sdf) {
+                    value->sdf = (sdf != 0);
+                }
+                else {
+                    in.clear();
+                    in.seekg(mark);
+                }
             }
             else if constexpr (std::is_same_v<T, DelusiveScript>) {
                 in >> value->scriptName;
@@ -149,25 +159,25 @@ public:
         }
     }
 
-    void DrawImGui() override {
+    bool DrawImGui() override {
         if constexpr (is_scalar) {
             if constexpr (std::is_same<T, float>::value) {
-                ImGui::DragFloat(name.c_str(), value, 0.1f);
+                return ImGui::DragFloat(name.c_str(), value, 0.1f);
             }
             else if constexpr (std::is_same<T, int>::value) {
-                ImGui::DragInt(name.c_str(), value);
+                return ImGui::DragInt(name.c_str(), value);
             }
             else if constexpr (std::is_same<T, bool>::value) {
-                ImGui::Checkbox(name.c_str(), value);
+                return ImGui::Checkbox(name.c_str(), value);
             }
             else if constexpr (std::is_same<T, glm::vec2>::value) {
-                ImGui::DragFloat2(name.c_str(), glm::value_ptr(*value), 0.1f);
+                return ImGui::DragFloat2(name.c_str(), glm::value_ptr(*value), 0.1f);
             }
             else if constexpr (std::is_same<T, glm::vec3>::value) {
-                ImGui::DragFloat3(name.c_str(), glm::value_ptr(*value), 0.1f);
+                return ImGui::DragFloat3(name.c_str(), glm::value_ptr(*value), 0.1f);
             }
             else if constexpr (std::is_same<T, glm::vec4>::value) {
-                ImGui::ColorEdit4(name.c_str(), glm::value_ptr(*value));
+                return ImGui::ColorEdit4(name.c_str(), glm::value_ptr(*value));
             }
             else if constexpr (std::is_same_v<T, std::string>) {
                 char buffer[256];
@@ -175,6 +185,7 @@ public:
                 buffer[sizeof(buffer) - 1] = '\0';
                 if (ImGui::InputText(name.c_str(), buffer, sizeof(buffer))) {
                     *value = buffer;
+                    return true;
                 }
             }
             else {
@@ -182,17 +193,22 @@ public:
             }
         }
         else if constexpr (is_vector) {
+            bool edited = false;
             if (ImGui::TreeNode(name.c_str())) {
                 for (size_t i = 0; i < value->size(); i++) {
                     std::string label = name + "[" + std::to_string(i) + "]";
                     if constexpr (std::is_same_v<typename T::value_type, float>) {
-                        ImGui::DragFloat(label.c_str(), &(*value)[i], 0.1f);
+                        edited |= ImGui::DragFloat(label.c_str(), &(*value)[i], 0.1f);
                     }
                     else if constexpr (std::is_same_v<typename T::value_type, int>) {
-                        ImGui::DragInt(label.c_str(), &(*value)[i]);
+                        edited |= ImGui::DragInt(label.c_str(), &(*value)[i]);
                     }
                     else if constexpr (std::is_same_v<typename T::value_type, bool>) {
-                        ImGui::Checkbox(label.c_str(), &(*value)[i]);
+                        bool element = (*value)[i];
+                        if (ImGui::Checkbox(label.c_str(), &element)) {
+                            (*value)[i] = element;
+                            edited = true;
+                        }
                     }
                     else if constexpr (std::is_same_v<typename T::value_type, std::string>) {
                         char buffer[256];
@@ -200,23 +216,28 @@ public:
                         buffer[sizeof(buffer) - 1] = '\0';
                         if (ImGui::InputText(label.c_str(), buffer, sizeof(buffer))) {
                             (*value)[i] = buffer;
+                            edited = true;
                         }
                     }
                 }
                 // Add/remove buttons
                 if (ImGui::Button(("Add " + name).c_str())) {
                     value->push_back({});
+                    edited = true;
                 }
                 if (!value->empty()) {
                     ImGui::SameLine();
                     if (ImGui::Button(("Remove " + name).c_str())) {
                         value->pop_back();
+                        edited = true;
                     }
                 }
                 ImGui::TreePop();
             }
+            return edited;
         }
         else if constexpr (is_custom) {
+            bool edited = false;
             if constexpr (std::is_same_v<T, DelusiveTexture>) {
                 ImGui::Text("Texture: %s", std::filesystem::path(value->texturePath).filename().string().c_str());
                 if (ImGui::Button(("Change Texture##" + name).c_str())) {
@@ -239,6 +260,7 @@ public:
                                     std::string filename = entry.path().filename().string();
                                     if (ImGui::Selectable(filename.c_str())) {
                                         value->texturePath = entry.path().string();
+                                        edited = true;
                                         ImGui::CloseCurrentPopup();
                                     }
                                 }
@@ -251,7 +273,8 @@ public:
             }
             else if constexpr (std::is_same_v<T, DelusiveFont>) {
                 ImGui::Text("Font: %s", std::filesystem::path(value->fontPath).filename().string().c_str());
-                ImGui::DragFloat(("Size##" + name).c_str(), &value->fontSize, 1.0f, 6.0f, 128.0f);
+                edited |= ImGui::DragFloat(("Size##" + name).c_str(), &value->fontSize, 1.0f, 6.0f, 128.0f);
+                edited |= ImGui::Checkbox(("SDF##" + name).c_str(), &value->sdf);
                 if (ImGui::Button(("Change Font##" + name).c_str())) {
                     ImGui::OpenPopup(("FontBrowser##" + name).c_str());
                 }
@@ -264,6 +287,7 @@ public:
                                 std::string filename = entry.path().filename().string();
                                 if (ImGui::Selectable(filename.c_str())) {
                                     value->fontPath = entry.path().string();
+                                    edited = true;
                                     ImGui::CloseCurrentPopup();
                                 }
                             }
@@ -275,7 +299,7 @@ public:
             else if constexpr (std::is_same_v<T, DelusiveScript>) {
                 if (!value->manager) {
                     ImGui::Text("No ScriptManager available");
-                    return;
+                    return false;
                 }
 
                 std::vector<std::string> scriptNames;
@@ -297,6 +321,7 @@ public:
                         bool isSelected = (i == currentIndex);
                         if (ImGui::Selectable(scriptNames[i].c_str(), isSelected)) {
                             value->scriptName = scriptNames[i];
+                            edited = true;
 
                             // Recreate the script instance
                             if (value->manager) {
@@ -310,7 +335,9 @@ public:
                     ImGui::EndCombo();
                 }
             }
+            return edited;
         }
+        return false;
     }
 };
 
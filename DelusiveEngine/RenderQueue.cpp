@@ -0,0 +1,195 @@
+#include "RenderQueue.h"
+#include "DelusiveData.h"
+#include "DelusiveMacros.h"
+#include "DelusiveUtils.h"
+#include "UnitQuad.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+	// Maps a float to an unsigned integer with the same ordering
+	uint32_t OrderedBits(float value) {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+}
+
+RenderQueue::~RenderQueue() {
+	Shutdown();
+}
+
+void RenderQueue::Init() {
+	Shutdown();
+
+	spriteShader = std::make_unique<Shader>(DEFAULT_VERT, DEFAULT_FRAG);
+
+	glGenVertexArrays(1, &quadVAO);
+	glGenBuffers(1, &quadVBO);
+
+	glBindVertexArray(quadVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(UnitQuadVertices), UnitQuadVertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderQueue::Shutdown() {
+	if (quadVBO) glDeleteBuffers(1, &quadVBO);
+	if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
+	quadVBO = quadVAO = 0;
+	spriteShader.reset();
+}
+
+uint64_t RenderQueue::MakeKey(int layer, bool foreground, float sortY, uint16_t shaderSlot, uint16_t textureSlot) {
+	const uint64_t layerBits = static_cast<uint64_t>(std::clamp(layer, -128, 127) + 128);
+	const uint64_t yBits = OrderedBits(sortY) >> 9; // top 23 bits keep ~5 significant digits
+	return (layerBits << 56)
+		| (static_cast<uint64_t>(foreground) << 55)
+		| (yBits << 32)
+		| (static_cast<uint64_t>(shaderSlot) << 16)
+		| textureSlot;
+}
+
+void RenderQueue::Begin() {
+	commands.clear();
+	order.clear();
+	shaderSlots.clear();
+	textureSlots.clear();
+	textureSlotLookup.clear();
+	textures.Clear();
+}
+
+uint16_t RenderQueue::GetShaderSlot(GLuint program) {
+	// Only a handful of programs per frame, a linear scan beats hashing
+	for (size_t i = 0; i < shaderSlots.size(); ++i) {
+		if (shaderSlots[i] == program) return static_cast<uint16_t>(i);
+	}
+	shaderSlots.push_back(program);
+	return static_cast<uint16_t>(std::min<size_t>(shaderSlots.size() - 1, 0xFFFF));
+}
+
+uint16_t RenderQueue::GetTextureSlot(GLuint texture) {
+	auto [it, inserted] = textureSlotLookup.try_emplace(texture, static_cast<uint16_t>(std::min<size_t>(textureSlots.size(), 0xFFFF)));
+	if (inserted) textureSlots.push_back(texture);
+	return it->second;
+}
+
+GLuint SharedTextureTable::Resolve(const DelusiveTexture& texture) {
+	if (!texture.texture) return 0;
+	return byPath.try_emplace(texture.texturePath, texture.texture->ID).first->second;
+}
+
+// LSD radix sort over the keys, 8 bits per pass. Passes where every key shares the byte are skipped,
+// which is most of them when layers and programs do not vary.
+void RenderQueue::Sort() {
+	auto start = std::chrono::steady_clock::now();
+	const size_t count = commands.size();
+
+	keys.resize(count);
+	scratchKeys.resize(count);
+	order.resize(count);
+	scratchOrder.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		keys[i] = commands[i].key;
+		order[i] = static_cast<uint32_t>(i);
+	}
+
+	for (int shift = 0; shift < 64 && count > 1; shift += 8) {
+		size_t offsets[256] = {};
+		for (uint64_t key : keys) ++offsets[(key >> shift) & 0xFF];
+		if (offsets[(keys[0] >> shift) & 0xFF] == count) continue;
+
+		size_t total = 0;
+		for (size_t& offset : offsets) {
+			const size_t bucket = offset;
+			offset = total;
+			total += bucket;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			const size_t destination = offsets[(keys[i] >> shift) & 0xFF]++;
+			scratchKeys[destination] = keys[i];
+			scratchOrder[destination] = order[i];
+		}
+		keys.swap(scratchKeys);
+		order.swap(scratchOrder);
+	}
+
+	stats = Stats{};
+	stats.commands = static_cast<int>(count);
+	stats.sortMs = MillisecondsSince(start);
+}
+
+void RenderQueue::Execute(const glm::mat4& view, const glm::mat4& projection) {
+	GLuint boundProgram = 0, boundVAO = 0, boundTexture = 0;
+	GLint modelLocation = -1;
+
+	glActiveTexture(GL_TEXTURE0);
+	for (uint32_t index : order) {
+		const Command& command = commands[index];
+
+		if (command.program != boundProgram) {
+			glUseProgram(command.program);
+			boundProgram = command.program;
+			++stats.programBinds;
+
+			// Per-program uniforms are set once per bind instead of once per draw
+			glUniform1i(glGetUniformLocation(command.program, "tex"), 0);
+			glUniformMatrix4fv(glGetUniformLocation(command.program, "view"), 1, GL_FALSE, &view[0][0]);
+			glUniformMatrix4fv(glGetUniformLocation(command.program, "projection"), 1, GL_FALSE, &projection[0][0]);
+			modelLocation = glGetUniformLocation(command.program, "model");
+		}
+		else {
+			++stats.elidedBinds;
+		}
+
+		if (command.vao != boundVAO) {
+			glBindVertexArray(command.vao);
+			boundVAO = command.vao;
+			++stats.vaoBinds;
+		}
+		else {
+			++stats.elidedBinds;
+		}
+
+		if (command.texture != boundTexture) {
+			glBindTexture(GL_TEXTURE_2D, command.texture);
+			boundTexture = command.texture;
+			++stats.textureBinds;
+		}
+		else {
+			++stats.elidedBinds;
+		}
+
+		glUniformMatrix4fv(modelLocation, 1, GL_FALSE, &command.model[0][0]);
+		glDrawArrays(GL_TRIANGLES, command.firstVertex, command.vertexCount);
+		++stats.drawCalls;
+	}
+	glBindVertexArray(0);
+}
+
+void RenderQueue::ExecuteCommand(const Command& command, const glm::mat4& view, const glm::mat4& projection) {
+	glUseProgram(command.program);
+	glUniform1i(glGetUniformLocation(command.program, "tex"), 0);
+	glUniformMatrix4fv(glGetUniformLocation(command.program, "view"), 1, GL_FALSE, &view[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(command.program, "projection"), 1, GL_FALSE, &projection[0][0]);
+	glUniformMatrix4fv(glGetUniformLocation(command.program, "model"), 1, GL_FALSE, &command.model[0][0]);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindVertexArray(command.vao);
+	glBindTexture(GL_TEXTURE_2D, command.texture);
+	glDrawArrays(GL_TRIANGLES, command.firstVertex, command.vertexCount);
+	glBindVertexArray(0);
+
+	++stats.programBinds;
+	++stats.vaoBinds;
+	++stats.textureBinds;
+	++stats.drawCalls;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Shader.h"
+
+struct DelusiveTexture;
+
+//Every sprite loads its own copy of an image, so the first texture seen for a path stands in for the rest.
+//Sharing one name per path is what lets sprites of the same image batch together.
+class SharedTextureTable {
+public:
+	GLuint Resolve(const DelusiveTexture&);
+	void Clear() { byPath.clear(); }
+
+private:
+	std::unordered_map<std::string, GLuint> byPath;
+};
+
+//Records world draws as commands with 64-bit sort keys, radix-sorts them and replays them
+//while skipping program, vertex array and texture binds that would not change GL state.
+//Key layout, high to low: layer (8) | foreground (1) | y (23) | shader slot (16) | texture slot (16)
+class RenderQueue {
+public:
+	struct Command {
+		uint64_t key;
+		GLuint program;
+		GLuint vao;
+		GLuint texture;
+		GLsizei vertexCount;
+		glm::mat4 model;
+		GLint firstVertex = 0;  // baked static batches draw a range of a shared buffer
+	};
+
+	struct Stats {
+		int commands = 0;
+		int drawCalls = 0;
+		int programBinds = 0;
+		int vaoBinds = 0;
+		int textureBinds = 0;
+		int elidedBinds = 0;
+		float sortMs = 0.0f;
+	};
+
+	RenderQueue() = default;
+	~RenderQueue();
+	RenderQueue(const RenderQueue&) = delete;
+	RenderQueue& operator=(const RenderQueue&) = delete;
+
+	void Init();
+	void Shutdown();
+
+	static uint64_t MakeKey(int layer, bool foreground, float sortY, uint16_t shaderSlot, uint16_t textureSlot);
+
+	void Begin();
+	void Push(const Command& command) { commands.push_back(command); }
+	void Sort();
+	void Execute(const glm::mat4& view, const glm::mat4& projection);
+	//Draws a single command without state tracking, for callers that replay the order themselves
+	void ExecuteCommand(const Command&, const glm::mat4& view, const glm::mat4& projection);
+
+	//Dense per-frame ids so GL names fit in the key
+	uint16_t GetShaderSlot(GLuint program);
+	uint16_t GetTextureSlot(GLuint texture);
+	//Shared GL name for the texture's path this frame, see SharedTextureTable
+	GLuint ResolveTexture(const DelusiveTexture& texture) { return textures.Resolve(texture); }
+
+	//Shared sprite program and unit quad used by recorded sprites
+	GLuint GetSpriteProgram() const { return spriteShader ? spriteShader->GetID() : 0; }
+	GLuint GetQuadVAO() const { return quadVAO; }
+
+	//Commands in recording order, and their indices after Sort
+	const std::vector<Command>& GetCommands() const { return commands; }
+	const std::vector<uint32_t>& GetOrder() const { return order; }
+	const Stats& GetStats() const { return stats; }
+
+private:
+	std::unique_ptr<Shader> spriteShader;
+	GLuint quadVAO = 0;
+	GLuint quadVBO = 0;
+
+	std::vector<Command> commands;
+	std::vector<uint32_t> order;
+	std::vector<uint32_t> scratchOrder;
+	std::vector<uint64_t> keys;
+	std::vector<uint64_t> scratchKeys;
+
+	std::vector<GLuint> shaderSlots;
+	std::vector<GLuint> textureSlots;
+	std::unordered_map<GLuint, uint16_t> textureSlotLookup;
+	SharedTextureTable textures;
+
+	Stats stats;
+};
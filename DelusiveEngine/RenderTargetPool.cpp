@@ -0,0 +1,126 @@
+#include "RenderTargetPool.h"
+#include <iostream>
+
+namespace {
+	uint64_t BucketKey(int width, int height) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) | static_cast<uint32_t>(height);
+	}
+}
+
+RenderTargetPool::~RenderTargetPool() {
+	Shutdown();
+}
+
+int RenderTargetPool::BucketSize(int size) {
+	int bucket = MinSize;
+	while (bucket < size) bucket <<= 1;
+	return bucket;
+}
+
+bool RenderTargetPool::Create(RenderTarget& target) {
+	glGenFramebuffers(1, &target.framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+
+	glGenTextures(1, &target.texture);
+	glBindTexture(GL_TEXTURE_2D, target.texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, target.width, target.height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+
+	glGenRenderbuffers(1, &target.depthStencil);
+	glBindRenderbuffer(GL_RENDERBUFFER, target.depthStencil);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, target.width, target.height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthStencil);
+
+	const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (!complete) {
+		std::cerr << "[RenderTargetPool] Framebuffer not complete!" << std::endl;
+	}
+	return complete;
+}
+
+void RenderTargetPool::Destroy(RenderTarget& target) {
+	if (target.depthStencil) glDeleteRenderbuffers(1, &target.depthStencil);
+	if (target.texture) glDeleteTextures(1, &target.texture);
+	if (target.framebuffer) glDeleteFramebuffers(1, &target.framebuffer);
+	target.framebuffer = target.texture = target.depthStencil = 0;
+}
+
+RenderTarget* RenderTargetPool::Acquire(int width, int height) {
+	const int bucketWidth = BucketSize(width);
+	const int bucketHeight = BucketSize(height);
+	auto& bucket = buckets[BucketKey(bucketWidth, bucketHeight)];
+
+	for (auto& entry : bucket) {
+		if (!entry.inUse) {
+			entry.inUse = true;
+			entry.idleFrames = 0;
+			stats.inUse++;
+			stats.reused++;
+			return entry.target.get();
+		}
+	}
+
+	auto target = std::make_unique<RenderTarget>();
+	target->width = bucketWidth;
+	target->height = bucketHeight;
+	if (!Create(*target)) {
+		Destroy(*target);
+		return nullptr;
+	}
+
+	stats.live++;
+	stats.inUse++;
+	stats.created++;
+	bucket.push_back({ std::move(target), true, 0 });
+	return bucket.back().target.get();
+}
+
+void RenderTargetPool::Release(RenderTarget* target) {
+	if (!target) return;
+
+	auto it = buckets.find(BucketKey(target->width, target->height));
+	if (it == buckets.end()) return;
+	for (auto& entry : it->second) {
+		if (entry.target.get() == target && entry.inUse) {
+			entry.inUse = false;
+			entry.idleFrames = 0;
+			stats.inUse--;
+			return;
+		}
+	}
+}
+
+void RenderTargetPool::EndFrame() {
+	for (auto it = buckets.begin(); it != buckets.end();) {
+		auto& bucket = it->second;
+		for (size_t i = 0; i < bucket.size();) {
+			Entry& entry = bucket[i];
+			if (!entry.inUse && ++entry.idleFrames > MaxIdleFrames) {
+				Destroy(*entry.target);
+				stats.live--;
+				stats.destroyed++;
+				bucket[i] = std::move(bucket.back());
+				bucket.pop_back();
+			}
+			else {
+				++i;
+			}
+		}
+		it = bucket.empty() ? buckets.erase(it) : std::next(it);
+	}
+}
+
+void RenderTargetPool::Shutdown() {
+	for (auto& [key, bucket] : buckets) {
+		for (auto& entry : bucket) {
+			Destroy(*entry.target);
+			stats.destroyed++;
+		}
+	}
+	buckets.clear();
+	stats.live = 0;
+	stats.inUse = 0;
+}
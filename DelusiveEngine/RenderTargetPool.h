@@ -0,0 +1,60 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//Offscreen color texture with a depth/stencil buffer, owned by a RenderTargetPool
+struct RenderTarget {
+	GLuint framebuffer = 0;
+	GLuint texture = 0;
+	GLuint depthStencil = 0;
+	int width = 0;
+	int height = 0;
+};
+
+//Hands out render targets from power of two size buckets. Released targets keep their GL objects
+//and go back to their bucket, so redrawing a preview every frame reuses the same framebuffer.
+//Targets left unused for MaxIdleFrames are deleted by EndFrame.
+class RenderTargetPool {
+public:
+	static constexpr int MinSize = 16;
+	static constexpr int MaxIdleFrames = 300;
+
+	struct Stats {
+		int live = 0;        // targets holding GL objects
+		int inUse = 0;
+		int created = 0;     // totals since startup
+		int reused = 0;
+		int destroyed = 0;
+	};
+
+	RenderTargetPool() = default;
+	~RenderTargetPool();
+	RenderTargetPool(const RenderTargetPool&) = delete;
+	RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+	//At least width x height, rounded up to the bucket size. Returns nullptr if the framebuffer is incomplete
+	RenderTarget* Acquire(int width, int height);
+	void Release(RenderTarget*);
+	//Ages free targets, call once per frame
+	void EndFrame();
+	void Shutdown();
+
+	const Stats& GetStats() const { return stats; }
+
+private:
+	struct Entry {
+		std::unique_ptr<RenderTarget> target;
+		bool inUse = false;
+		int idleFrames = 0;
+	};
+
+	static int BucketSize(int size);
+	static bool Create(RenderTarget&);
+	static void Destroy(RenderTarget&);
+
+	std::unordered_map<uint64_t, std::vector<Entry>> buckets;
+	Stats stats;
+};
@@ -0,0 +1,56 @@
+#include "RigidbodyComponent.h"
+#include "DelusiveRegistry.h"
+
+RigidbodyComponent::RigidbodyComponent() {
+	name = "New Rigidbody";
+	RegisterProperties();
+}
+
+void RigidbodyComponent::RegisterProperties() {
+	Component::RegisterProperties();
+	registry->Register("bodyType", reinterpret_cast<int*>(&bodyType));
+	registry->Register("mass", &mass);
+	registry->Register("linearDamping", &linearDamping);
+	registry->Register("restitution", &restitution);
+	registry->Register("velocity", &velocity);
+	registry->Register("canSleep", &canSleep);
+}
+
+std::unique_ptr<Component> RigidbodyComponent::Clone() const {
+	auto copy = std::make_unique<RigidbodyComponent>();
+	copy->SetName(GetName());
+	copy->SetEnabled(IsEnabled());
+	copy->bodyType = bodyType;
+	copy->mass = mass;
+	copy->linearDamping = linearDamping;
+	copy->restitution = restitution;
+	copy->velocity = velocity;
+	copy->canSleep = canSleep;
+	return copy;
+}
+
+void RigidbodyComponent::SetVelocity(glm::vec2 _velocity) {
+	velocity = _velocity;
+	if (velocity != glm::vec2(0.0f)) WakeUp();
+}
+
+void RigidbodyComponent::AddForce(glm::vec2 _force) {
+	force += _force;
+	WakeUp();
+}
+
+void RigidbodyComponent::AddImpulse(glm::vec2 impulse) {
+	velocity += impulse * GetInverseMass();
+	WakeUp();
+}
+
+void RigidbodyComponent::Sleep(glm::vec2 position) {
+	awake = false;
+	velocity = glm::vec2(0.0f);
+	sleepPosition = position;
+}
+
+float RigidbodyComponent::GetInverseMass() const {
+	if (bodyType != BodyType::Dynamic || mass <= 0.0f) return 0.0f;
+	return 1.0f / mass;
+}
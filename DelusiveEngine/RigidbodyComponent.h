@@ -0,0 +1,68 @@
+#pragma once
+#include "Component.h"
+#include <glm/glm.hpp>
+
+enum class BodyType {
+	Dynamic,   // moved by its velocity and pushed by contacts
+	Kinematic, // moved by its velocity, never pushed
+	Static     // never moves
+};
+
+//Mass and velocity for an agent. PhysicsSystem integrates every body in one pass per step
+//and resolves contacts between their Solid colliders with an impulse solver.
+class RigidbodyComponent : public Component {
+public:
+	RigidbodyComponent();
+
+	std::unique_ptr<Component> Clone() const override;
+	void RegisterProperties() override;
+	void Update(float) override {}
+
+	const char* GetType() const override {
+		return "RigidbodyComponent";
+	}
+
+	BodyType GetBodyType() const { return bodyType; }
+	void SetBodyType(BodyType type) { bodyType = type; }
+	float GetMass() const { return mass; }
+	void SetMass(float _mass) { mass = _mass; }
+	//Zero for kinematic and static bodies
+	float GetInverseMass() const;
+	float GetLinearDamping() const { return linearDamping; }
+	void SetLinearDamping(float damping) { linearDamping = damping; }
+	float GetRestitution() const { return restitution; }
+	void SetRestitution(float _restitution) { restitution = _restitution; }
+
+	glm::vec2 GetVelocity() const { return velocity; }
+	void SetVelocity(glm::vec2 _velocity);
+
+	//Forces are applied over the next step and then cleared, impulses change the velocity right away
+	void AddForce(glm::vec2 _force);
+	void AddImpulse(glm::vec2 impulse);
+	glm::vec2 GetForce() const { return force; }
+	void ClearForce() { force = glm::vec2(0.0f); }
+
+	//Bodies that stay slow for a while are put to sleep by the physics step and skipped until a
+	//contact, a velocity, a force or a move of the agent wakes them
+	bool IsAwake() const { return awake; }
+	void WakeUp() { awake = true; sleepTime = 0.0f; }
+	void Sleep(glm::vec2 position);
+	bool CanSleep() const { return canSleep; }
+	void SetCanSleep(bool _canSleep) { canSleep = _canSleep; }
+	float GetSleepTime() const { return sleepTime; }
+	void SetSleepTime(float time) { sleepTime = time; }
+	//Where the agent was when the body fell asleep
+	glm::vec2 GetSleepPosition() const { return sleepPosition; }
+
+private:
+	BodyType bodyType = BodyType::Dynamic;
+	float mass = 1.0f;
+	float linearDamping = 0.0f;
+	float restitution = 0.0f;
+	glm::vec2 velocity = glm::vec2(0.0f);
+	glm::vec2 force = glm::vec2(0.0f);
+	bool canSleep = true;
+	bool awake = true;
+	float sleepTime = 0.0f;
+	glm::vec2 sleepPosition = glm::vec2(0.0f);
+};
@@ -0,0 +1,255 @@
+#include "RigidbodySolver.h"
+#include "RigidbodyComponent.h"
+#include "Agent.h"
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+namespace {
+	constexpr float RestitutionThreshold = 1.0f; // slower approaches do not bounce
+	constexpr float LinearSlop = 0.005f;         // overlap left alone so resting contacts stay touching
+	constexpr float PositionCorrection = 0.2f;   // fraction of the remaining overlap removed per iteration
+	constexpr float MaxCorrection = 0.2f;
+	constexpr float SleepTolerance = 0.05f;      // units per second a body may drift and still count as still
+	constexpr float TimeToSleep = 0.5f;
+}
+
+void RigidbodySolver::Reset() {
+	bodies.clear();
+	owners.clear();
+	positionX.clear(); positionY.clear();
+	startX.clear(); startY.clear();
+	velocityX.clear(); velocityY.clear();
+	forceX.clear(); forceY.clear();
+	inverseMass.clear();
+	damping.clear();
+	restitution.clear();
+	moves.clear();
+	awake.clear();
+	canSleep.clear();
+	sleepTime.clear();
+	constraints.clear();
+	awakeCount = 0;
+	islandCount = 0;
+
+	bodies.push_back(nullptr);
+	owners.push_back(nullptr);
+	positionX.push_back(0.0f); positionY.push_back(0.0f);
+	startX.push_back(0.0f); startY.push_back(0.0f);
+	velocityX.push_back(0.0f); velocityY.push_back(0.0f);
+	forceX.push_back(0.0f); forceY.push_back(0.0f);
+	inverseMass.push_back(0.0f);
+	damping.push_back(0.0f);
+	restitution.push_back(0.0f);
+	moves.push_back(0);
+	awake.push_back(0);
+	canSleep.push_back(1);
+	sleepTime.push_back(0.0f);
+}
+
+int RigidbodySolver::AddBody(RigidbodyComponent* body, Agent* owner) {
+	glm::vec2 position = owner->transform.position;
+	// Anything that moved the agent since it fell asleep wakes it
+	if (!body->IsAwake() && position != body->GetSleepPosition()) {
+		body->WakeUp();
+	}
+
+	bool isAwake = body->IsAwake();
+	glm::vec2 velocity = body->GetBodyType() == BodyType::Static || !isAwake ? glm::vec2(0.0f) : body->GetVelocity();
+	glm::vec2 force = body->GetForce();
+	body->ClearForce();
+
+	bodies.push_back(body);
+	owners.push_back(owner);
+	positionX.push_back(position.x); positionY.push_back(position.y);
+	startX.push_back(position.x); startY.push_back(position.y);
+	velocityX.push_back(velocity.x); velocityY.push_back(velocity.y);
+	forceX.push_back(force.x); forceY.push_back(force.y);
+	inverseMass.push_back(isAwake ? body->GetInverseMass() : 0.0f);
+	damping.push_back(std::max(0.0f, body->GetLinearDamping()));
+	restitution.push_back(std::clamp(body->GetRestitution(), 0.0f, 1.0f));
+	moves.push_back(isAwake && body->GetBodyType() != BodyType::Static);
+	awake.push_back(isAwake);
+	canSleep.push_back(body->CanSleep());
+	sleepTime.push_back(body->GetSleepTime());
+	awakeCount += isAwake;
+	return static_cast<int>(bodies.size()) - 1;
+}
+
+void RigidbodySolver::Wake(int body) {
+	if (body == WorldBody || awake[body]) return;
+
+	RigidbodyComponent* component = bodies[body];
+	component->WakeUp();
+	awake[body] = 1;
+	sleepTime[body] = 0.0f;
+	inverseMass[body] = component->GetInverseMass();
+	moves[body] = component->GetBodyType() != BodyType::Static;
+	++awakeCount;
+}
+
+// Masses are read when the solve starts, so bodies woken by later contacts of the same step take part
+void RigidbodySolver::AddContact(int bodyA, int bodyB, glm::vec2 normal, float depth) {
+	ContactConstraint constraint;
+	constraint.a = bodyA;
+	constraint.b = bodyB;
+	constraint.normal = normal;
+	constraint.depth = depth;
+	constraint.normalMass = 0.0f;
+	constraint.velocityBias = 0.0f;
+	constraint.normalImpulse = 0.0f;
+	constraints.push_back(constraint);
+}
+
+void RigidbodySolver::IntegrateVelocities(float deltaTime) {
+	const int count = static_cast<int>(bodies.size());
+	for (int i = 1; i < count; ++i) {
+		// Implicit damping stays stable for any damping * deltaTime
+		float scale = 1.0f / (1.0f + deltaTime * damping[i]);
+		velocityX[i] = (velocityX[i] + forceX[i] * inverseMass[i] * deltaTime) * scale;
+		velocityY[i] = (velocityY[i] + forceY[i] * inverseMass[i] * deltaTime) * scale;
+	}
+
+	// Bounce targets come from the approach speed before any impulse is applied
+	for (ContactConstraint& c : constraints) {
+		float inverseMassSum = inverseMass[c.a] + inverseMass[c.b];
+		c.normalMass = inverseMassSum > 0.0f ? 1.0f / inverseMassSum : 0.0f;
+
+		float relativeX = velocityX[c.b] - velocityX[c.a];
+		float relativeY = velocityY[c.b] - velocityY[c.a];
+		float normalVelocity = relativeX * c.normal.x + relativeY * c.normal.y;
+		float bounce = std::max(restitution[c.a], restitution[c.b]);
+		if (normalVelocity < -RestitutionThreshold) {
+			c.velocityBias = -bounce * normalVelocity;
+		}
+	}
+}
+
+// Sequential impulses: each pass drives the normal velocity of every contact to its target,
+// clamping the accumulated impulse so contacts only ever push
+void RigidbodySolver::SolveVelocities(int iterations) {
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		for (ContactConstraint& c : constraints) {
+			float relativeX = velocityX[c.b] - velocityX[c.a];
+			float relativeY = velocityY[c.b] - velocityY[c.a];
+			float normalVelocity = relativeX * c.normal.x + relativeY * c.normal.y;
+
+			float lambda = c.normalMass * (c.velocityBias - normalVelocity);
+			float accumulated = std::max(c.normalImpulse + lambda, 0.0f);
+			lambda = accumulated - c.normalImpulse;
+			c.normalImpulse = accumulated;
+
+			float impulseX = lambda * c.normal.x;
+			float impulseY = lambda * c.normal.y;
+			velocityX[c.a] -= impulseX * inverseMass[c.a];
+			velocityY[c.a] -= impulseY * inverseMass[c.a];
+			velocityX[c.b] += impulseX * inverseMass[c.b];
+			velocityY[c.b] += impulseY * inverseMass[c.b];
+		}
+	}
+}
+
+void RigidbodySolver::IntegratePositions(float deltaTime) {
+	const int count = static_cast<int>(bodies.size());
+	for (int i = 1; i < count; ++i) {
+		float step = moves[i] ? deltaTime : 0.0f;
+		positionX[i] += velocityX[i] * step;
+		positionY[i] += velocityY[i] * step;
+	}
+}
+
+// Removes the overlap the velocity pass left behind. Penetration is tracked from the depth measured
+// at the start of the step and how far each body has moved since, so no shapes are re-tested.
+void RigidbodySolver::SolvePositions(int iterations) {
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		bool resolved = true;
+		for (const ContactConstraint& c : constraints) {
+			float movedX = (positionX[c.b] - startX[c.b]) - (positionX[c.a] - startX[c.a]);
+			float movedY = (positionY[c.b] - startY[c.b]) - (positionY[c.a] - startY[c.a]);
+			float penetration = c.depth - (movedX * c.normal.x + movedY * c.normal.y) - LinearSlop;
+			if (penetration <= 0.0f) continue;
+			resolved = false;
+
+			float correction = std::min(PositionCorrection * penetration, MaxCorrection) * c.normalMass;
+			float correctionX = correction * c.normal.x;
+			float correctionY = correction * c.normal.y;
+			positionX[c.a] -= correctionX * inverseMass[c.a];
+			positionY[c.a] -= correctionY * inverseMass[c.a];
+			positionX[c.b] += correctionX * inverseMass[c.b];
+			positionY[c.b] += correctionY * inverseMass[c.b];
+		}
+		if (resolved) break;
+	}
+}
+
+int RigidbodySolver::FindIsland(int body) {
+	while (islandParents[body] != body) {
+		islandParents[body] = islandParents[islandParents[body]]; // path halving
+		body = islandParents[body];
+	}
+	return body;
+}
+
+void RigidbodySolver::UpdateSleep(float deltaTime) {
+	const int count = static_cast<int>(bodies.size());
+	const float toleranceSq = SleepTolerance * SleepTolerance;
+	const float driftSq = toleranceSq * deltaTime * deltaTime;
+
+	// Position correction moves bodies without touching their velocity, so displacement counts too
+	std::vector<unsigned char> moving(count, 0);
+	for (int i = 1; i < count; ++i) {
+		float speedSq = velocityX[i] * velocityX[i] + velocityY[i] * velocityY[i];
+		float driftX = positionX[i] - startX[i];
+		float driftY = positionY[i] - startY[i];
+		moving[i] = speedSq > toleranceSq || driftX * driftX + driftY * driftY > driftSq;
+
+		if (!awake[i]) continue;
+		sleepTime[i] = canSleep[i] && !moving[i] ? sleepTime[i] + deltaTime : 0.0f;
+	}
+
+	// Islands only join through bodies the solver can push, the world and kinematic bodies would
+	// otherwise chain every resting body into one island
+	islandParents.resize(count);
+	std::iota(islandParents.begin(), islandParents.end(), 0);
+	for (const ContactConstraint& c : constraints) {
+		if (inverseMass[c.a] > 0.0f && inverseMass[c.b] > 0.0f) {
+			islandParents[FindIsland(c.a)] = FindIsland(c.b);
+		}
+		// Something moving pushes on the other side and keeps it up
+		if (moving[c.a]) sleepTime[c.b] = 0.0f;
+		if (moving[c.b]) sleepTime[c.a] = 0.0f;
+	}
+
+	islandSleepTime.assign(count, FLT_MAX);
+	islandCount = 0;
+	for (int i = 1; i < count; ++i) {
+		if (!awake[i]) continue;
+		int island = FindIsland(i);
+		if (island == i) ++islandCount;
+		islandSleepTime[island] = std::min(islandSleepTime[island], sleepTime[i]);
+	}
+
+	// A whole island sleeps together or not at all
+	for (int i = 1; i < count; ++i) {
+		if (!awake[i] || islandSleepTime[FindIsland(i)] < TimeToSleep) continue;
+		awake[i] = 0;
+		velocityX[i] = 0.0f;
+		velocityY[i] = 0.0f;
+		--awakeCount;
+	}
+}
+
+void RigidbodySolver::WriteBack() {
+	const int count = static_cast<int>(bodies.size());
+	for (int i = 1; i < count; ++i) {
+		glm::vec2 position(positionX[i], positionY[i]);
+		owners[i]->transform.position = position;
+
+		if (!awake[i]) {
+			bodies[i]->Sleep(position);
+			continue;
+		}
+		if (moves[i]) bodies[i]->SetVelocity(glm::vec2(velocityX[i], velocityY[i]));
+		bodies[i]->SetSleepTime(sleepTime[i]);
+	}
+}
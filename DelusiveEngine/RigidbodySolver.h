@@ -0,0 +1,70 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+
+class Agent;
+class RigidbodyComponent;
+
+//Per-step body state in structure-of-arrays form plus the contact constraints between bodies.
+//Index 0 is a world body with zero inverse mass that stands in for static geometry and
+//agents without a rigidbody, so the solver loops never branch on a missing side.
+class RigidbodySolver {
+public:
+	static constexpr int WorldBody = 0;
+
+	//Drops last step's bodies and constraints
+	void Reset();
+	int AddBody(RigidbodyComponent*, Agent*);
+	//normal points from a to b, depth is the overlap along it
+	void AddContact(int bodyA, int bodyB, glm::vec2 normal, float depth);
+
+	void IntegrateVelocities(float deltaTime);
+	void SolveVelocities(int iterations);
+	void IntegratePositions(float deltaTime);
+	void SolvePositions(int iterations);
+	//Groups contact-connected bodies into islands and puts islands that have stayed still long enough to sleep
+	void UpdateSleep(float deltaTime);
+	//Copies positions back to the agents and velocities and sleep state back to the components
+	void WriteBack();
+
+	//Sleeping bodies keep a zero inverse mass and do not integrate until woken
+	bool IsAwake(int body) const { return awake[body] != 0; }
+	void Wake(int body);
+
+	int GetBodyCount() const { return static_cast<int>(bodies.size()) - 1; }
+	int GetAwakeCount() const { return awakeCount; }
+	int GetSleepingCount() const { return GetBodyCount() - awakeCount; }
+	int GetIslandCount() const { return islandCount; }
+	int GetContactCount() const { return static_cast<int>(constraints.size()); }
+
+private:
+	struct ContactConstraint {
+		int a, b;
+		glm::vec2 normal;
+		float depth;
+		float normalMass;      // 1 / (inverse mass a + inverse mass b), zero when neither side can move
+		float velocityBias;    // restitution target for the normal velocity
+		float normalImpulse;   // accumulated over iterations, never negative
+	};
+
+	std::vector<RigidbodyComponent*> bodies;
+	std::vector<Agent*> owners;
+	std::vector<float> positionX, positionY;
+	std::vector<float> startX, startY; // where the contacts were measured
+	std::vector<float> velocityX, velocityY;
+	std::vector<float> forceX, forceY;
+	std::vector<float> inverseMass;
+	std::vector<float> damping;
+	std::vector<float> restitution;
+	std::vector<unsigned char> moves; // kinematic and dynamic bodies integrate, static ones do not
+	std::vector<unsigned char> awake;
+	std::vector<unsigned char> canSleep;
+	std::vector<float> sleepTime;
+	std::vector<ContactConstraint> constraints;
+	std::vector<int> islandParents; // union-find over bodies, rebuilt by UpdateSleep
+	std::vector<float> islandSleepTime;
+	int awakeCount = 0;
+	int islandCount = 0;
+
+	int FindIsland(int body);
+};
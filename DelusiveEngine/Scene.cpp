@@ -1,6 +1,8 @@
 #include "Scene.h"
 #include "GameManager.h"
 #include "DelusiveAgents.h"
+#include <algorithm>
+#include <limits>
 
 //TODO: If there is no camera, handle properly
 Scene::Scene(DelusiveRenderer& _renderer)
@@ -26,7 +28,7 @@ std::unique_ptr<Scene> Scene::Clone() {
 	}
 
 	for (const auto& sys : systems) {
-		cloned->systems.push_back(std::unique_ptr<SceneSystem>(sys->Clone()));
+		cloned->AddSystem(sys->Clone());
 	}
 
 	return cloned;
@@ -47,6 +49,8 @@ void Scene::CloneInto(Scene& container) const {
 		}
 	}
 
+	container.physicsSystem.GetLayers() = physicsSystem.GetLayers();
+
 	// Clone Systems
 	for (const auto& system : systems) {
 		if (system) {
@@ -83,8 +87,10 @@ ScriptManager& Scene::GetScriptManager() const {
 void Scene::AddAgent(std::unique_ptr<Agent> _agent) {
 	_agent->SetID(nextAgentID);
 	_agent->SetScene(this);
+	Agent& added = *_agent;
 	agents.push_back(std::move(_agent));
 	nextAgentID++;
+	MarkAgentEdited(added);
 }
 
 Agent* Scene::FetchPlayer() {
@@ -102,11 +108,37 @@ std::vector<std::unique_ptr<Agent>>& Scene::GetAgents() {
 	return agents;
 }
 
+void Scene::RemoveAgent(Agent* agent) {
+	auto it = std::find_if(agents.begin(), agents.end(),
+		[agent](const std::unique_ptr<Agent>& a) { return a.get() == agent; });
+	if (it == agents.end()) return;
+	for (auto& sys : systems) {
+		sys->OnAgentRemoved(*agent);
+	}
+	agents.erase(it);
+	// The culling grids hold pointers into the removed agent
+	drawCacheDirty = true;
+}
+
+void Scene::MarkAgentEdited(Agent& agent) {
+	drawCacheDirty = true;
+	for (auto& sys : systems) {
+		sys->OnAgentEdited(agent);
+	}
+}
+
 void Scene::ClearAgents() {
+	for (auto& agent : agents) {
+		for (auto& sys : systems) {
+			sys->OnAgentRemoved(*agent);
+		}
+	}
 	agents.clear();
+	drawCacheDirty = true;
 }
 
 void Scene::AddSystem(std::unique_ptr<SceneSystem> sys) {
+	sys->SetScene(this);
 	systems.push_back(std::move(sys));
 }
 
@@ -114,16 +146,6 @@ std::vector<std::unique_ptr<SceneSystem>>& Scene::GetSystems() {
 	return systems;
 }
 
-template<typename T>
-T* Scene::GetSystem() {
-	for (auto& sys : systems) {
-		if (auto ptr = dynamic_cast<T*>(sys.get())) {
-			return ptr;
-		}
-	}
-	return nullptr;
-}
-
 void Scene::Update(float deltaTime) {
 	if (!camera) {
 		for (auto& agent : agents) {
@@ -146,49 +168,197 @@ void Scene::Update(float deltaTime) {
 		agent->Update(deltaTime);
 	}
 
-	physicsSystem.HandleCollisions(agents);
+	physicsSystem.HandleCollisions(agents, deltaTime);
+	physicsSystem.DispatchContacts();
+}
+
+bool Scene::IsStaticForCulling(Agent& agent) {
+	if (!dynamic_cast<EnvironmentAgent*>(&agent)) return false;
+	// A rigidbody can still move an environment agent unless it is static
+	RigidbodyComponent* body = agent.GetComponentOfType<RigidbodyComponent>();
+	return !body || body->GetBodyType() == BodyType::Static;
+}
+
+Zone Scene::ComputeViewRect(const glm::mat4& projection) {
+	const glm::mat4 inverse = glm::inverse(projection);
+	Zone view{ glm::vec2(std::numeric_limits<float>::max()), glm::vec2(-std::numeric_limits<float>::max()) };
+	const glm::vec2 corners[4] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+	for (const glm::vec2& c : corners) {
+		glm::vec4 w = inverse * glm::vec4(c, 0.0f, 1.0f);
+		glm::vec2 p = glm::vec2(w) / w.w;
+		view.min = glm::min(view.min, p);
+		view.max = glm::max(view.max, p);
+	}
+	return view;
+}
+
+void Scene::RebuildDrawCache() const {
+	staticSpriteGrid.Clear();
+	staticColliderGrid.Clear();
+	staticSprites.clear();
+	staticColliders.clear();
+	dynamicAgents.clear();
+	tilemaps.clear();
+	staticSpriteBaked.clear();
+	unbakedStaticSprites = 0;
+	unbakedLayers.reset();
+	staticBatch.Begin();
+
+	for (const auto& agent : agents) {
+		// Tilemaps cull their own chunks whether or not the agent moves
+		for (const TilemapComponent* tilemap : agent->GetComponentsOfType<TilemapComponent>()) {
+			tilemaps.push_back(tilemap);
+		}
+		if (!IsStaticForCulling(*agent)) {
+			dynamicAgents.push_back(agent.get());
+			continue;
+		}
+		// An animator can still move or swap a sprite, those keep drawing one by one
+		const bool bakeable = agent->GetComponentOfType<AnimatorComponent>() == nullptr;
+		const float sortY = agent->GetTransform().position.y;
+		for (SpriteComponent* sprite : agent->GetComponentsOfType<SpriteComponent>()) {
+			staticSpriteGrid.Insert(static_cast<int>(staticSprites.size()), sprite->GetWorldBounds());
+			staticSprites.push_back(sprite);
+
+			const bool baked = bakeable && sprite->IsEnabled() && sprite->Bake(staticBatch, sortY);
+			staticSpriteBaked.push_back(baked);
+			if (!baked) {
+				++unbakedStaticSprites;
+				unbakedLayers.set(StaticSpriteBatch::LayerSlot(sprite->GetRenderOrder(), sprite->isForeground));
+			}
+		}
+		for (const ColliderComponent* collider : agent->GetColliders()) {
+			staticColliderGrid.Insert(static_cast<int>(staticColliders.size()), collider->GetWorldBounds());
+			staticColliders.push_back(collider);
+		}
+	}
+
+	// Only chunks whose sprites changed are uploaded again
+	staticBatch.End();
+
+	drawCacheDirty = false;
 }
 
 void Scene::Draw(const ColliderRenderer& colRenderer, const glm::mat4& projection) const {
-	struct RenderEntry {
-		SpriteComponent* sprite;
-		float sortY;
-		bool isForeground;
+	// Sprites are recorded with sort keys (layer, foreground, y, shader, texture) and drawn after sorting
+	RenderQueue& renderQueue = renderer.GetRenderQueue();
+	renderQueue.Begin();
+
+	if (drawCacheDirty) {
+		RebuildDrawCache();
+	}
+
+	DrawStats stats;
+	stats.staticItems = staticSpriteGrid.GetItemCount() + staticColliderGrid.GetItemCount();
+
+	// Everything is visible when culling is off
+	Zone view{ glm::vec2(-std::numeric_limits<float>::max()), glm::vec2(std::numeric_limits<float>::max()) };
+	if (cullingEnabled) {
+		view = ComputeViewRect(projection);
+	}
+	const auto inView = [&view](const Zone& bounds) {
+		return bounds.min.x <= view.max.x && bounds.max.x >= view.min.x
+			&& bounds.min.y <= view.max.y && bounds.max.y >= view.min.y;
 	};
 
-	std::vector<RenderEntry> renderQueue;
-	renderQueue.reserve(agents.size() * 2); // Conservative estimate, avoids reallocations
+	// Layers that moving or unbaked sprites use need every sprite y-sorted, so baked sprites there are drawn one by one
+	StaticSpriteBatch::LayerMask sharedLayers = unbakedLayers;
+	if (!staticBatching) sharedLayers.set();
 
-	for (const auto& agent : agents) {
+	for (Agent* agent : dynamicAgents) {
 		const glm::vec2 agentPos = agent->GetTransform().position;
 
 		// Collect enabled sprites
 		for (SpriteComponent* sprite : agent->GetComponentsOfType<SpriteComponent>()) {
-			if (sprite->IsEnabled()) {
-				renderQueue.push_back({ sprite, agentPos.y, sprite->isForeground });
+			if (!sprite->IsEnabled()) continue;
+			sharedLayers.set(StaticSpriteBatch::LayerSlot(sprite->GetRenderOrder(), sprite->isForeground));
+			if (!inView(sprite->GetWorldBounds())) {
+				++stats.culledSprites;
+				continue;
 			}
+			sprite->Record(renderQueue, agentPos.y);
+			++stats.visibleSprites;
 		}
 
 		// Immediately draw enabled colliders (no sorting needed)
-		for (const ColliderComponent* collider : agent->GetComponentsOfType<ColliderComponent>()) {
-			if (collider->IsEnabled()) {
-				collider->Draw(colRenderer, projection);
+		for (const ColliderComponent* collider : agent->GetColliders()) {
+			if (!collider->IsEnabled()) continue;
+			if (!inView(collider->GetWorldBounds())) {
+				++stats.culledColliders;
+				continue;
 			}
+			collider->Draw(colRenderer, projection);
+			++stats.visibleColliders;
 		}
 	}
 
-	// Sort sprite draw order (foreground sprites on top, then lower Y = top)
-	std::sort(renderQueue.begin(), renderQueue.end(), [](const RenderEntry& a, const RenderEntry& b) {
-		if (a.isForeground != b.isForeground)
-			return !a.isForeground && b.isForeground;
-		return a.sortY < b.sortY;
+	// Static items outside the view are never visited, so their culled count is what the grid skipped.
+	// When every static sprite is drawn from a chunk the grid is not walked at all.
+	int staticHits = 0;
+	if (unbakedStaticSprites > 0 || (sharedLayers & staticBatch.GetLayers()).any()) {
+		staticSpriteGrid.Query(view, [&](int item) {
+			++staticHits;
+			SpriteComponent* sprite = staticSprites[item];
+			if (!sprite->IsEnabled()) return;
+			++stats.visibleSprites;
+			if (staticSpriteBaked[item]
+				&& !sharedLayers.test(StaticSpriteBatch::LayerSlot(sprite->GetRenderOrder(), sprite->isForeground))) {
+				return;
+			}
+			sprite->Record(renderQueue, sprite->GetOwner()->GetTransform().position.y);
 		});
+		stats.culledSprites += static_cast<int>(staticSprites.size()) - staticHits;
+	}
+	staticBatch.Record(renderQueue, view, sharedLayers);
+
+	for (const TilemapComponent* tilemap : tilemaps) {
+		if (!tilemap->IsEnabled()) continue;
+		tilemap->Record(renderQueue, view);
+		stats.visibleTileChunks += tilemap->GetStats().visibleChunks;
+		stats.uploadedTileChunks += tilemap->GetStats().uploadedChunks;
+	}
+
+	staticHits = 0;
+	staticColliderGrid.Query(view, [&](int item) {
+		++staticHits;
+		const ColliderComponent* collider = staticColliders[item];
+		if (!collider->IsEnabled()) return;
+		collider->Draw(colRenderer, projection);
+		++stats.visibleColliders;
+	});
+	stats.culledColliders += static_cast<int>(staticColliders.size()) - staticHits;
+	drawStats = stats;
+
+	// Sort sprite draw order (foreground sprites on top, then lower Y = top)
+	renderQueue.Sort();
 
 	// Draw sorted sprites
-	for (const RenderEntry& entry : renderQueue) {
-		entry.sprite->Draw(projection);
+	SpriteRenderer& spriteRenderer = renderer.GetSpriteRenderer();
+	if (spriteRenderer.IsInstancing()) {
+		const auto& commands = renderQueue.GetCommands();
+		spriteRenderer.Begin(projection);
+		for (uint32_t index : renderQueue.GetOrder()) {
+			const RenderQueue::Command& command = commands[index];
+			if (command.vao == renderQueue.GetQuadVAO()) {
+				spriteRenderer.Submit(command.texture, SpriteInstance::FromMatrix(command.model));
+				continue;
+			}
+			// Baked chunks keep their own buffer, draw them between instance runs
+			spriteRenderer.Flush();
+			renderQueue.ExecuteCommand(command, glm::mat4(1.0f), projection);
+		}
+		spriteRenderer.End();
+	}
+	else {
+		renderQueue.Execute(glm::mat4(1.0f), projection);
 	}
 
+	// Collider outlines, handles and system overlays were queued above, drawn over the sprites in one go
+	for (auto& system : systems) {
+		system->DrawDebug(projection);
+	}
+	renderer.GetDebugDraw().Flush(projection);
+
 	//Renderer::BeginUIRenderPass();
 	for (auto& system : systems) {
 		system->Draw(renderer.GetUIProjection());
@@ -203,14 +373,43 @@ void Scene::HandleInput(const PlayerInputState& input) {
 }
 
 void Scene::HandleMouse(const glm::vec2& worldMouse, bool mouseDown) {
+	// A tilemap in paint mode takes the mouse so strokes do not also drag agents
 	for (auto& agent : agents) {
+		for (TilemapComponent* tilemap : agent->GetComponentsOfType<TilemapComponent>()) {
+			if (tilemap->IsPainting()) {
+				tilemap->HandleMouse(worldMouse, mouseDown);
+				return;
+			}
+		}
+	}
+
+	// Editor picking only needs agents under the cursor or already being interacted with
+	physicsSystem.SyncAgentBounds(agents);
+	std::vector<Agent*> hovered;
+	physicsSystem.QueryAgentsAtPoint(worldMouse, hovered);
+	std::sort(hovered.begin(), hovered.end());
+
+	for (auto& agent : agents) {
+		if (agent->IsEditorMode() && !agent->IsInteracting()
+			&& !std::binary_search(hovered.begin(), hovered.end(), agent.get())) {
+			continue;
+		}
+		// Dragging an environment agent in the editor moves it out of its grid and nav cells,
+		// merely selecting or hovering one leaves both alone
+		const bool trackEdits = agent->IsEditorMode() && dynamic_cast<EnvironmentAgent*>(agent.get());
+		const uint64_t stamp = trackEdits ? agent->GetEditStamp() : 0;
 		agent->HandleMouse(worldMouse, mouseDown);
+		if (trackEdits && agent->GetEditStamp() != stamp) {
+			MarkAgentEdited(*agent);
+		}
 	}
 }
 
 void Scene::Clear() {
 	agents.clear();
 	systems.clear();
+	physicsSystem.Clear();
+	drawCacheDirty = true;
 	name = "New Scene";
 }
 
@@ -227,6 +426,8 @@ bool Scene::SaveToFile(const std::string& path) const {
 		agent->SaveToFile(out);
 	}
 
+	physicsSystem.SerializeLayers(out);
+
 	out << "systems=" << systems.size() << "\n";
 	for (auto& sys : systems) {
 		sys->Serialize(out);
@@ -284,6 +485,9 @@ bool Scene::LoadFromFile(const std::string& path) {
 			link->LoadFromFile(in);
 			
 		}
+		else if (token == "[Physics]") {
+			physicsSystem.DeserializeLayers(in);
+		}
 		else if (token == "systems"){
 			continue;
 		}
@@ -298,9 +502,15 @@ bool Scene::LoadFromFile(const std::string& path) {
 			std::unique_ptr<SceneSystem> sys = nullptr;
 			if (type == "PathfindingSystem") sys = std::make_unique<PathfindingSystem>(renderer);
 			else if (type == "UIManager") sys = std::make_unique<UIManager>(renderer);
+			else if (type == "CrowdSystem") sys = std::make_unique<CrowdSystem>(renderer);
+
+			if (!sys) {
+				std::cerr << "[Scene] Unknown system type: " << type << std::endl;
+				continue;
+			}
 
 			sys->Deserialize(in);
-			systems.push_back(std::move(sys));
+			AddSystem(std::move(sys));
 		}
 	}
 
@@ -7,6 +7,9 @@
 #include "DelusiveUtils.h"
 #include "SceneSystem.h"
 #include "PhysicsSystem.h"
+#include "ScenePhysicsQuery.h"
+#include "CullingGrid.h"
+#include "StaticSpriteBatch.h"
 #include "DelusiveSystems.h"
 
 //Forward declarations
@@ -14,9 +17,23 @@ class Agent;
 class CameraAgent;
 class GameManager;
 class ScriptManager;
+class SpriteComponent;
+class ColliderComponent;
+class TilemapComponent;
 
 class Scene {
 public:
+	//Per-frame counters from the last Draw
+	struct DrawStats {
+		int visibleSprites = 0;
+		int culledSprites = 0;
+		int visibleColliders = 0;
+		int culledColliders = 0;
+		int staticItems = 0;
+		int visibleTileChunks = 0;
+		int uploadedTileChunks = 0;
+	};
+
 	Scene() = delete;
 	Scene(DelusiveRenderer&);
 	~Scene();
@@ -39,11 +56,22 @@ public:
 	void AddAgent(std::unique_ptr<Agent>);
 	std::vector<std::unique_ptr<Agent>>& GetAgents();
 	Agent* FetchPlayer();
+	//Removes and destroys the agent, use this rather than erasing from GetAgents()
+	void RemoveAgent(Agent*);
+	//Call after editing an agent's transform or components, rebuilds the draw cache and tells the systems
+	void MarkAgentEdited(Agent&);
 	void ClearAgents();
 
 	//System management
 	void AddSystem(std::unique_ptr<SceneSystem>);
-	template<typename T> T* GetSystem();
+	template<typename T> T* GetSystem() {
+		for (auto& sys : systems) {
+			if (auto ptr = dynamic_cast<T*>(sys.get())) {
+				return ptr;
+			}
+		}
+		return nullptr;
+	}
 	std::vector<std::unique_ptr<SceneSystem>>& GetSystems();
 
 	//Camera stuff
@@ -57,6 +85,19 @@ public:
 	void Clear();
 	std::string GetName() { return name; }
 	void SetName(const std::string& _name) { name = _name; }
+	PhysicsSystem& GetPhysics() { return physicsSystem; }
+	const PhysicsQuery& GetPhysicsQuery() const { return physicsQuery; }
+
+	//Culling
+	const DrawStats& GetDrawStats() const { return drawStats; }
+	bool IsCullingEnabled() const { return cullingEnabled; }
+	void SetCullingEnabled(bool enabled) { cullingEnabled = enabled; }
+	//Call after editing environment agents so the static culling grid is rebuilt
+	void MarkDrawCacheDirty() { drawCacheDirty = true; }
+	//Environment sprites baked into chunk buffers, see StaticSpriteBatch
+	bool IsStaticBatchingEnabled() const { return staticBatching; }
+	void SetStaticBatchingEnabled(bool enabled) { staticBatching = enabled; }
+	const StaticSpriteBatch::Stats& GetStaticBatchStats() const { return staticBatch.GetStats(); }
 
 	bool SaveToFile(const std::string& path) const;
 	bool LoadFromFile(const std::string& path);
@@ -66,8 +107,31 @@ private:
 	DelusiveRenderer& renderer;
 	std::string name;
 	CameraAgent* camera;
-	static PhysicsSystem physicsSystem;
+	PhysicsSystem physicsSystem;
+	ScenePhysicsQuery physicsQuery{ physicsSystem };
 	uint16_t nextAgentID = 0;
 	std::vector<std::unique_ptr<Agent>> agents;
 	std::vector<std::unique_ptr<SceneSystem>> systems;
+
+	//Environment agents never move at runtime, so their bounds live in a grid rebuilt only when dirty
+	bool cullingEnabled = true;
+	mutable bool drawCacheDirty = true;
+	mutable CullingGrid staticSpriteGrid;
+	mutable CullingGrid staticColliderGrid;
+	mutable std::vector<SpriteComponent*> staticSprites;
+	mutable std::vector<const ColliderComponent*> staticColliders;
+	mutable std::vector<Agent*> dynamicAgents;
+	mutable std::vector<const TilemapComponent*> tilemaps;
+	mutable DrawStats drawStats;
+
+	//Non-animated static sprites are also baked; the flag per staticSprites entry says which
+	bool staticBatching = true;
+	mutable StaticSpriteBatch staticBatch;
+	mutable std::vector<bool> staticSpriteBaked;
+	mutable int unbakedStaticSprites = 0;
+	mutable StaticSpriteBatch::LayerMask unbakedLayers;
+
+	static bool IsStaticForCulling(Agent&);
+	static Zone ComputeViewRect(const glm::mat4& projection);
+	void RebuildDrawCache() const;
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "ScenePhysicsQuery.h"
+#include "PhysicsSystem.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+	constexpr int RaycastGrain = 64; // raycasts per job chunk
+}
+
+QueryHit ScenePhysicsQuery::ToQueryHit(const RayHit& rayHit) {
+	QueryHit hit;
+	if (rayHit.collider) {
+		Agent* owner = rayHit.collider->GetOwner();
+		hit.agentID = owner ? owner->GetID() : 0;
+		hit.layer = rayHit.collider->GetLayer();
+	}
+	hit.point = rayHit.point;
+	hit.normal = rayHit.normal;
+	hit.fraction = rayHit.fraction;
+	return hit;
+}
+
+// Agents with several colliders in range are reported once
+int ScenePhysicsQuery::AppendAgents(const std::vector<ColliderComponent*>& found, std::vector<uint64_t>& agentIDs) {
+	size_t start = agentIDs.size();
+	for (ColliderComponent* collider : found) {
+		if (Agent* owner = collider->GetOwner()) agentIDs.push_back(owner->GetID());
+	}
+
+	std::sort(agentIDs.begin() + start, agentIDs.end());
+	agentIDs.erase(std::unique(agentIDs.begin() + start, agentIDs.end()), agentIDs.end());
+	return static_cast<int>(agentIDs.size() - start);
+}
+
+bool ScenePhysicsQuery::Raycast(glm::vec2 from, glm::vec2 to, QueryHit& hit, const QueryFilter& filter) const {
+	RayHit rayHit;
+	if (!physics->RayCast(from, to, rayHit, filter)) return false;
+	hit = ToQueryHit(rayHit);
+	return true;
+}
+
+int ScenePhysicsQuery::CircleOverlap(glm::vec2 center, float radius, std::vector<uint64_t>& agentIDs, const QueryFilter& filter) const {
+	std::vector<ColliderComponent*> found;
+	physics->QueryCircle(center, radius, found, filter);
+	return AppendAgents(found, agentIDs);
+}
+
+int ScenePhysicsQuery::BoxOverlap(glm::vec2 min, glm::vec2 max, std::vector<uint64_t>& agentIDs, const QueryFilter& filter) const {
+	std::vector<ColliderComponent*> found;
+	physics->QueryOverlap(Zone{ glm::min(min, max), glm::max(min, max) }, found, filter);
+	return AppendAgents(found, agentIDs);
+}
+
+bool ScenePhysicsQuery::ShapeCast(glm::vec2 from, glm::vec2 to, float radius, QueryHit& hit, const QueryFilter& filter) const {
+	RayHit rayHit;
+	if (!physics->CircleCast(from, to, radius, rayHit, filter)) return false;
+	hit = ToQueryHit(rayHit);
+	return true;
+}
+
+void ScenePhysicsQuery::RaycastBatch(const RaycastRequest* requests, RaycastResult* results, int count) const {
+	JobSystem::ParallelFor(count, RaycastGrain, [&](int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			results[i] = RaycastResult();
+			results[i].hit = Raycast(requests[i].from, requests[i].to, results[i].info, requests[i].filter);
+		}
+	});
+}
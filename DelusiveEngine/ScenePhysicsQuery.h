@@ -0,0 +1,25 @@
+#pragma once
+#include <Delusive/PhysicsQuery.h>
+
+class PhysicsSystem;
+struct RayHit;
+class ColliderComponent;
+
+//Script-facing PhysicsQuery over a scene's PhysicsSystem. Colliders are reported by the ID of the
+//agent that owns them.
+class ScenePhysicsQuery : public PhysicsQuery {
+public:
+	explicit ScenePhysicsQuery(const PhysicsSystem& physics) : physics(&physics) {}
+
+	bool Raycast(glm::vec2 from, glm::vec2 to, QueryHit& hit, const QueryFilter& filter = {}) const override;
+	int CircleOverlap(glm::vec2 center, float radius, std::vector<uint64_t>& agentIDs, const QueryFilter& filter = {}) const override;
+	int BoxOverlap(glm::vec2 min, glm::vec2 max, std::vector<uint64_t>& agentIDs, const QueryFilter& filter = {}) const override;
+	bool ShapeCast(glm::vec2 from, glm::vec2 to, float radius, QueryHit& hit, const QueryFilter& filter = {}) const override;
+	void RaycastBatch(const RaycastRequest* requests, RaycastResult* results, int count) const override;
+
+private:
+	const PhysicsSystem* physics;
+
+	static QueryHit ToQueryHit(const RayHit&);
+	static int AppendAgents(const std::vector<ColliderComponent*>&, std::vector<uint64_t>& agentIDs);
+};
@@ -3,6 +3,9 @@
 #include "DelusiveRegistry.h"
 #include "DelusiveRenderer.h"
 
+class Scene;
+class Agent;
+
 class SceneSystem {
 public:
 	SceneSystem() = delete;
@@ -13,9 +16,16 @@ public:
 
 	virtual void Update(float) = 0;
 	virtual void Draw(const glm::mat4&) = 0;
+	//World-space overlays queued on the renderer's DebugDraw
+	virtual void DrawDebug(const glm::mat4&) const {}
 	virtual void Reset() = 0;
+	//Sent by the scene after an agent's transform or components were edited, and before one is removed
+	virtual void OnAgentEdited(Agent&) {}
+	virtual void OnAgentRemoved(Agent&) {}
 	virtual void DrawImGui() {}
 	virtual void SetEditorMode(bool editor) { editorMode = editor; }
+	virtual void SetScene(Scene* _scene) { scene = _scene; }
+	Scene* GetScene() const { return scene; }
 
 	virtual void SetName(std::string _name) { name = _name; }
 	virtual std::string GetName() { return name; }
@@ -32,6 +42,7 @@ public:
 protected:
 	DelusiveRenderer& renderer;
 	PropertyRegistry registry;
+	Scene* scene = nullptr;
 	bool editorMode = false;
 	std::string name;
 };
\ No newline at end of file
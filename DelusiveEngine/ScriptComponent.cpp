@@ -70,6 +70,17 @@ void ScriptComponent::Update(float deltaTime) {
 	}
 }
 
+void ScriptComponent::OnContact(const ContactInfo& contact) {
+	BehaviourScript* script = scriptContainer->script.get();
+	if (!script) return;
+
+	switch (contact.phase) {
+	case ContactPhase::Begin: script->OnContactBegin(contact); break;
+	case ContactPhase::Stay: script->OnContactStay(contact); break;
+	case ContactPhase::End: script->OnContactEnd(contact); break;
+	}
+}
+
 void ScriptComponent::Deserialize(std::istream& in) {
 	Component::Deserialize(in);
 	AttachScript();
@@ -2,6 +2,7 @@
 #include "Component.h"
 #include "ScriptManager.h"
 #include "BehaviourScript.h"
+#include <Delusive/Contact.h>
 
 struct DelusiveScript;
 class DelusiveScriptAgent;
@@ -30,6 +31,7 @@ public:
     void AttachScript();
 
     void Update(float) override;
+    void OnContact(const ContactInfo&);
 
     // --- Serialization helpers ---
     std::string GetScriptName() const { return name; }
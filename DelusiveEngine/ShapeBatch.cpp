@@ -0,0 +1,173 @@
+#include "ShapeBatch.h"
+#include <SDL3/SDL_cpuinfo.h>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DELUSIVE_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC accepts AVX2 intrinsics anywhere; GCC and Clang need the function tagged
+#if defined(__GNUC__) || defined(__clang__)
+#define DELUSIVE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DELUSIVE_TARGET_AVX2
+#endif
+
+void ShapeArrays::Resize(size_t count) {
+	minX.resize(count);
+	minY.resize(count);
+	maxX.resize(count);
+	maxY.resize(count);
+	radius.resize(count);
+}
+
+void ShapeArrays::Set(int index, const ColliderData& data) {
+	if (data.shape == ShapeType::Circle) {
+		minX[index] = maxX[index] = data.center.x;
+		minY[index] = maxY[index] = data.center.y;
+		radius[index] = data.radius;
+	}
+	else {
+		minX[index] = data.bounds.min.x;
+		minY[index] = data.bounds.min.y;
+		maxX[index] = data.bounds.max.x;
+		maxY[index] = data.bounds.max.y;
+		radius[index] = 0.0f;
+	}
+}
+
+// Matches the per-pair functions: boxes need a strict overlap, anything round uses
+// squared distance between the cores against the summed radius.
+uint32_t ShapeBatch::TestScalar(const ShapeArrays& s, int a, const int* candidates, int count) {
+	uint32_t result = 0;
+	for (int k = 0; k < count; ++k) {
+		int b = candidates[k];
+		float gapX = std::max(0.0f, std::max(s.minX[a] - s.maxX[b], s.minX[b] - s.maxX[a]));
+		float gapY = std::max(0.0f, std::max(s.minY[a] - s.maxY[b], s.minY[b] - s.maxY[a]));
+		float radiusSum = s.radius[a] + s.radius[b];
+
+		bool hit;
+		if (radiusSum > 0.0f) {
+			hit = gapX * gapX + gapY * gapY <= radiusSum * radiusSum;
+		}
+		else {
+			hit = s.minX[a] < s.maxX[b] && s.maxX[a] > s.minX[b] && s.minY[a] < s.maxY[b] && s.maxY[a] > s.minY[b];
+		}
+		result |= static_cast<uint32_t>(hit) << k;
+	}
+	return result;
+}
+
+#ifdef DELUSIVE_X86
+namespace {
+	// Plain loads rather than vgatherdps, which is slower than scalar loads on many AVX2 parts
+	DELUSIVE_TARGET_AVX2
+	inline __m256 LoadLanes(const std::vector<float>& v, const int* i) {
+		return _mm256_set_ps(v[i[7]], v[i[6]], v[i[5]], v[i[4]], v[i[3]], v[i[2]], v[i[1]], v[i[0]]);
+	}
+}
+
+uint32_t ShapeBatch::TestSSE(const ShapeArrays& s, int a, const int* candidates, int count) {
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 aMinX = _mm_set1_ps(s.minX[a]), aMinY = _mm_set1_ps(s.minY[a]);
+	const __m128 aMaxX = _mm_set1_ps(s.maxX[a]), aMaxY = _mm_set1_ps(s.maxY[a]);
+	const __m128 aRadius = _mm_set1_ps(s.radius[a]);
+
+	uint32_t result = 0;
+	for (int base = 0; base < count; base += 4) {
+		// Pad the last group with the first candidate, its bits are masked off below
+		int i[4];
+		for (int k = 0; k < 4; ++k) i[k] = candidates[base + k < count ? base + k : 0];
+
+		__m128 bMinX = _mm_set_ps(s.minX[i[3]], s.minX[i[2]], s.minX[i[1]], s.minX[i[0]]);
+		__m128 bMinY = _mm_set_ps(s.minY[i[3]], s.minY[i[2]], s.minY[i[1]], s.minY[i[0]]);
+		__m128 bMaxX = _mm_set_ps(s.maxX[i[3]], s.maxX[i[2]], s.maxX[i[1]], s.maxX[i[0]]);
+		__m128 bMaxY = _mm_set_ps(s.maxY[i[3]], s.maxY[i[2]], s.maxY[i[1]], s.maxY[i[0]]);
+		__m128 bRadius = _mm_set_ps(s.radius[i[3]], s.radius[i[2]], s.radius[i[1]], s.radius[i[0]]);
+
+		__m128 gapX = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(aMinX, bMaxX), _mm_sub_ps(bMinX, aMaxX)));
+		__m128 gapY = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(aMinY, bMaxY), _mm_sub_ps(bMinY, aMaxY)));
+		__m128 distanceSq = _mm_add_ps(_mm_mul_ps(gapX, gapX), _mm_mul_ps(gapY, gapY));
+		__m128 radiusSum = _mm_add_ps(aRadius, bRadius);
+		__m128 roundHit = _mm_cmple_ps(distanceSq, _mm_mul_ps(radiusSum, radiusSum));
+
+		__m128 boxHit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(aMinX, bMaxX), _mm_cmpgt_ps(aMaxX, bMinX)),
+			_mm_and_ps(_mm_cmplt_ps(aMinY, bMaxY), _mm_cmpgt_ps(aMaxY, bMinY)));
+
+		__m128 isRound = _mm_cmpgt_ps(radiusSum, zero);
+		__m128 hit = _mm_or_ps(_mm_and_ps(isRound, roundHit), _mm_andnot_ps(isRound, boxHit));
+		result |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << base;
+	}
+	return result & ((1u << count) - 1u);
+}
+
+DELUSIVE_TARGET_AVX2
+uint32_t ShapeBatch::TestAVX2(const ShapeArrays& s, int a, const int* candidates, int count) {
+	int i[Width];
+	for (int k = 0; k < Width; ++k) i[k] = candidates[k < count ? k : 0];
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 aMinX = _mm256_set1_ps(s.minX[a]), aMinY = _mm256_set1_ps(s.minY[a]);
+	const __m256 aMaxX = _mm256_set1_ps(s.maxX[a]), aMaxY = _mm256_set1_ps(s.maxY[a]);
+	const __m256 aRadius = _mm256_set1_ps(s.radius[a]);
+
+	__m256 bMinX = LoadLanes(s.minX, i);
+	__m256 bMinY = LoadLanes(s.minY, i);
+	__m256 bMaxX = LoadLanes(s.maxX, i);
+	__m256 bMaxY = LoadLanes(s.maxY, i);
+	__m256 bRadius = LoadLanes(s.radius, i);
+
+	__m256 gapX = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(aMinX, bMaxX), _mm256_sub_ps(bMinX, aMaxX)));
+	__m256 gapY = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(aMinY, bMaxY), _mm256_sub_ps(bMinY, aMaxY)));
+	// Separate multiply and add, no FMA, so results match the scalar tests bit for bit
+	__m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(gapX, gapX), _mm256_mul_ps(gapY, gapY));
+	__m256 radiusSum = _mm256_add_ps(aRadius, bRadius);
+	__m256 roundHit = _mm256_cmp_ps(distanceSq, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+
+	__m256 boxHit = _mm256_and_ps(
+		_mm256_and_ps(_mm256_cmp_ps(aMinX, bMaxX, _CMP_LT_OQ), _mm256_cmp_ps(aMaxX, bMinX, _CMP_GT_OQ)),
+		_mm256_and_ps(_mm256_cmp_ps(aMinY, bMaxY, _CMP_LT_OQ), _mm256_cmp_ps(aMaxY, bMinY, _CMP_GT_OQ)));
+
+	__m256 isRound = _mm256_cmp_ps(radiusSum, zero, _CMP_GT_OQ);
+	__m256 hit = _mm256_blendv_ps(boxHit, roundHit, isRound);
+	return static_cast<uint32_t>(_mm256_movemask_ps(hit)) & ((1u << count) - 1u);
+}
+
+bool ShapeBatch::HasSSE() {
+	return SDL_HasSSE2();
+}
+
+bool ShapeBatch::HasAVX2() {
+	return SDL_HasAVX2();
+}
+#else
+uint32_t ShapeBatch::TestSSE(const ShapeArrays& s, int a, const int* candidates, int count) {
+	return TestScalar(s, a, candidates, count);
+}
+
+uint32_t ShapeBatch::TestAVX2(const ShapeArrays& s, int a, const int* candidates, int count) {
+	return TestScalar(s, a, candidates, count);
+}
+
+bool ShapeBatch::HasSSE() {
+	return false;
+}
+
+bool ShapeBatch::HasAVX2() {
+	return false;
+}
+#endif
+
+ShapeBatchKernel ShapeBatch::GetKernel() {
+	// Batching without SIMD loses to the per-pair tests, so no kernel at all in that case
+	static const ShapeBatchKernel kernel = HasAVX2() ? &TestAVX2 : HasSSE() ? &TestSSE : nullptr;
+	return kernel;
+}
+
+const char* ShapeBatch::GetKernelName() {
+	ShapeBatchKernel kernel = GetKernel();
+	if (kernel == &TestAVX2) return "AVX2";
+	if (kernel == &TestSSE) return "SSE2";
+	return "Scalar per pair";
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "PhysicsTypes.h"
+#include <cstdint>
+#include <vector>
+
+//Structure-of-arrays copy of every collider for the batched narrowphase.
+//Circles are stored as a zero-size box at their center plus a radius and boxes with a radius of 0,
+//so one rounded-box test covers box-box, circle-circle and box-circle. Lines are never batched.
+struct ShapeArrays {
+	std::vector<float> minX, minY, maxX, maxY, radius;
+
+	void Resize(size_t count);
+	void Set(int index, const ColliderData&);
+};
+
+//Tests collider a against up to ShapeBatch::Width candidates. Bit k is set when candidates[k] overlaps a.
+using ShapeBatchKernel = uint32_t(*)(const ShapeArrays&, int a, const int* candidates, int count);
+
+//Kernels are picked once from the CPU features SDL reports.
+//TestScalar is the reference implementation the SIMD kernels are checked against.
+class ShapeBatch {
+public:
+	static constexpr int Width = 8;
+	static constexpr int MinBatch = 3; // shorter candidate runs use the per-pair tests
+
+	static ShapeBatchKernel GetKernel(); // null when the CPU has no usable SIMD
+	static const char* GetKernelName();
+
+	static bool IsBatchable(ShapeType shape) { return shape != ShapeType::Line; }
+
+	static uint32_t TestScalar(const ShapeArrays&, int a, const int* candidates, int count);
+	static uint32_t TestSSE(const ShapeArrays&, int a, const int* candidates, int count);  // scalar off x86
+	static uint32_t TestAVX2(const ShapeArrays&, int a, const int* candidates, int count);
+	static bool HasSSE();
+	static bool HasAVX2();
+};
@@ -0,0 +1,204 @@
+#include "ShapeCast.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	constexpr float Epsilon = 1e-8f;
+
+	glm::vec2 ZoneCenter(const Zone& zone) {
+		return 0.5f * (zone.min + zone.max);
+	}
+}
+
+bool ShapeCast::SegmentBox(glm::vec2 from, glm::vec2 to, const Zone& box, float& t, glm::vec2& normal) {
+	glm::vec2 delta = to - from;
+	t = 0.0f;
+	float tExit = 1.0f;
+	normal = glm::vec2(0.0f);
+
+	for (int axis = 0; axis < 2; ++axis) {
+		if (std::fabs(delta[axis]) < Epsilon) {
+			if (from[axis] < box.min[axis] || from[axis] > box.max[axis]) return false;
+			continue;
+		}
+
+		float inverse = 1.0f / delta[axis];
+		float t1 = (box.min[axis] - from[axis]) * inverse;
+		float t2 = (box.max[axis] - from[axis]) * inverse;
+		float side = -1.0f;
+		if (t1 > t2) {
+			std::swap(t1, t2);
+			side = 1.0f;
+		}
+
+		if (t1 > t) {
+			t = t1;
+			normal = glm::vec2(0.0f);
+			normal[axis] = side;
+		}
+		tExit = std::min(tExit, t2);
+		if (t > tExit) return false;
+	}
+	return true;
+}
+
+bool ShapeCast::SegmentCircle(glm::vec2 from, glm::vec2 to, glm::vec2 center, float radius, float& t, glm::vec2& normal) {
+	glm::vec2 ray = to - from;
+	glm::vec2 offset = from - center;
+	float a = glm::dot(ray, ray);
+	float b = glm::dot(offset, ray);
+	float c = glm::dot(offset, offset) - radius * radius;
+
+	if (c <= 0.0f) {
+		// Starting inside
+		t = 0.0f;
+		normal = a > 0.0f ? -ray / std::sqrt(a) : glm::vec2(0.0f);
+		return true;
+	}
+
+	float discriminant = b * b - a * c;
+	if (a <= Epsilon || discriminant < 0.0f) return false;
+
+	t = (-b - std::sqrt(discriminant)) / a;
+	if (t < 0.0f || t > 1.0f) return false;
+
+	normal = glm::normalize(from + ray * t - center);
+	return true;
+}
+
+bool ShapeCast::SegmentRoundedBox(glm::vec2 from, glm::vec2 to, const Zone& core, float radius, float& t, glm::vec2& normal) {
+	if (radius <= 0.0f) return SegmentBox(from, to, core, t, normal);
+
+	// Union of the box grown along each axis and a circle at every corner
+	bool hit = false;
+	t = 1.0f;
+
+	float candidateT;
+	glm::vec2 candidateNormal;
+	auto consider = [&](bool found) {
+		if (found && (!hit || candidateT < t)) {
+			hit = true;
+			t = candidateT;
+			normal = candidateNormal;
+		}
+	};
+
+	Zone wide = { core.min - glm::vec2(radius, 0.0f), core.max + glm::vec2(radius, 0.0f) };
+	Zone tall = { core.min - glm::vec2(0.0f, radius), core.max + glm::vec2(0.0f, radius) };
+	consider(SegmentBox(from, to, wide, candidateT, candidateNormal));
+	consider(SegmentBox(from, to, tall, candidateT, candidateNormal));
+
+	const glm::vec2 corners[4] = { core.min, { core.max.x, core.min.y }, core.max, { core.min.x, core.max.y } };
+	for (const glm::vec2& corner : corners) {
+		consider(SegmentCircle(from, to, corner, radius, candidateT, candidateNormal));
+	}
+	return hit;
+}
+
+bool ShapeCast::SegmentCapsule(glm::vec2 from, glm::vec2 to, glm::vec2 a, glm::vec2 b, float radius, float& t, glm::vec2& normal) {
+	bool hit = false;
+	t = 1.0f;
+
+	float candidateT;
+	glm::vec2 candidateNormal;
+	auto consider = [&](bool found) {
+		if (found && (!hit || candidateT < t)) {
+			hit = true;
+			t = candidateT;
+			normal = candidateNormal;
+		}
+	};
+
+	consider(SegmentCircle(from, to, a, radius, candidateT, candidateNormal));
+	consider(SegmentCircle(from, to, b, radius, candidateT, candidateNormal));
+
+	glm::vec2 axis = b - a;
+	float length = glm::length(axis);
+	if (length > Epsilon) {
+		// The straight middle section is a rectangle around the segment
+		glm::vec2 direction = axis / length;
+		glm::vec2 side(-direction.y, direction.x);
+		const glm::vec2 normals[4] = { side, -side, direction, -direction };
+		const float offsets[4] = {
+			glm::dot(side, a) + radius, -glm::dot(side, a) + radius,
+			glm::dot(direction, b), -glm::dot(direction, a)
+		};
+		consider(SegmentHalfPlanes(from, to, normals, offsets, 4, candidateT, candidateNormal));
+	}
+	return hit;
+}
+
+// Cyrus-Beck clipping
+bool ShapeCast::SegmentHalfPlanes(glm::vec2 from, glm::vec2 to, const glm::vec2* normals, const float* offsets, int count,
+	float& t, glm::vec2& normal) {
+	glm::vec2 delta = to - from;
+	t = 0.0f;
+	float tExit = 1.0f;
+	normal = glm::vec2(0.0f);
+
+	for (int i = 0; i < count; ++i) {
+		float distance = offsets[i] - glm::dot(normals[i], from); // >= 0 while inside
+		float approach = glm::dot(normals[i], delta);
+
+		if (std::fabs(approach) < Epsilon) {
+			if (distance < 0.0f) return false;
+			continue;
+		}
+
+		float crossing = distance / approach;
+		if (approach < 0.0f) {
+			// Entering through this plane
+			if (crossing > t) {
+				t = crossing;
+				normal = normals[i];
+			}
+		}
+		else {
+			tExit = std::min(tExit, crossing);
+		}
+		if (t > tExit) return false;
+	}
+	return true;
+}
+
+bool ShapeCast::Sweep(const ColliderData& moving, glm::vec2 motion, const ColliderData& target, float& toi, glm::vec2& normal) {
+	bool movingCircle = moving.shape == ShapeType::Circle;
+	glm::vec2 from = movingCircle ? moving.center : ZoneCenter(moving.bounds);
+	glm::vec2 to = from + motion;
+	glm::vec2 halfSize = movingCircle ? glm::vec2(0.0f) : 0.5f * (moving.bounds.max - moving.bounds.min);
+	float radius = movingCircle ? moving.radius : 0.0f;
+
+	// Cast the moving shape's center against the target grown by the moving shape
+	bool hit = false;
+	switch (target.shape) {
+	case ShapeType::Box:
+		hit = SegmentRoundedBox(from, to, { target.bounds.min - halfSize, target.bounds.max + halfSize }, radius, toi, normal);
+		break;
+
+	case ShapeType::Circle:
+		hit = SegmentRoundedBox(from, to, { target.center - halfSize, target.center + halfSize }, target.radius + radius, toi, normal);
+		break;
+
+	case ShapeType::Line:
+		if (movingCircle) {
+			hit = SegmentCapsule(from, to, target.center, target.end, radius, toi, normal);
+		}
+		else {
+			// Box swept along a segment is a hexagon, bounded by the box axes and the segment normal
+			glm::vec2 axis = target.end - target.center;
+			glm::vec2 side = glm::length(axis) > Epsilon ? glm::normalize(glm::vec2(-axis.y, axis.x)) : glm::vec2(1.0f, 0.0f);
+			const glm::vec2 normals[6] = { { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f }, side, -side };
+
+			float offsets[6];
+			for (int i = 0; i < 6; ++i) {
+				float support = std::max(glm::dot(normals[i], target.center), glm::dot(normals[i], target.end));
+				offsets[i] = support + glm::dot(glm::abs(normals[i]), halfSize);
+			}
+			hit = SegmentHalfPlanes(from, to, normals, offsets, 6, toi, normal);
+		}
+		break;
+	}
+
+	// Already touching at the start is the discrete solver's job
+	return hit && toi > 0.0f;
+}
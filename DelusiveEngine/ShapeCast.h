@@ -0,0 +1,24 @@
+#pragma once
+#include "PhysicsTypes.h"
+
+//Segment casts and swept-shape time of impact for continuous collision.
+//Every cast runs along from + t * (to - from) with t in [0, 1] and reports the entry t and surface normal.
+class ShapeCast {
+public:
+	static bool SegmentBox(glm::vec2 from, glm::vec2 to, const Zone& box, float& t, glm::vec2& normal);
+	static bool SegmentCircle(glm::vec2 from, glm::vec2 to, glm::vec2 center, float radius, float& t, glm::vec2& normal);
+	//Box with its corners rounded off by radius (a Minkowski sum of a box and a circle)
+	static bool SegmentRoundedBox(glm::vec2 from, glm::vec2 to, const Zone& core, float radius, float& t, glm::vec2& normal);
+	//Segment a-b thickened by radius
+	static bool SegmentCapsule(glm::vec2 from, glm::vec2 to, glm::vec2 a, glm::vec2 b, float radius, float& t, glm::vec2& normal);
+
+	//Time of impact of moving sweeping by motion against a resting target.
+	//Circles sweep as circles, everything else as its bounding box. Starting in overlap is not a hit,
+	//that is left to the discrete solver.
+	static bool Sweep(const ColliderData& moving, glm::vec2 motion, const ColliderData& target, float& toi, glm::vec2& normal);
+
+private:
+	//Convex polygon given as half-planes dot(normal, p) <= offset
+	static bool SegmentHalfPlanes(glm::vec2 from, glm::vec2 to, const glm::vec2* normals, const float* offsets, int count,
+		float& t, glm::vec2& normal);
+};
@@ -1,6 +1,7 @@
 #include "SolidCollider.h"
 
-void SolidCollider::OnCollision(ColliderComponent* col) {
-	//TODO: Prevent self hits
+void SolidCollider::OnContact(ContactPhase phase, ColliderComponent* col) {
+	if (phase != ContactPhase::Begin) return;
+
 	std::cout << "[Solid] collided with another object." << std::endl;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "Sprite.h"
 #include "DelusiveRenderer.h"
+#include "UnitQuad.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <stb/stb_image.h>
@@ -7,17 +8,6 @@
 #include <sstream>
 
 
-float quadVertices[] = {
-    // pos       // tex
-    -0.5f, -0.5f,  0.0f, 0.0f,
-     0.5f, -0.5f,  1.0f, 0.0f,
-     0.5f,  0.5f,  1.0f, 1.0f,
-
-     0.5f,  0.5f,  1.0f, 1.0f,
-    -0.5f,  0.5f,  0.0f, 1.0f,
-    -0.5f, -0.5f,  0.0f, 0.0f
-};
-
 Sprite::Sprite(const char* texturePath){
     stbi_set_flip_vertically_on_load(true);
     shader = new Shader("shaders\\vertex.glsl", "C:\\Users\\Demon Teddy\\Documents\\Programs\\DelusiveEngine\\DelusiveEngine\\shaders\\fragment.glsl");
@@ -30,7 +20,7 @@ Sprite::Sprite(const char* texturePath){
 
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(UnitQuadVertices), UnitQuadVertices, GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -66,7 +56,7 @@ void Sprite::Draw(const glm::mat4& projection) const {
     shader->SetMat4("projection", glm::value_ptr(spriteProjection));
 
     glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDrawArrays(GL_TRIANGLES, 0, UnitQuadVertexCount);
 
     for (const Collider& col : colliders) {
         //renderer.Draw(col, projection);
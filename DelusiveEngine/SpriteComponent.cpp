@@ -1,23 +1,14 @@
 #include "SpriteComponent.h"
 #include "Agent.h"
 #include "DelusiveMacros.h"
+#include "DelusiveUtils.h"
+#include "UnitQuad.h"
 #include <filesystem>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <stb/stb_image.h>
 #include <string>
 
-float vertices[] = {
-    // pos       // tex
-    -0.5f, -0.5f,  0.0f, 0.0f,
-     0.5f, -0.5f,  1.0f, 0.0f,
-     0.5f,  0.5f,  1.0f, 1.0f,
-
-     0.5f,  0.5f,  1.0f, 1.0f,
-    -0.5f,  0.5f,  0.0f, 1.0f,
-    -0.5f, -0.5f,  0.0f, 0.0f
-};
-
 SpriteComponent::SpriteComponent() {
     Init();
 }
@@ -47,6 +38,7 @@ void SpriteComponent::Init() {
 void SpriteComponent::RegisterProperties() {
     Component::RegisterProperties();
     registry->Register("textureData", &textureData);
+    registry->Register("renderOrder", &renderOrder);
 }
 
 std::unique_ptr<Component> SpriteComponent::Clone() const {
@@ -55,6 +47,9 @@ std::unique_ptr<Component> SpriteComponent::Clone() const {
     sprite->SetRotation(transform.rotation);
     sprite->SetScale(transform.scale.x, transform.scale.y);
     sprite->SetName(GetName());
+    // Play mode runs on clones, so the sort layer has to come along
+    sprite->renderOrder = renderOrder;
+    sprite->isForeground = isForeground;
     return sprite;
 }
 
@@ -103,6 +98,52 @@ void SpriteComponent::Draw(const glm::mat4& projection) const{
     textureData.Draw(model, view, projection);
 }
 
+void SpriteComponent::Record(RenderQueue& queue, float sortY) const {
+    if (!textureData.texture) return;
+
+    RenderQueue::Command command;
+    command.program = queue.GetSpriteProgram();
+    command.vao = queue.GetQuadVAO();
+    command.texture = queue.ResolveTexture(textureData);
+    command.vertexCount = UnitQuadVertexCount;
+    command.model = owner->GetTransform().ToMatrix() * transform.ToMatrix();
+    command.key = RenderQueue::MakeKey(renderOrder, isForeground, sortY,
+        queue.GetShaderSlot(command.program), queue.GetTextureSlot(command.texture));
+    queue.Push(command);
+}
+
+bool SpriteComponent::Bake(StaticSpriteBatch& batch, float sortY) const {
+    if (!textureData.texture) return false;
+
+    StaticSpriteBatch::Sprite sprite;
+    sprite.model = owner->GetTransform().ToMatrix() * transform.ToMatrix();
+    sprite.texture = batch.ResolveTexture(textureData);
+    sprite.layer = renderOrder;
+    sprite.foreground = isForeground;
+    sprite.sortY = sortY;
+    batch.Add(sprite);
+    return true;
+}
+
+Zone SpriteComponent::GetWorldBounds() const {
+    const Transform& agentTransform = owner->GetTransform();
+    if (boundsValid && SameTransform(agentTransform, boundsAgentTransform)
+        && SameTransform(transform, boundsLocalTransform)) {
+        return cachedBounds;
+    }
+
+    const glm::mat4 model = agentTransform.ToMatrix() * transform.ToMatrix();
+    const glm::vec2 center(model[3]);
+    // Half extents of the rotated unit quad along each world axis
+    const glm::vec2 extent = 0.5f * (glm::abs(glm::vec2(model[0])) + glm::abs(glm::vec2(model[1])));
+
+    cachedBounds = { center - extent, center + extent };
+    boundsAgentTransform = agentTransform;
+    boundsLocalTransform = transform;
+    boundsValid = true;
+    return cachedBounds;
+}
+
 void SpriteComponent::DrawImGui() {
     Component::DrawImGui();
 
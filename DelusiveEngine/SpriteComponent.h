@@ -3,6 +3,9 @@
 #include "Component.h"
 #include "TransformComponent.h"
 #include "EditorInferface.h"
+#include "PhysicsTypes.h"
+#include "RenderQueue.h"
+#include "StaticSpriteBatch.h"
 #include <glm/glm.hpp>
 #include <GL/glew.h>
 #include <vector>
@@ -32,6 +35,13 @@ public:
     void SetScale(float sx, float sy);
     void SetRotation(float angle);
     void Draw(const glm::mat4& projection) const override;
+    //Records the sprite into the frame's render queue instead of drawing it
+    void Record(RenderQueue&, float sortY) const;
+    //Adds the sprite to a static chunk bake, false when it has no texture to draw
+    bool Bake(StaticSpriteBatch&, float sortY) const;
+    int GetRenderOrder() const { return renderOrder; }
+    //World-space bounds of the sprite quad, recomputed only when a transform changes
+    Zone GetWorldBounds() const;
     void DrawImGui() override;
     bool DrawAnimatorImGui(ComponentMod&) override;
     void SetVelocity(float x, float y);
@@ -51,4 +61,9 @@ private:
     
     int renderOrder = 0;
     glm::vec2 velocity = { 0.0f, 0.0f };
+
+    mutable Transform boundsAgentTransform;
+    mutable Transform boundsLocalTransform;
+    mutable Zone cachedBounds{ glm::vec2(0.0f), glm::vec2(0.0f) };
+    mutable bool boundsValid = false;
 };
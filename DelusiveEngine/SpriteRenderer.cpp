@@ -0,0 +1,193 @@
+#include "SpriteRenderer.h"
+#include "DelusiveData.h"
+#include "DelusiveMacros.h"
+#include "DelusiveUtils.h"
+#include "UnitQuad.h"
+#include <Delusive/Transform.h>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <random>
+
+SpriteRenderer::~SpriteRenderer() {
+	Shutdown();
+}
+
+void SpriteRenderer::Init() {
+	Shutdown();
+
+	shader = std::make_unique<Shader>(DEFAULT_SPRITE_INST_VERT, DEFAULT_SPRITE_INST_FRAG);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &quadVBO);
+	glGenBuffers(RingSize, instanceVBOs);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(UnitQuadVertices), UnitQuadVertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	for (GLuint attrib = 2; attrib <= 5; ++attrib) {
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribDivisor(attrib, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpriteRenderer::Shutdown() {
+	if (quadVBO) glDeleteBuffers(1, &quadVBO);
+	if (instanceVBOs[0]) glDeleteBuffers(RingSize, instanceVBOs);
+	if (VAO) glDeleteVertexArrays(1, &VAO);
+	quadVBO = VAO = 0;
+	for (int i = 0; i < RingSize; ++i) {
+		instanceVBOs[i] = 0;
+		instanceCapacity[i] = 0;
+	}
+	shader.reset();
+}
+
+// Attribute pointers are re-based per batch because GL 3.3 has no base instance
+void SpriteRenderer::BindInstanceAttributes(size_t byteOffset) const {
+	const GLsizei stride = sizeof(SpriteInstance);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(byteOffset + offsetof(SpriteInstance, axisX)));
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (void*)(byteOffset + offsetof(SpriteInstance, offset)));
+	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)(byteOffset + offsetof(SpriteInstance, uvRect)));
+	glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (void*)(byteOffset + offsetof(SpriteInstance, tint)));
+}
+
+void SpriteRenderer::Begin(const glm::mat4& _projection) {
+	projection = _projection;
+	instances.clear();
+	batches.clear();
+	stats = Stats{};
+}
+
+void SpriteRenderer::Submit(GLuint texture, const SpriteInstance& instance) {
+	if (batches.empty() || batches.back().texture != texture) {
+		batches.push_back({ texture, static_cast<int>(instances.size()), 0 });
+	}
+	instances.push_back(instance);
+	++batches.back().count;
+}
+
+void SpriteRenderer::Flush() {
+	auto start = std::chrono::steady_clock::now();
+	stats.instances += static_cast<int>(instances.size());
+
+	if (instances.empty() || !shader) {
+		instances.clear();
+		batches.clear();
+		return;
+	}
+
+	const size_t bytes = instances.size() * sizeof(SpriteInstance);
+	ringIndex = (ringIndex + 1) % RingSize;
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBOs[ringIndex]);
+
+	// Orphan the previous storage so the driver never waits on a draw still reading it
+	if (bytes > instanceCapacity[ringIndex]) {
+		instanceCapacity[ringIndex] = bytes + bytes / 2;
+	}
+	glBufferData(GL_ARRAY_BUFFER, instanceCapacity[ringIndex], nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+	stats.uploadBytes += bytes;
+
+	shader->Use();
+	shader->SetMat4("projection", projection);
+	shader->SetInt("tex", 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glBindVertexArray(VAO);
+	for (const Batch& batch : batches) {
+		BindInstanceAttributes(static_cast<size_t>(batch.first) * sizeof(SpriteInstance));
+		glBindTexture(GL_TEXTURE_2D, batch.texture);
+		glDrawArraysInstanced(GL_TRIANGLES, 0, UnitQuadVertexCount, batch.count);
+		++stats.drawCalls;
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	instances.clear();
+	batches.clear();
+	stats.submitMs += MillisecondsSince(start);
+}
+
+void SpriteRenderer::RunBenchmark(const glm::mat4& benchProjection, int count) {
+	benchmarkResults.clear();
+	if (!shader || count <= 0) return;
+
+	// Any image from the sprite folder will do, the path only needs to load
+	std::string texturePath;
+	for (const auto& entry : std::filesystem::directory_iterator(SPRITE_FOLDER)) {
+		const std::string extension = entry.path().extension().string();
+		if (extension == ".png" || extension == ".jpg") {
+			texturePath = entry.path().string();
+			break;
+		}
+	}
+	if (texturePath.empty()) {
+		std::cerr << "[SpriteRenderer] No sprite found in " << SPRITE_FOLDER << " to benchmark with" << std::endl;
+		return;
+	}
+
+	DelusiveTexture texture;
+	texture.texturePath = texturePath;
+	texture.Init();
+	texture.SetTexture(texturePath);
+
+	// Sprites spread over the visible area, in world units
+	const glm::mat4 inverse = glm::inverse(benchProjection);
+	const glm::vec2 viewMin = glm::vec2(inverse * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f));
+	const glm::vec2 viewMax = glm::vec2(inverse * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> px(glm::min(viewMin.x, viewMax.x), glm::max(viewMin.x, viewMax.x));
+	std::uniform_real_distribution<float> py(glm::min(viewMin.y, viewMax.y), glm::max(viewMin.y, viewMax.y));
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> size(0.2f, 1.0f);
+
+	std::vector<Transform> transforms(count);
+	for (Transform& t : transforms) {
+		t.position = { px(rng), py(rng) };
+		t.rotation = angle(rng);
+		t.scale = glm::vec2(size(rng));
+	}
+
+	// Only submission and upload are of interest, so nothing reaches the framebuffer
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(0, 0, 0, 0);
+	glFinish();
+
+	BenchmarkResult legacy{ "Legacy (draw per sprite)" };
+	auto start = std::chrono::steady_clock::now();
+	const glm::mat4 view(1.0f);
+	for (const Transform& t : transforms) {
+		texture.Draw(t.ToMatrix(), view, benchProjection);
+	}
+	legacy.submitMs = MillisecondsSince(start);
+	glFinish();
+	legacy.finishMs = MillisecondsSince(start);
+	legacy.uploadBytes = static_cast<size_t>(count) * 3 * sizeof(glm::mat4);
+	benchmarkResults.push_back(legacy);
+
+	BenchmarkResult instanced{ "Instanced" };
+	start = std::chrono::steady_clock::now();
+	Begin(benchProjection);
+	for (const Transform& t : transforms) {
+		Submit(texture.texture->ID, SpriteInstance::FromMatrix(t.ToMatrix()));
+	}
+	End();
+	instanced.submitMs = MillisecondsSince(start);
+	glFinish();
+	instanced.finishMs = MillisecondsSince(start);
+	instanced.uploadBytes = stats.uploadBytes;
+	benchmarkResults.push_back(instanced);
+
+	glDisable(GL_SCISSOR_TEST);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Shader.h"
+
+//Per-instance data streamed to the instanced sprite shader
+struct SpriteInstance {
+	glm::vec2 axisX;   // first column of the 2x3 affine transform
+	glm::vec2 axisY;   // second column
+	glm::vec2 offset;  // translation
+	glm::vec4 uvRect = { 0.0f, 0.0f, 1.0f, 1.0f }; // offset.xy, size.zw
+	glm::vec4 tint = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	static SpriteInstance FromMatrix(const glm::mat4& model) {
+		SpriteInstance instance;
+		instance.axisX = glm::vec2(model[0]);
+		instance.axisY = glm::vec2(model[1]);
+		instance.offset = glm::vec2(model[3]);
+		return instance;
+	}
+};
+
+//Draws sprites as instances of one static unit quad.
+//Submissions are buffered for the frame, uploaded in a single orphaned write to one of
+//RingSize instance buffers, then drawn as one glDrawArraysInstanced per run of the same texture.
+class SpriteRenderer {
+public:
+	static constexpr int RingSize = 3;
+
+	struct Stats {
+		int instances = 0;
+		int drawCalls = 0;
+		size_t uploadBytes = 0;
+		float submitMs = 0.0f;
+	};
+
+	struct BenchmarkResult {
+		std::string label;
+		float submitMs = 0.0f;  // CPU time to issue the frame
+		float finishMs = 0.0f;  // including glFinish
+		size_t uploadBytes = 0; // vertex and uniform data sent per frame
+	};
+
+	SpriteRenderer() = default;
+	~SpriteRenderer();
+	SpriteRenderer(const SpriteRenderer&) = delete;
+	SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+
+	void Init();
+	void Shutdown();
+
+	bool IsInstancing() const { return instancing && shader != nullptr; }
+	void SetInstancing(bool enabled) { instancing = enabled; }
+
+	void Begin(const glm::mat4& projection);
+	//Consecutive sprites with the same texture are merged into one draw call
+	void Submit(GLuint texture, const SpriteInstance&);
+	//Draws what has been submitted so far, so other draws can be interleaved; stats keep adding up until Begin
+	void Flush();
+	void End() { Flush(); }
+
+	const Stats& GetStats() const { return stats; }
+
+	//Draws count random sprites through the legacy and instanced paths with rasterization scissored away
+	void RunBenchmark(const glm::mat4& projection, int count);
+	int benchmarkSprites = 50000;
+	const std::vector<BenchmarkResult>& GetBenchmarkResults() const { return benchmarkResults; }
+
+private:
+	struct Batch {
+		GLuint texture;
+		int first;
+		int count;
+	};
+
+	GLuint VAO = 0;
+	GLuint quadVBO = 0;
+	GLuint instanceVBOs[RingSize] = { 0, 0, 0 };
+	size_t instanceCapacity[RingSize] = { 0, 0, 0 };
+	int ringIndex = 0;
+
+	std::unique_ptr<Shader> shader;
+	bool instancing = true;
+
+	glm::mat4 projection = glm::mat4(1.0f);
+	std::vector<SpriteInstance> instances;
+	std::vector<Batch> batches;
+	Stats stats;
+	std::vector<BenchmarkResult> benchmarkResults;
+
+	void BindInstanceAttributes(size_t byteOffset) const;
+};
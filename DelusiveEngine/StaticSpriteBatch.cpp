@@ -0,0 +1,254 @@
+#include "StaticSpriteBatch.h"
+#include "DelusiveData.h"
+#include "DelusiveUtils.h"
+#include "UnitQuad.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+	uint64_t ChunkKey(const glm::mat4& model) {
+		const int x = static_cast<int>(std::floor(model[3].x / StaticSpriteBatch::ChunkSize));
+		const int y = static_cast<int>(std::floor(model[3].y / StaticSpriteBatch::ChunkSize));
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+
+	bool Overlaps(const Zone& a, const Zone& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+}
+
+size_t StaticSpriteBatch::LayerSlot(int layer, bool foreground) {
+	return static_cast<size_t>(std::clamp(layer, -128, 127) + 128) * 2 + (foreground ? 1 : 0);
+}
+
+StaticSpriteBatch::~StaticSpriteBatch() {
+	Clear();
+}
+
+StaticSpriteBatch& StaticSpriteBatch::operator=(StaticSpriteBatch&& other) noexcept {
+	if (this != &other) {
+		Clear();
+		chunks = std::move(other.chunks);
+		pending = std::move(other.pending);
+		textures = std::move(other.textures);
+		layers = other.layers;
+		stats = other.stats;
+		other.chunks.clear();
+	}
+	return *this;
+}
+
+void StaticSpriteBatch::Release(Chunk& chunk) {
+	if (chunk.VBO) glDeleteBuffers(1, &chunk.VBO);
+	if (chunk.VAO) glDeleteVertexArrays(1, &chunk.VAO);
+	chunk.VAO = chunk.VBO = 0;
+}
+
+void StaticSpriteBatch::Clear() {
+	for (auto& [key, chunk] : chunks) Release(chunk);
+	chunks.clear();
+	pending.clear();
+	textures.Clear();
+	layers.reset();
+	stats = Stats{};
+}
+
+void StaticSpriteBatch::Begin() {
+	pending.clear();
+	textures.Clear();
+}
+
+void StaticSpriteBatch::End() {
+	// Sprites per (layer, foreground) slot, a slot is ordered as a whole because runs from
+	// different chunks interleave in the render queue
+	std::vector<std::vector<const Sprite*>> slots(LayerMask().size());
+	for (const Sprite& sprite : pending) {
+		slots[LayerSlot(sprite.layer, sprite.foreground)].push_back(&sprite);
+	}
+
+	stats = Stats{};
+	layers.reset();
+	for (auto& [key, chunk] : chunks) chunk.alive = false;
+
+	std::unordered_map<uint64_t, std::vector<Piece>> grouped;
+	for (size_t slot = 0; slot < slots.size(); ++slot) {
+		std::vector<const Sprite*>& sprites = slots[slot];
+		if (sprites.empty()) continue;
+		layers.set(slot);
+
+		const bool ordered = AnyOverlap(sprites);
+		if (ordered) ++stats.orderedLayers;
+		const auto yKey = [](const Sprite* sprite) {
+			return RenderQueue::MakeKey(sprite->layer, sprite->foreground, sprite->sortY, 0, 0);
+		};
+		std::stable_sort(sprites.begin(), sprites.end(), [&](const Sprite* a, const Sprite* b) {
+			if (ordered && yKey(a) != yKey(b)) return yKey(a) < yKey(b);
+			const uint64_t chunkA = ChunkKey(a->model), chunkB = ChunkKey(b->model);
+			if (chunkA != chunkB) return chunkA < chunkB;
+			return a->texture < b->texture;
+		});
+
+		// Without overlaps the draw order cannot show, so a run is every sprite of one texture in a chunk.
+		// Otherwise a run is cut wherever the y order moves to another chunk or texture, and runs are
+		// queued by their first y. Equal y sorts by texture in the queue, so only one run may start
+		// on a y and carry on past it.
+		const Sprite* previous = nullptr;
+		int runsStartedOnY = 0;
+		for (const Sprite* sprite : sprites) {
+			bool startsBatch = previous == nullptr
+				|| ChunkKey(previous->model) != ChunkKey(sprite->model)
+				|| previous->texture != sprite->texture;
+			if (ordered && previous && yKey(previous) != yKey(sprite)) {
+				if (runsStartedOnY > 1) startsBatch = true;
+				runsStartedOnY = 0;
+			}
+			if (startsBatch) ++runsStartedOnY;
+			grouped[ChunkKey(sprite->model)].push_back({ sprite, startsBatch });
+			previous = sprite;
+		}
+	}
+
+	for (auto& [key, pieces] : grouped) {
+		// Cuts depend on the neighbouring chunks, so they are part of the hash
+		uint64_t hash = FnvOffset;
+		for (const Piece& piece : pieces) {
+			const Sprite* sprite = piece.sprite;
+			HashBytes(hash, &sprite->model, sizeof(sprite->model));
+			HashBytes(hash, &sprite->texture, sizeof(sprite->texture));
+			HashBytes(hash, &sprite->layer, sizeof(sprite->layer));
+			HashBytes(hash, &sprite->foreground, sizeof(sprite->foreground));
+			HashBytes(hash, &sprite->sortY, sizeof(sprite->sortY));
+			HashBytes(hash, &piece.startsBatch, sizeof(piece.startsBatch));
+		}
+
+		Chunk& chunk = chunks[key];
+		chunk.alive = true;
+		if (chunk.VAO == 0 || chunk.hash != hash) {
+			chunk.hash = hash;
+			Upload(chunk, pieces);
+			++stats.rebuiltChunks;
+		}
+		stats.sprites += static_cast<int>(pieces.size());
+		stats.batches += static_cast<int>(chunk.batches.size());
+	}
+
+	for (auto it = chunks.begin(); it != chunks.end();) {
+		if (!it->second.alive) {
+			Release(it->second);
+			it = chunks.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+	stats.chunks = static_cast<int>(chunks.size());
+	pending.clear();
+}
+
+bool StaticSpriteBatch::AnyOverlap(const std::vector<const Sprite*>& sprites) {
+	if (sprites.size() < 2) return false;
+
+	// Edges that only touch, like neighbouring tiles, are not an overlap
+	constexpr float Tolerance = 1e-4f;
+	std::vector<Zone> bounds;
+	bounds.reserve(sprites.size());
+	float averageSize = 0.0f;
+	for (const Sprite* sprite : sprites) {
+		const glm::vec2 center(sprite->model[3]);
+		const glm::vec2 extent = 0.5f * (glm::abs(glm::vec2(sprite->model[0])) + glm::abs(glm::vec2(sprite->model[1])));
+		bounds.push_back({ center - extent + Tolerance, center + extent - Tolerance });
+		averageSize += 2.0f * std::max(extent.x, extent.y);
+	}
+	const float cellSize = std::max(2.0f * averageSize / static_cast<float>(sprites.size()), Tolerance);
+
+	// Sprites spanning many cells are assumed to overlap, the ordered path is always correct
+	constexpr int MaxCells = 16;
+	std::unordered_map<uint64_t, std::vector<int>> cells;
+	for (int i = 0; i < static_cast<int>(bounds.size()); ++i) {
+		const Zone& zone = bounds[i];
+		const int minX = static_cast<int>(std::floor(zone.min.x / cellSize));
+		const int minY = static_cast<int>(std::floor(zone.min.y / cellSize));
+		const int maxX = static_cast<int>(std::floor(zone.max.x / cellSize));
+		const int maxY = static_cast<int>(std::floor(zone.max.y / cellSize));
+		if ((maxX - minX + 1) * (maxY - minY + 1) > MaxCells) return true;
+
+		for (int x = minX; x <= maxX; ++x) {
+			for (int y = minY; y <= maxY; ++y) {
+				auto& cell = cells[(static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y)];
+				for (int other : cell) {
+					if (Overlaps(zone, bounds[other])) return true;
+				}
+				cell.push_back(i);
+			}
+		}
+	}
+	return false;
+}
+
+void StaticSpriteBatch::Upload(Chunk& chunk, const std::vector<Piece>& pieces) {
+	constexpr int floatsPerVertex = 4;
+	std::vector<float> vertices;
+	vertices.reserve(pieces.size() * UnitQuadVertexCount * floatsPerVertex);
+
+	chunk.batches.clear();
+	chunk.bounds = { glm::vec2(std::numeric_limits<float>::max()), glm::vec2(-std::numeric_limits<float>::max()) };
+	for (const Piece& piece : pieces) {
+		const Sprite* sprite = piece.sprite;
+		const GLint first = static_cast<GLint>(vertices.size() / floatsPerVertex);
+		if (piece.startsBatch || chunk.batches.empty()) {
+			chunk.batches.push_back({ sprite->layer, sprite->foreground, sprite->sortY, sprite->texture, first, 0 });
+		}
+		chunk.batches.back().count += UnitQuadVertexCount;
+
+		for (int v = 0; v < UnitQuadVertexCount; ++v) {
+			const float* source = &UnitQuadVertices[v * floatsPerVertex];
+			const glm::vec2 world(sprite->model * glm::vec4(source[0], source[1], 0.0f, 1.0f));
+			chunk.bounds.min = glm::min(chunk.bounds.min, world);
+			chunk.bounds.max = glm::max(chunk.bounds.max, world);
+			vertices.insert(vertices.end(), { world.x, world.y, source[2], source[3] });
+		}
+	}
+
+	if (chunk.VAO == 0) {
+		glGenVertexArrays(1, &chunk.VAO);
+		glGenBuffers(1, &chunk.VBO);
+		glBindVertexArray(chunk.VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, floatsPerVertex * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, floatsPerVertex * sizeof(float), (void*)(2 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+		glBindVertexArray(0);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StaticSpriteBatch::Record(RenderQueue& queue, const Zone& view, const LayerMask& skip) {
+	stats.visibleChunks = 0;
+	stats.recordedBatches = 0;
+
+	for (const auto& [key, chunk] : chunks) {
+		if (!Overlaps(chunk.bounds, view)) continue;
+		++stats.visibleChunks;
+
+		for (const Batch& batch : chunk.batches) {
+			if (skip.test(LayerSlot(batch.layer, batch.foreground))) continue;
+
+			RenderQueue::Command command;
+			command.program = queue.GetSpriteProgram();
+			command.vao = chunk.VAO;
+			command.texture = batch.texture;
+			command.firstVertex = batch.first;
+			command.vertexCount = batch.count;
+			command.model = glm::mat4(1.0f);
+			command.key = RenderQueue::MakeKey(batch.layer, batch.foreground, batch.sortY,
+				queue.GetShaderSlot(command.program), queue.GetTextureSlot(command.texture));
+			queue.Push(command);
+			++stats.recordedBatches;
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PhysicsTypes.h"
+#include "RenderQueue.h"
+
+struct DelusiveTexture;
+
+//Bakes sprites that never move into world-space vertex buffers, one per ChunkSize square.
+//Each chunk holds runs of one (layer, foreground, texture) that the render queue draws with one
+//call, and chunks outside the view are skipped whole. Where sprites of a layer overlap, runs are cut
+//so the queue still draws them in y order. Rebuilding compares a hash of every chunk's sprites,
+//so an edit only re-uploads the chunks it touched.
+class StaticSpriteBatch {
+public:
+	static constexpr float ChunkSize = 16.0f;
+
+	//One bit per (layer, foreground) pair, see LayerSlot
+	using LayerMask = std::bitset<512>;
+	static size_t LayerSlot(int layer, bool foreground);
+
+	struct Sprite {
+		glm::mat4 model;
+		GLuint texture;
+		int layer;
+		bool foreground;
+		float sortY;
+	};
+
+	struct Stats {
+		int chunks = 0;
+		int batches = 0;
+		int sprites = 0;
+		int rebuiltChunks = 0;   // by the last End()
+		int visibleChunks = 0;   // by the last Record()
+		int recordedBatches = 0;
+		int orderedLayers = 0;   // layers with overlapping sprites, batched in y order
+	};
+
+	StaticSpriteBatch() = default;
+	~StaticSpriteBatch();
+	StaticSpriteBatch(const StaticSpriteBatch&) = delete;
+	StaticSpriteBatch& operator=(const StaticSpriteBatch&) = delete;
+	StaticSpriteBatch(StaticSpriteBatch&&) noexcept = default;
+	StaticSpriteBatch& operator=(StaticSpriteBatch&&) noexcept;
+
+	//Collect every baked sprite between Begin and End, End uploads the chunks that changed
+	void Begin();
+	void Add(const Sprite& sprite) { pending.push_back(sprite); }
+	//Shared GL name for the texture's path until the next Begin, see SharedTextureTable
+	GLuint ResolveTexture(const DelusiveTexture& texture) { return textures.Resolve(texture); }
+	void End();
+	void Clear();
+
+	//Layers set in skip are left out, the caller draws those sprites individually
+	void Record(RenderQueue&, const Zone& view, const LayerMask& skip);
+
+	//Layers that have at least one baked sprite
+	const LayerMask& GetLayers() const { return layers; }
+	const Stats& GetStats() const { return stats; }
+
+private:
+	struct Batch {
+		int layer;
+		bool foreground;
+		float sortY;       // of the first sprite, orders runs against each other
+		GLuint texture;
+		GLint first;
+		GLsizei count;
+	};
+
+	struct Chunk {
+		GLuint VAO = 0, VBO = 0;
+		uint64_t hash = 0;
+		Zone bounds{ glm::vec2(0.0f), glm::vec2(0.0f) };
+		std::vector<Batch> batches;
+		bool alive = false;
+	};
+
+	struct Piece {
+		const Sprite* sprite;
+		bool startsBatch;
+	};
+
+	static bool AnyOverlap(const std::vector<const Sprite*>& sprites);
+	void Upload(Chunk&, const std::vector<Piece>& pieces);
+	static void Release(Chunk&);
+
+	std::unordered_map<uint64_t, Chunk> chunks;
+	std::vector<Sprite> pending;
+	SharedTextureTable textures;
+	LayerMask layers;
+	Stats stats;
+};
@@ -0,0 +1,137 @@
+#include "TextBatch.h"
+#include "DelusiveMacros.h"
+#include <cstddef>
+
+TextBatch::~TextBatch() {
+	Shutdown();
+}
+
+void TextBatch::Init() {
+	Shutdown();
+
+	shader = std::make_unique<Shader>(DEFAULT_TEXT_VERT, DEFAULT_TEXT_FRAG);
+	sdfShader = std::make_unique<Shader>(DEFAULT_TEXT_VERT, DEFAULT_TEXT_SDF_FRAG);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	SetVertexLayout();
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void TextBatch::Shutdown() {
+	if (VBO) glDeleteBuffers(1, &VBO);
+	if (VAO) glDeleteVertexArrays(1, &VAO);
+	VAO = VBO = 0;
+	shader.reset();
+	sdfShader.reset();
+}
+
+void TextBatch::SetVertexLayout() {
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, uv));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, color));
+}
+
+void TextBatch::UseShader(Shader& program, const glm::mat4& projection) {
+	program.Use();
+	program.SetMat4("projection", projection);
+	program.SetMat4("model", glm::mat4(1.0f));
+	program.SetInt("tex", 0);
+}
+
+void TextBatch::DrawVertices(GLuint vao, GLuint vbo, GLuint atlas, const std::vector<TextVertex>& source, size_t first, size_t count) {
+	if (count == 0) return;
+
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	// Orphan, then fill: the previous contents may still be in flight
+	glBufferData(GL_ARRAY_BUFFER, count * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(TextVertex), source.data() + first);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TextBatch::Begin(const glm::mat4& _projection) {
+	projection = _projection;
+	vertices.clear();
+	runs.clear();
+	stats = Stats{};
+	active = true;
+}
+
+void TextBatch::Add(const Font& font, const std::string& text, glm::vec2 position, float scale, const glm::vec4& color) {
+	const size_t before = vertices.size();
+	font.AppendQuads(text, position, scale, color, vertices);
+	AddRun(font, before, vertices.size() - before);
+}
+
+void TextBatch::AddVertices(const Font& font, const std::vector<TextVertex>& quads) {
+	const size_t before = vertices.size();
+	vertices.insert(vertices.end(), quads.begin(), quads.end());
+	AddRun(font, before, quads.size());
+}
+
+void TextBatch::AddRun(const Font& font, size_t before, size_t added) {
+	if (added == 0) return;
+
+	if (runs.empty() || runs.back().atlas != font.GetAtlasTexture()) {
+		runs.push_back({ font.GetAtlasTexture(), font.IsSDF(), before, 0 });
+	}
+	runs.back().count += added;
+
+	++stats.strings;
+	stats.glyphs += static_cast<int>(added / 6);
+}
+
+void TextBatch::Flush() {
+	if (runs.empty() || !shader || !sdfShader) {
+		vertices.clear();
+		runs.clear();
+		return;
+	}
+
+	GLboolean wasBlend = glIsEnabled(GL_BLEND);
+	if (!wasBlend) glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// One upload covers every run, runs only differ in the atlas and shader bound
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(TextVertex), vertices.data());
+	glActiveTexture(GL_TEXTURE0);
+	Shader* bound = nullptr;
+	for (const Run& run : runs) {
+		Shader* wanted = run.sdf ? sdfShader.get() : shader.get();
+		if (wanted != bound) {
+			UseShader(*wanted, projection);
+			bound = wanted;
+		}
+		glBindTexture(GL_TEXTURE_2D, run.atlas);
+		glDrawArrays(GL_TRIANGLES, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+		++stats.drawCalls;
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (!wasBlend) glDisable(GL_BLEND);
+
+	vertices.clear();
+	runs.clear();
+}
+
+void TextBatch::End() {
+	Flush();
+	active = false;
+}
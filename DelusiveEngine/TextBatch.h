@@ -0,0 +1,66 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Font.h"
+#include "Shader.h"
+
+//Collects text from many labels into one vertex buffer and draws each run of the same
+//font atlas with a single call. UICanvas opens a batch around its elements; anything
+//drawn between texts (images, panels) must Flush first so layering is kept.
+//SDF fonts are drawn with the distance threshold shader, bitmap fonts with the coverage one.
+class TextBatch {
+public:
+	struct Stats {
+		int strings = 0;
+		int glyphs = 0;
+		int drawCalls = 0;
+	};
+
+	TextBatch() = default;
+	~TextBatch();
+	TextBatch(const TextBatch&) = delete;
+	TextBatch& operator=(const TextBatch&) = delete;
+
+	void Init();
+	void Shutdown();
+
+	void Begin(const glm::mat4& projection);
+	bool IsActive() const { return active; }
+	void Add(const Font&, const std::string& text, glm::vec2 position, float scale, const glm::vec4& color);
+	//Already shaped quads, see TextLayout::Place
+	void AddVertices(const Font&, const std::vector<TextVertex>& quads);
+	void Flush();
+	void End();
+
+	const Stats& GetStats() const { return stats; }
+
+	//Vertex layout of TextVertex for locations 0 (position), 1 (uv) and 2 (color)
+	static void SetVertexLayout();
+	//Binds program with the per-frame text uniforms
+	static void UseShader(Shader& program, const glm::mat4& projection);
+	//Uploads and draws one atlas worth of vertices with the text shader already bound
+	static void DrawVertices(GLuint vao, GLuint vbo, GLuint atlas, const std::vector<TextVertex>&, size_t first, size_t count);
+
+private:
+	struct Run {
+		GLuint atlas;
+		bool sdf;
+		size_t first;
+		size_t count;
+	};
+
+	std::unique_ptr<Shader> shader;
+	std::unique_ptr<Shader> sdfShader;
+	GLuint VAO = 0, VBO = 0;
+	bool active = false;
+	glm::mat4 projection = glm::mat4(1.0f);
+
+	std::vector<TextVertex> vertices;
+	std::vector<Run> runs;
+	Stats stats;
+
+	void AddRun(const Font&, size_t first, size_t added);
+};
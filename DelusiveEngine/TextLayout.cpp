@@ -0,0 +1,115 @@
+#include "TextLayout.h"
+#include <algorithm>
+#include <cfloat>
+
+bool TextLayout::Build(const std::shared_ptr<Font>& _font, const std::string& _text, float _scale,
+	float _width, TextAlign _align, bool _wrap) {
+	if (font.lock() == _font && text == _text && scale == _scale &&
+		width == _width && align == _align && wrap == _wrap) {
+		return false;
+	}
+
+	font = _font;
+	text = _text;
+	scale = _scale;
+	width = _width;
+	align = _align;
+	wrap = _wrap;
+
+	shaped.clear();
+	placedValid = false;
+	boundsMin = boundsMax = { 0.0f, 0.0f };
+	lineCount = 0;
+	if (!_font) return true;
+
+	std::vector<Line> lines;
+	BreakLines(*_font, lines);
+	lineCount = static_cast<int>(lines.size());
+
+	float boxWidth = width;
+	if (boxWidth <= 0.0f) {
+		for (const Line& line : lines) boxWidth = std::max(boxWidth, line.width);
+	}
+
+	const float lineHeight = _font->GetLineHeight() * scale;
+	const glm::vec4 white(1.0f);
+	for (size_t i = 0; i < lines.size(); ++i) {
+		const Line& line = lines[i];
+		float x = 0.0f;
+		if (align == TextAlign::Center) x = (boxWidth - line.width) * 0.5f;
+		else if (align == TextAlign::Right) x = boxWidth - line.width;
+
+		_font->AppendQuads(text.substr(line.first, line.count), { x, -lineHeight * i }, scale, white, shaped);
+	}
+
+	if (!shaped.empty()) {
+		boundsMin = glm::vec2(FLT_MAX);
+		boundsMax = glm::vec2(-FLT_MAX);
+		for (const TextVertex& vertex : shaped) {
+			boundsMin = glm::min(boundsMin, vertex.position);
+			boundsMax = glm::max(boundsMax, vertex.position);
+		}
+	}
+	return true;
+}
+
+void TextLayout::BreakLines(const Font& source, std::vector<Line>& out) const {
+	const bool wrapping = wrap && width > 0.0f;
+	size_t lineStart = 0;
+	float lineWidth = 0.0f;
+	size_t lastSpace = std::string::npos;
+	float widthBeforeSpace = 0.0f;
+	float widthAfterSpace = 0.0f;
+
+	for (size_t i = 0; i < text.size(); ++i) {
+		const char c = text[i];
+		if (c == '\n') {
+			out.push_back({ lineStart, i - lineStart, lineWidth });
+			lineStart = i + 1;
+			lineWidth = 0.0f;
+			lastSpace = std::string::npos;
+			continue;
+		}
+
+		const float advance = source.GetCharacter(c).advance * scale;
+		if (wrapping && c != ' ' && i > lineStart && lineWidth + advance > width) {
+			if (lastSpace != std::string::npos) {
+				// Break at the last space, which is dropped
+				out.push_back({ lineStart, lastSpace - lineStart, widthBeforeSpace });
+				lineStart = lastSpace + 1;
+				lineWidth -= widthAfterSpace;
+			}
+			else {
+				// A single word wider than the box is split where it overflows
+				out.push_back({ lineStart, i - lineStart, lineWidth });
+				lineStart = i;
+				lineWidth = 0.0f;
+			}
+			lastSpace = std::string::npos;
+		}
+
+		if (c == ' ') {
+			lastSpace = i;
+			widthBeforeSpace = lineWidth;
+			widthAfterSpace = lineWidth + advance;
+		}
+		lineWidth += advance;
+	}
+	out.push_back({ lineStart, text.size() - lineStart, lineWidth });
+}
+
+const std::vector<TextVertex>& TextLayout::Place(glm::vec2 position, const glm::vec4& color) {
+	if (placedValid && position == placedPosition && color == placedColor) {
+		return placed;
+	}
+
+	placed = shaped;
+	for (TextVertex& vertex : placed) {
+		vertex.position += position;
+		vertex.color = color;
+	}
+	placedPosition = position;
+	placedColor = color;
+	placedValid = true;
+	return placed;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Font.h"
+
+enum class TextAlign { Left = 0, Center = 1, Right = 2 };
+
+//Shaped quads for one string, rebuilt only when the text, font, scale or box changes.
+//Place() translates and colours the cached quads; when neither changed it hands back the
+//same vertices, so static HUD text costs a copy into the TextBatch per frame.
+class TextLayout {
+public:
+	//width is the box lines are aligned in (and wrapped to when wrap is set), 0 sizes it to the widest line.
+	//Returns true when the layout had to be rebuilt.
+	bool Build(const std::shared_ptr<Font>& font, const std::string& text, float scale,
+		float width = 0.0f, TextAlign align = TextAlign::Left, bool wrap = false);
+
+	//Vertices with the first baseline starting at position
+	const std::vector<TextVertex>& Place(glm::vec2 position, const glm::vec4& color);
+
+	void Invalidate() { font.reset(); }
+
+	//Relative to the first baseline, y grows upwards like the UI projection
+	glm::vec2 GetBoundsMin() const { return boundsMin; }
+	glm::vec2 GetBoundsMax() const { return boundsMax; }
+	int GetLineCount() const { return lineCount; }
+
+private:
+	struct Line {
+		size_t first;
+		size_t count;
+		float width;
+	};
+	void BreakLines(const Font&, std::vector<Line>& out) const;
+
+	std::weak_ptr<Font> font;
+	std::string text;
+	float scale = 0.0f;
+	float width = 0.0f;
+	TextAlign align = TextAlign::Left;
+	bool wrap = false;
+
+	std::vector<TextVertex> shaped;     // origin at the first baseline, white
+	std::vector<TextVertex> placed;
+	bool placedValid = false;
+	glm::vec2 placedPosition = { 0.0f, 0.0f };
+	glm::vec4 placedColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	glm::vec2 boundsMin = { 0.0f, 0.0f };
+	glm::vec2 boundsMax = { 0.0f, 0.0f };
+	int lineCount = 0;
+};
@@ -0,0 +1,677 @@
+#include "TilemapComponent.h"
+#include "Agent.h"
+#include "DelusiveUtils.h"
+#include "DeterministicMath.h"
+#include "Scene.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <glm/gtc/matrix_transform.hpp>
+#include <imgui/imgui.h>
+#include <stb/stb_image.h>
+
+namespace {
+	constexpr int ChunkArea = TilemapComponent::ChunkTiles * TilemapComponent::ChunkTiles;
+
+	struct TileVertex {
+		GLshort x, y;   // chunk-local tile corner
+		GLushort u, v;  // normalized atlas coordinates
+	};
+
+	// Greedy meshing: grow a run along x, then extend it upward while every row above matches it.
+	// Output rects are (x, y, width, height) in chunk-local tiles.
+	template<typename Include>
+	void MergeTiles(const std::vector<uint16_t>& tiles, Include include, std::vector<glm::ivec4>& out) {
+		constexpr int N = TilemapComponent::ChunkTiles;
+		uint8_t open[ChunkArea];
+		for (int i = 0; i < ChunkArea; ++i) {
+			open[i] = include(tiles[i]) ? 1 : 0;
+		}
+
+		for (int y = 0; y < N; ++y) {
+			for (int x = 0; x < N; ++x) {
+				if (!open[y * N + x]) continue;
+
+				int width = 1;
+				while (x + width < N && open[y * N + x + width]) ++width;
+
+				int height = 1;
+				for (; y + height < N; ++height) {
+					const uint8_t* row = &open[(y + height) * N + x];
+					if (std::find(row, row + width, 0) != row + width) break;
+				}
+
+				for (int j = 0; j < height; ++j) {
+					std::fill_n(&open[(y + j) * N + x], width, 0);
+				}
+				out.push_back({ x, y, width, height });
+			}
+		}
+	}
+
+	GLushort ToUnorm16(float value) {
+		return static_cast<GLushort>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+	}
+}
+
+TilemapComponent::TilemapComponent() {
+	SetName("New Tilemap");
+	stbi_set_flip_vertically_on_load(true); // atlas rows are addressed from the top, see GetAtlasRect
+	tileset.Init(); // shader for Draw, the tileset itself is loaded by ApplyEdits
+	mapWidth = 32;
+	mapHeight = 32;
+	Resize(mapWidth, mapHeight);
+}
+
+TilemapComponent::~TilemapComponent() {
+	ReleaseMeshes();
+}
+
+void TilemapComponent::RegisterProperties() {
+	Component::RegisterProperties();
+	registry->Register("tileset", &tileset);
+	registry->Register("atlasColumns", &atlasColumns);
+	registry->Register("atlasRows", &atlasRows);
+	registry->Register("tileSize", &tileSize);
+	registry->Register("mapWidth", &mapWidth);
+	registry->Register("mapHeight", &mapHeight);
+	registry->Register("renderOrder", &renderOrder);
+	registry->Register("tileFlags", &tileFlags);
+	registry->Register("tiles", &savedTiles);
+}
+
+std::unique_ptr<Component> TilemapComponent::Clone() const {
+	auto clone = std::make_unique<TilemapComponent>();
+	clone->RegisterProperties(); // AddRawComponent does not register, unlike AddComponent
+	clone->SetName(GetName());
+	clone->SetEnabled(enabled);
+	clone->transform = transform;
+	clone->tileset.texturePath = tileset.texturePath;
+	clone->atlasColumns = atlasColumns;
+	clone->atlasRows = atlasRows;
+	clone->tileSize = tileSize;
+	clone->mapWidth = mapWidth;
+	clone->mapHeight = mapHeight;
+	clone->renderOrder = renderOrder;
+	clone->tileFlags = tileFlags;
+	clone->ApplyEdits();
+
+	for (size_t i = 0; i < chunks.size() && i < clone->chunks.size(); ++i) {
+		clone->chunks[i].tiles = chunks[i].tiles;
+		clone->chunks[i].tileCount = chunks[i].tileCount;
+	}
+	clone->RebuildAllColliders();
+	return clone;
+}
+
+glm::mat4 TilemapComponent::GetModel() const {
+	glm::mat4 model = transform.ToMatrix();
+	if (owner) model = owner->GetTransform().ToMatrix() * model;
+	return glm::scale(model, glm::vec3(tileSize, tileSize, 1.0f));
+}
+
+void TilemapComponent::SetOwner(Agent* agent) {
+	Component::SetOwner(agent);
+	for (Chunk& chunk : chunks) {
+		for (auto& collider : chunk.colliders) {
+			collider->SetOwner(agent);
+		}
+	}
+}
+
+void TilemapComponent::CollectColliders(std::vector<ColliderComponent*>& out) {
+	if (!enabled) return;
+	for (Chunk& chunk : chunks) {
+		for (auto& collider : chunk.colliders) {
+			out.push_back(collider.get());
+		}
+	}
+}
+
+void TilemapComponent::MarkSceneDirty() {
+	// Tile colliders sit in the scene's static collider grid and are baked into the nav grid
+	if (owner && owner->GetScene()) {
+		owner->GetScene()->MarkAgentEdited(*owner);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Tiles
+// ---------------------------------------------------------------------------
+
+void TilemapComponent::Resize(int width, int height) {
+	width = std::max(width, 0);
+	height = std::max(height, 0);
+
+	ReleaseMeshes();
+	std::vector<Chunk> previous = std::move(chunks);
+	const glm::ivec2 previousCount = chunkCount;
+
+	chunkCount = { (width + ChunkTiles - 1) / ChunkTiles, (height + ChunkTiles - 1) / ChunkTiles };
+	chunks.clear();
+	chunks.resize(static_cast<size_t>(chunkCount.x) * chunkCount.y);
+	mapWidth = width;
+	mapHeight = height;
+	appliedSize = { width, height };
+
+	// Keep every tile that still fits
+	for (int cy = 0; cy < previousCount.y; ++cy) {
+		for (int cx = 0; cx < previousCount.x; ++cx) {
+			const Chunk& old = previous[static_cast<size_t>(cy) * previousCount.x + cx];
+			if (old.tiles.empty()) continue;
+
+			for (int i = 0; i < ChunkArea; ++i) {
+				if (old.tiles[i] == 0) continue;
+				WriteTile(cx * ChunkTiles + i % ChunkTiles, cy * ChunkTiles + i / ChunkTiles, old.tiles[i]);
+			}
+		}
+	}
+
+	RebuildAllColliders();
+}
+
+uint16_t TilemapComponent::GetTile(int x, int y) const {
+	if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return 0;
+
+	const Chunk& chunk = chunks[static_cast<size_t>(y / ChunkTiles) * chunkCount.x + x / ChunkTiles];
+	if (chunk.tiles.empty()) return 0;
+	return chunk.tiles[(y % ChunkTiles) * ChunkTiles + x % ChunkTiles];
+}
+
+bool TilemapComponent::WriteTile(int x, int y, uint16_t id) {
+	if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return false;
+
+	Chunk& chunk = chunks[static_cast<size_t>(y / ChunkTiles) * chunkCount.x + x / ChunkTiles];
+	if (chunk.tiles.empty()) {
+		if (id == 0) return false;
+		chunk.tiles.assign(ChunkArea, 0);
+	}
+
+	uint16_t& tile = chunk.tiles[(y % ChunkTiles) * ChunkTiles + x % ChunkTiles];
+	if (tile == id) return false;
+
+	chunk.tileCount += (id != 0) - (tile != 0);
+	const bool flagsChanged = GetTileFlags(tile) != GetTileFlags(id);
+	tile = id;
+	chunk.meshDirty = true;
+
+	if (chunk.tileCount == 0) {
+		chunk.tiles.clear();
+		chunk.tiles.shrink_to_fit();
+	}
+	return flagsChanged;
+}
+
+void TilemapComponent::SetTile(int x, int y, uint16_t id) {
+	if (WriteTile(x, y, id)) {
+		const int cx = x / ChunkTiles;
+		const int cy = y / ChunkTiles;
+		RebuildColliders(chunks[static_cast<size_t>(cy) * chunkCount.x + cx], cx, cy);
+	}
+}
+
+void TilemapComponent::Fill(uint16_t id) {
+	for (int cy = 0; cy < chunkCount.y; ++cy) {
+		for (int cx = 0; cx < chunkCount.x; ++cx) {
+			Chunk& chunk = chunks[static_cast<size_t>(cy) * chunkCount.x + cx];
+			chunk.tiles.clear();
+			chunk.tileCount = 0;
+			chunk.meshDirty = true;
+			if (id == 0) continue;
+
+			// Edge chunks only fill the part inside the map
+			const int width = std::min(ChunkTiles, mapWidth - cx * ChunkTiles);
+			const int height = std::min(ChunkTiles, mapHeight - cy * ChunkTiles);
+			chunk.tiles.assign(ChunkArea, 0);
+			for (int y = 0; y < height; ++y) {
+				std::fill_n(&chunk.tiles[y * ChunkTiles], width, id);
+			}
+			chunk.tileCount = width * height;
+		}
+	}
+	RebuildAllColliders();
+}
+
+int TilemapComponent::GetTileFlags(uint16_t id) const {
+	return id > 0 && id < tileFlags.size() ? tileFlags[id] : 0;
+}
+
+void TilemapComponent::SetTileFlags(uint16_t id, int flags) {
+	if (id == 0 || GetTileFlags(id) == flags) return;
+	if (tileFlags.size() <= id) tileFlags.resize(static_cast<size_t>(id) + 1, 0);
+	tileFlags[id] = flags;
+	RebuildAllColliders();
+}
+
+glm::ivec2 TilemapComponent::WorldToTile(const glm::vec2& world) const {
+	const glm::vec2 local(glm::inverse(GetModel()) * glm::vec4(world, 0.0f, 1.0f));
+	return glm::ivec2(glm::floor(local));
+}
+
+Zone TilemapComponent::GetWorldBounds() const {
+	const glm::mat4 model = GetModel();
+	const glm::vec2 corners[4] = {
+		{ 0.0f, 0.0f }, { mapWidth, 0.0f }, { mapWidth, mapHeight }, { 0.0f, mapHeight }
+	};
+
+	Zone bounds{ glm::vec2(std::numeric_limits<float>::max()), glm::vec2(-std::numeric_limits<float>::max()) };
+	for (const glm::vec2& corner : corners) {
+		const glm::vec2 world(model * glm::vec4(corner, 0.0f, 1.0f));
+		bounds.min = glm::min(bounds.min, world);
+		bounds.max = glm::max(bounds.max, world);
+	}
+	return bounds;
+}
+
+// ---------------------------------------------------------------------------
+// Collision
+// ---------------------------------------------------------------------------
+
+void TilemapComponent::RebuildColliders(Chunk& chunk, int chunkX, int chunkY) {
+	std::vector<glm::ivec4> rects;
+	chunk.navBlockers.clear();
+	if (!chunk.tiles.empty()) {
+		MergeTiles(chunk.tiles, [this](uint16_t id) { return HasFlag(id, TileFlag::Solid); }, rects);
+
+		std::vector<glm::ivec4> blockers;
+		MergeTiles(chunk.tiles, [this](uint16_t id) {
+			return HasFlag(id, TileFlag::NavBlocked) && !HasFlag(id, TileFlag::Solid);
+		}, blockers);
+		for (const glm::ivec4& rect : blockers) {
+			chunk.navBlockers.push_back({ { rect.x, rect.y }, { rect.z, rect.w } });
+		}
+	}
+
+	// Colliders are relative to the agent, so fold in this component's transform.
+	// Existing colliders are reused so physics keeps their proxies.
+	// Same trig as the physics path so deterministic builds place them identically.
+	const float cosine = DeterministicMath::Cos(transform.rotation);
+	const float sine = DeterministicMath::Sin(transform.rotation);
+	const glm::vec2 origin = glm::vec2(chunkX, chunkY) * static_cast<float>(ChunkTiles);
+
+	chunk.colliders.resize(rects.size());
+	for (size_t i = 0; i < rects.size(); ++i) {
+		const glm::ivec4& rect = rects[i];
+		auto& collider = chunk.colliders[i];
+		if (!collider) {
+			collider = std::make_unique<SolidCollider>();
+			collider->SetName("Tile Solid");
+			collider->SetOwner(owner);
+		}
+
+		const glm::vec2 size(rect.z, rect.w);
+		const glm::vec2 center = (origin + glm::vec2(rect.x, rect.y) + 0.5f * size) * tileSize * transform.scale;
+		collider->transform.position = transform.position
+			+ glm::vec2(cosine * center.x - sine * center.y, sine * center.x + cosine * center.y);
+		collider->transform.rotation = transform.rotation;
+		collider->transform.scale = size * tileSize * transform.scale;
+	}
+
+	MarkSceneDirty();
+}
+
+void TilemapComponent::RebuildAllColliders() {
+	for (int cy = 0; cy < chunkCount.y; ++cy) {
+		for (int cx = 0; cx < chunkCount.x; ++cx) {
+			RebuildColliders(chunks[static_cast<size_t>(cy) * chunkCount.x + cx], cx, cy);
+		}
+	}
+	appliedFlags = tileFlags;
+	appliedTileSize = tileSize;
+	appliedTransform = transform;
+}
+
+void TilemapComponent::GetNavBlockers(std::vector<Zone>& out) const {
+	if (!enabled) return;
+
+	const glm::mat4 model = GetModel();
+	for (int cy = 0; cy < chunkCount.y; ++cy) {
+		for (int cx = 0; cx < chunkCount.x; ++cx) {
+			const Chunk& chunk = chunks[static_cast<size_t>(cy) * chunkCount.x + cx];
+			const glm::vec2 origin = glm::vec2(cx, cy) * static_cast<float>(ChunkTiles);
+
+			for (const TileRect& rect : chunk.navBlockers) {
+				const glm::vec2 lo = origin + glm::vec2(rect.min);
+				const glm::vec2 hi = lo + glm::vec2(rect.size);
+				const glm::vec2 corners[4] = { lo, { hi.x, lo.y }, hi, { lo.x, hi.y } };
+
+				Zone zone{ glm::vec2(std::numeric_limits<float>::max()), glm::vec2(-std::numeric_limits<float>::max()) };
+				for (const glm::vec2& corner : corners) {
+					const glm::vec2 world(model * glm::vec4(corner, 0.0f, 1.0f));
+					zone.min = glm::min(zone.min, world);
+					zone.max = glm::max(zone.max, world);
+				}
+				out.push_back(zone);
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+// ---------------------------------------------------------------------------
+
+glm::vec4 TilemapComponent::GetAtlasRect(uint16_t id) const {
+	const int cells = atlasColumns * atlasRows;
+	const int cell = (std::max<int>(id, 1) - 1) % cells;
+	const int column = cell % atlasColumns;
+	const int row = cell / atlasColumns;
+
+	// Half a texel in from the cell edges so linear filtering does not pick up the neighbours
+	glm::vec2 inset(0.0f);
+	if (atlasPixels.x > 0 && atlasPixels.y > 0) {
+		inset = 0.5f / glm::vec2(atlasPixels);
+	}
+
+	// Images are flipped on load, so the top row of the atlas is at v = 1
+	const float u0 = static_cast<float>(column) / atlasColumns + inset.x;
+	const float u1 = static_cast<float>(column + 1) / atlasColumns - inset.x;
+	const float v0 = 1.0f - static_cast<float>(row + 1) / atlasRows + inset.y;
+	const float v1 = 1.0f - static_cast<float>(row) / atlasRows - inset.y;
+	return { u0, v0, u1, v1 };
+}
+
+void TilemapComponent::MeshChunk(const Chunk& chunk) const {
+	if (atlasPixels.x == 0 && tileset.texture) {
+		glBindTexture(GL_TEXTURE_2D, tileset.texture->ID);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &atlasPixels.x);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &atlasPixels.y);
+	}
+
+	std::vector<TileVertex> vertices;
+	vertices.reserve(static_cast<size_t>(chunk.tileCount) * UnitQuadVertexCount);
+	for (int i = 0; i < static_cast<int>(chunk.tiles.size()); ++i) {
+		const uint16_t id = chunk.tiles[i];
+		if (id == 0) continue;
+
+		const GLshort x = static_cast<GLshort>(i % ChunkTiles);
+		const GLshort y = static_cast<GLshort>(i / ChunkTiles);
+		const glm::vec4 uv = GetAtlasRect(id);
+		const GLushort u0 = ToUnorm16(uv.x), v0 = ToUnorm16(uv.y);
+		const GLushort u1 = ToUnorm16(uv.z), v1 = ToUnorm16(uv.w);
+
+		// Same winding as UnitQuadVertices
+		vertices.insert(vertices.end(), {
+			{ x, y, u0, v0 },
+			{ GLshort(x + 1), y, u1, v0 },
+			{ GLshort(x + 1), GLshort(y + 1), u1, v1 },
+			{ GLshort(x + 1), GLshort(y + 1), u1, v1 },
+			{ x, GLshort(y + 1), u0, v1 },
+			{ x, y, u0, v0 }
+		});
+	}
+
+	if (chunk.VAO == 0) {
+		glGenVertexArrays(1, &chunk.VAO);
+		glGenBuffers(1, &chunk.VBO);
+		glBindVertexArray(chunk.VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+		glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(TileVertex), (void*)offsetof(TileVertex, x));
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(TileVertex), (void*)offsetof(TileVertex, u));
+		glEnableVertexAttribArray(1);
+		glBindVertexArray(0);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TileVertex), vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	chunk.vertexCount = static_cast<GLsizei>(vertices.size());
+	chunk.meshDirty = false;
+}
+
+void TilemapComponent::MarkMeshesDirty() {
+	for (Chunk& chunk : chunks) {
+		chunk.meshDirty = true;
+	}
+}
+
+void TilemapComponent::ReleaseMeshes() {
+	for (Chunk& chunk : chunks) {
+		if (chunk.VBO) glDeleteBuffers(1, &chunk.VBO);
+		if (chunk.VAO) glDeleteVertexArrays(1, &chunk.VAO);
+		chunk.VAO = chunk.VBO = 0;
+		chunk.vertexCount = 0;
+		chunk.meshDirty = true;
+	}
+}
+
+void TilemapComponent::Record(RenderQueue& queue, const Zone& view) const {
+	stats.visibleChunks = 0;
+	stats.uploadedChunks = 0;
+	if (!tileset.texture || chunks.empty()) return;
+
+	// Clip the view to the map first, culling may be off and pass an unbounded rect
+	const Zone bounds = GetWorldBounds();
+	const Zone clipped{ glm::max(view.min, bounds.min), glm::min(view.max, bounds.max) };
+	if (clipped.min.x > clipped.max.x || clipped.min.y > clipped.max.y) return;
+
+	// Chunk range under the view, found by taking the view rect into map space
+	const glm::mat4 model = GetModel();
+	const glm::mat4 inverse = glm::inverse(model);
+	const glm::vec2 corners[4] = {
+		clipped.min, { clipped.max.x, clipped.min.y }, clipped.max, { clipped.min.x, clipped.max.y }
+	};
+	glm::vec2 lo(std::numeric_limits<float>::max()), hi(-std::numeric_limits<float>::max());
+	for (const glm::vec2& corner : corners) {
+		const glm::vec2 local(inverse * glm::vec4(corner, 0.0f, 1.0f));
+		lo = glm::min(lo, local);
+		hi = glm::max(hi, local);
+	}
+	const glm::ivec2 first = glm::clamp(glm::ivec2(glm::floor(lo / static_cast<float>(ChunkTiles))),
+		glm::ivec2(0), chunkCount - glm::ivec2(1));
+	const glm::ivec2 last = glm::clamp(glm::ivec2(glm::floor(hi / static_cast<float>(ChunkTiles))),
+		glm::ivec2(0), chunkCount - glm::ivec2(1));
+
+	const GLuint program = queue.GetSpriteProgram();
+	const GLuint texture = queue.ResolveTexture(tileset);
+	const uint64_t key = RenderQueue::MakeKey(renderOrder, false, owner ? owner->GetTransform().position.y : 0.0f,
+		queue.GetShaderSlot(program), queue.GetTextureSlot(texture));
+
+	for (int cy = first.y; cy <= last.y; ++cy) {
+		for (int cx = first.x; cx <= last.x; ++cx) {
+			const Chunk& chunk = chunks[static_cast<size_t>(cy) * chunkCount.x + cx];
+			if (chunk.tileCount == 0) continue;
+
+			if (chunk.meshDirty) {
+				MeshChunk(chunk);
+				++stats.uploadedChunks;
+			}
+			++stats.visibleChunks;
+
+			RenderQueue::Command command;
+			command.key = key;
+			command.program = program;
+			command.vao = chunk.VAO;
+			command.texture = texture;
+			command.vertexCount = chunk.vertexCount;
+			command.model = glm::translate(model, glm::vec3(glm::vec2(cx, cy) * static_cast<float>(ChunkTiles), 0.0f));
+			queue.Push(command);
+		}
+	}
+}
+
+void TilemapComponent::Draw(const glm::mat4& projection) const {
+	if (!enabled || !tileset.texture || !tileset.shader) return;
+
+	const glm::mat4 model = GetModel();
+	const glm::mat4 view(1.0f);
+	tileset.shader->Use();
+	glActiveTexture(GL_TEXTURE0);
+	tileset.texture->Bind();
+	glUniform1i(glGetUniformLocation(tileset.shader->GetID(), "tex"), 0);
+	tileset.shader->SetMat4("view", glm::value_ptr(view));
+	tileset.shader->SetMat4("projection", glm::value_ptr(projection));
+
+	for (int cy = 0; cy < chunkCount.y; ++cy) {
+		for (int cx = 0; cx < chunkCount.x; ++cx) {
+			const Chunk& chunk = chunks[static_cast<size_t>(cy) * chunkCount.x + cx];
+			if (chunk.tileCount == 0) continue;
+			if (chunk.meshDirty) MeshChunk(chunk);
+
+			const glm::mat4 chunkModel = glm::translate(model, glm::vec3(glm::vec2(cx, cy) * static_cast<float>(ChunkTiles), 0.0f));
+			tileset.shader->SetMat4("model", glm::value_ptr(chunkModel));
+			glBindVertexArray(chunk.VAO);
+			glDrawArrays(GL_TRIANGLES, 0, chunk.vertexCount);
+		}
+	}
+	glBindVertexArray(0);
+}
+
+const TilemapComponent::Stats& TilemapComponent::GetStats() const {
+	stats.chunks = 0;
+	stats.meshedChunks = 0;
+	stats.colliders = 0;
+	for (const Chunk& chunk : chunks) {
+		if (chunk.tileCount > 0) ++stats.chunks;
+		if (chunk.VAO) ++stats.meshedChunks;
+		stats.colliders += static_cast<int>(chunk.colliders.size());
+	}
+	return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Editor
+// ---------------------------------------------------------------------------
+
+// Properties edited through the registry take effect here, in the editor and after loading
+void TilemapComponent::ApplyEdits() {
+	if (tileset.texturePath != tileset.previousTexturePath) {
+		if (tileset.texturePath.empty()) {
+			delete tileset.texture;
+			tileset.texture = nullptr;
+		}
+		else {
+			tileset.SetTexture(tileset.texturePath);
+		}
+		tileset.previousTexturePath = tileset.texturePath;
+		atlasPixels = { 0, 0 };
+		MarkMeshesDirty();
+	}
+
+	atlasColumns = std::max(atlasColumns, 1);
+	atlasRows = std::max(atlasRows, 1);
+	if (appliedAtlas != glm::ivec2(atlasColumns, atlasRows)) {
+		appliedAtlas = { atlasColumns, atlasRows };
+		MarkMeshesDirty();
+	}
+
+	if (appliedSize != glm::ivec2(mapWidth, mapHeight)) {
+		Resize(mapWidth, mapHeight);
+	}
+	else if (tileFlags != appliedFlags || tileSize != appliedTileSize || !SameTransform(transform, appliedTransform)) {
+		RebuildAllColliders();
+	}
+}
+
+void TilemapComponent::DrawImGui() {
+	Component::DrawImGui();
+	ApplyEdits();
+
+	ImGui::SeparatorText("Tiles");
+	ImGui::Checkbox("Paint Tiles", &painting);
+	if (ImGui::InputInt("Brush", &brush)) {
+		brush = std::clamp(brush, 0, static_cast<int>(std::numeric_limits<uint16_t>::max()));
+	}
+
+	if (brush > 0) {
+		const uint16_t id = static_cast<uint16_t>(brush);
+		int flags = GetTileFlags(id);
+		bool solid = (flags & static_cast<int>(TileFlag::Solid)) != 0;
+		bool navBlocked = (flags & static_cast<int>(TileFlag::NavBlocked)) != 0;
+		if (ImGui::Checkbox("Solid", &solid) | ImGui::Checkbox("Nav Blocked", &navBlocked)) {
+			flags = (solid ? static_cast<int>(TileFlag::Solid) : 0) | (navBlocked ? static_cast<int>(TileFlag::NavBlocked) : 0);
+			SetTileFlags(id, flags);
+		}
+	}
+	DrawPalette();
+
+	if (ImGui::Button("Fill With Brush")) Fill(static_cast<uint16_t>(brush));
+	ImGui::SameLine();
+	if (ImGui::Button("Clear Tiles")) Fill(0);
+
+	const Stats& current = GetStats();
+	ImGui::Text("Chunks: %d used, %d meshed, %d drawn", current.chunks, current.meshedChunks, current.visibleChunks);
+	ImGui::Text("Merged solid colliders: %d", current.colliders);
+}
+
+void TilemapComponent::DrawPalette() {
+	if (!tileset.texture) return;
+
+	constexpr int MaxPaletteCells = 256;
+	constexpr float CellSize = 24.0f;
+	const int cells = std::min(atlasColumns * atlasRows, MaxPaletteCells);
+	const ImTextureID textureID = (ImTextureID)(intptr_t)tileset.texture->ID;
+
+	for (int cell = 0; cell < cells; ++cell) {
+		const uint16_t id = static_cast<uint16_t>(cell + 1);
+		const glm::vec4 uv = GetAtlasRect(id);
+
+		ImGui::PushID(cell);
+		if (cell % atlasColumns != 0) ImGui::SameLine();
+		const bool selected = brush == id;
+		if (selected) ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+		if (ImGui::ImageButton("##tile", textureID, ImVec2(CellSize, CellSize), ImVec2(uv.x, uv.w), ImVec2(uv.z, uv.y))) {
+			brush = id;
+		}
+		if (selected) ImGui::PopStyleColor();
+		ImGui::PopID();
+	}
+}
+
+void TilemapComponent::HandleMouse(const glm::vec2& worldMouse, bool mouseDown) {
+	if (!IsPainting() || !mouseDown || ImGui::GetIO().WantCaptureMouse) return;
+
+	const glm::ivec2 tile = WorldToTile(worldMouse);
+	SetTile(tile.x, tile.y, static_cast<uint16_t>(brush));
+}
+
+// ---------------------------------------------------------------------------
+// Save/Load
+// ---------------------------------------------------------------------------
+
+void TilemapComponent::Serialize(std::ostream& out) const {
+	savedTiles.clear();
+
+	int runTile = -1;
+	int runLength = 0;
+	for (int y = 0; y < mapHeight; ++y) {
+		for (int x = 0; x < mapWidth; ++x) {
+			const int tile = GetTile(x, y);
+			if (tile == runTile) {
+				++runLength;
+				continue;
+			}
+			if (runLength > 0) savedTiles.insert(savedTiles.end(), { runLength, runTile });
+			runTile = tile;
+			runLength = 1;
+		}
+	}
+	if (runLength > 0) savedTiles.insert(savedTiles.end(), { runLength, runTile });
+
+	Component::Serialize(out);
+	savedTiles.clear();
+}
+
+void TilemapComponent::Deserialize(std::istream& in) {
+	Component::Deserialize(in);
+	ApplyEdits();
+
+	const size_t cellCount = static_cast<size_t>(mapWidth) * mapHeight;
+	size_t cell = 0;
+	for (size_t i = 0; i + 1 < savedTiles.size() && cell < cellCount; i += 2) {
+		const size_t runLength = static_cast<size_t>(std::max(savedTiles[i], 0));
+		const uint16_t tile = static_cast<uint16_t>(std::clamp(savedTiles[i + 1], 0, 0xFFFF));
+		const size_t end = std::min(cell + runLength, cellCount);
+		if (tile != 0) {
+			for (size_t c = cell; c < end; ++c) {
+				WriteTile(static_cast<int>(c % mapWidth), static_cast<int>(c / mapWidth), tile);
+			}
+		}
+		cell = end;
+	}
+	savedTiles.clear();
+
+	RebuildAllColliders();
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "Component.h"
+#include "DelusiveData.h"
+#include "PhysicsTypes.h"
+#include "RenderQueue.h"
+#include "SolidCollider.h"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//Per tile id flags, stored in the tilemap's tileFlags
+enum class TileFlag : int {
+	None = 0,
+	Solid = 1 << 0,      // merged into SolidColliders, which also block the nav bake
+	NavBlocked = 1 << 1  // only blocks the nav bake, e.g. water agents should path around
+};
+
+//Grid of tile ids drawn from one atlas tileset. Tiles live in dense ChunkTiles-square chunks that are
+//meshed into their own vertex buffer the first time they come into view, so a chunk costs one draw
+//and off-screen chunks cost nothing. Solid tiles are greedy-merged into box SolidColliders per chunk,
+//which physics, the nav bake and the collider overlay pick up through Agent::GetColliders.
+//Id 0 is empty, id n is atlas cell n - 1 counted row by row from the top left.
+class TilemapComponent : public Component {
+public:
+	static constexpr int ChunkTiles = 32;
+
+	struct Stats {
+		int chunks = 0;
+		int meshedChunks = 0;    // chunks that currently hold a vertex buffer
+		int colliders = 0;
+		int visibleChunks = 0;   // by the last Record()
+		int uploadedChunks = 0;
+	};
+
+	TilemapComponent();
+	~TilemapComponent();
+
+	TilemapComponent(const TilemapComponent&) = delete;
+	TilemapComponent& operator=(const TilemapComponent&) = delete;
+
+	void RegisterProperties() override;
+	std::unique_ptr<Component> Clone() const override;
+
+	void Update(float) override {}
+	void Draw(const glm::mat4& projection) const override;
+	//Records one command per visible chunk, meshing chunks that changed since they were last drawn
+	void Record(RenderQueue&, const Zone& view) const;
+	void DrawImGui() override;
+	void HandleMouse(const glm::vec2&, bool) override;
+	void SetOwner(Agent*) override;
+	void CollectColliders(std::vector<ColliderComponent*>&) override;
+
+	const char* GetType() const override {
+		return "TilemapComponent";
+	}
+
+	void Resize(int width, int height);
+	glm::ivec2 GetMapSize() const { return { mapWidth, mapHeight }; }
+	uint16_t GetTile(int x, int y) const;
+	void SetTile(int x, int y, uint16_t id);
+	void Fill(uint16_t id);
+
+	int GetTileFlags(uint16_t id) const;
+	void SetTileFlags(uint16_t id, int flags);
+	bool HasFlag(uint16_t id, TileFlag flag) const { return (GetTileFlags(id) & static_cast<int>(flag)) != 0; }
+
+	//Tile under a world position, may lie outside the map
+	glm::ivec2 WorldToTile(const glm::vec2&) const;
+	Zone GetWorldBounds() const;
+	//World rectangles of merged NavBlocked tiles that are not also solid
+	void GetNavBlockers(std::vector<Zone>&) const;
+
+	bool IsPainting() const { return painting && enabled; }
+	int GetRenderOrder() const { return renderOrder; }
+	const Stats& GetStats() const;
+
+	void Serialize(std::ostream& out) const override;
+	void Deserialize(std::istream& in) override;
+
+private:
+	struct TileRect {
+		glm::ivec2 min; // chunk-local tile
+		glm::ivec2 size;
+	};
+
+	struct Chunk {
+		std::vector<uint16_t> tiles;    // ChunkTiles * ChunkTiles row by row, empty while every tile is 0
+		int tileCount = 0;
+		mutable GLuint VAO = 0, VBO = 0;
+		mutable GLsizei vertexCount = 0;
+		mutable bool meshDirty = true;
+		std::vector<std::unique_ptr<SolidCollider>> colliders;
+		std::vector<TileRect> navBlockers;
+	};
+
+	DelusiveTexture tileset;
+	int atlasColumns = 1;
+	int atlasRows = 1;
+	float tileSize = 1.0f;
+	int mapWidth = 0;
+	int mapHeight = 0;
+	int renderOrder = -1;
+	std::vector<int> tileFlags;            // TileFlag bits indexed by tile id
+
+	//Serialized mirror of the tiles, refreshed by Serialize: row-major runs of (count, tile id)
+	mutable std::vector<int> savedTiles;
+
+	std::vector<Chunk> chunks;
+	glm::ivec2 chunkCount = { 0, 0 };
+	glm::ivec2 appliedSize = { 0, 0 };     // map size the chunks were built for
+	glm::ivec2 appliedAtlas = { 1, 1 };
+	std::vector<int> appliedFlags;         // tileFlags, tileSize and transform the colliders were built from
+	float appliedTileSize = 1.0f;
+	Transform appliedTransform;
+	mutable glm::ivec2 atlasPixels = { 0, 0 };
+	mutable Stats stats;
+
+	bool painting = false;
+	int brush = 1;
+
+	glm::mat4 GetModel() const;           // map space, one unit per tile
+	//Stores a tile without touching colliders, returns true when the tile's flags changed
+	bool WriteTile(int x, int y, uint16_t id);
+	void MeshChunk(const Chunk&) const;
+	void RebuildColliders(Chunk&, int chunkX, int chunkY);
+	void RebuildAllColliders();
+	void MarkMeshesDirty();
+	void ReleaseMeshes();
+	void ApplyEdits();
+	void MarkSceneDirty();
+	void DrawPalette();
+	glm::vec4 GetAtlasRect(uint16_t id) const; // u0, v0, u1, v1
+};
@@ -1,7 +1,8 @@
 #include "TriggerCollider.h"
 
-void TriggerCollider::OnCollision(ColliderComponent* col) {
-	//TODO: Prevent self hits
+void TriggerCollider::OnContact(ContactPhase phase, ColliderComponent* col) {
+	if (phase != ContactPhase::Begin) return;
+
 	if (col->GetColliderType() == ColliderType::Solid) {
 		std::cout << "[Trigger] occurred by solid collider." << std::endl;
 		//Call damage here
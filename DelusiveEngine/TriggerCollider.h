@@ -5,8 +5,7 @@
 class TriggerCollider : public ColliderComponent {
 public:
 	std::unique_ptr<Component> Clone() const override {
-		//TODO: Properly copy over values
-		return std::make_unique<TriggerCollider>();
+		return CloneCollider<TriggerCollider>();
 	}
 
 	ColliderType GetColliderType() const override {
@@ -14,7 +13,7 @@ public:
 	}
 
 	void Update(float) override {};
-	void OnCollision(ColliderComponent*) override;
+	void OnContact(ContactPhase, ColliderComponent*) override;
 
 	const char* GetType() const override {
 		return "TriggerCollider";
@@ -3,6 +3,7 @@
 #include <imgui/imgui.h>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 
 UIButton::UIButton(DelusiveRenderer& _renderer) 
 	: UIElement(_renderer)
@@ -28,6 +29,7 @@ void UIButton::RegisterProperties() {
 	registry.Register("Font", &buttonFont);
 	registry.Register("FontColor", &fontColor);
 	registry.Register("TextOffset", &textOffset);
+	registry.Register("TextAlign", reinterpret_cast<int*>(&textAlign));
 }
 
 std::unique_ptr<UIElement> UIButton::Clone() const {
@@ -40,6 +42,7 @@ std::unique_ptr<UIElement> UIButton::Clone() const {
 	copy->buttonTexture.CloneFrom(buttonTexture);
 	copy->buttonFont.CloneFrom(buttonFont);
 	copy->fontColor = fontColor;
+	copy->textAlign = textAlign;
 	copy->buttonFont.fontSize = buttonFont.fontSize;
 	copy->textOffset = textOffset;
 	copy->onClick = onClick; // note: lambda copying can be tricky
@@ -58,6 +61,9 @@ void UIButton::SetOnClick(std::function<void()> callback) {
 void UIButton::Draw(const glm::mat4& projection) {
 	if (!enabled) return;
 
+	// Reload font if its path or mode changed
+	buttonFont.Refresh();
+
 	// draw button background
 	glm::mat4 model =
 		glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f)) *
@@ -65,14 +71,20 @@ void UIButton::Draw(const glm::mat4& projection) {
 
 	glm::mat4 view = glm::mat4(1.0f);
 
+	// text batched so far sits below this button
+	renderer.GetTextBatch().Flush();
 	buttonTexture.Draw(model, view, projection);
 
 	// draw button label
 	buttonFont.DrawText(
+		labelLayout,
 		label,
 		position + textOffset,
 		fontColor,
-		projection
+		projection,
+		&renderer.GetTextBatch(),
+		std::max(size.x - textOffset.x * 2.0f, 0.0f),
+		textAlign
 	);
 
 	UIElement::Draw(projection); // draw children
@@ -29,4 +29,6 @@ private:
 
 	glm::vec4 fontColor = { 1, 1, 1, 1 };
 	glm::vec2 textOffset = { 8, 8 };
+	TextAlign textAlign = TextAlign::Left;  // within the button, inset by textOffset.x
+	TextLayout labelLayout;
 };
\ No newline at end of file
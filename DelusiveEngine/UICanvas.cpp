@@ -35,9 +35,13 @@ void UICanvas::Update(float deltaTime) {
 
 void UICanvas::Draw(const glm::mat4& projection) {
 	//if (!active) return;
+	// Consecutive labels and button captions are merged into as few draws as possible
+	TextBatch& textBatch = renderer.GetTextBatch();
+	textBatch.Begin(projection);
 	for (auto& element : elements) {
 		element->Draw(projection);
 	}
+	textBatch.End();
 }
 
 void UICanvas::HandleMouse(const glm::vec2& pos, bool down) {
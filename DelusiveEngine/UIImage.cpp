@@ -82,6 +82,7 @@ void UIImage::Draw(const glm::mat4& projection) {
 
 	glm::mat4 view = glm::mat4(1.0f); // no view transform for UI
 
+	renderer.GetTextBatch().Flush(); // keep earlier text below the image
 	textureData.Draw(model, view, projection);
 
 	// Draw children UI elements
@@ -23,6 +23,9 @@ void UILabel::RegisterProperties() {
 	registry.Register("font", &fontData);
 	registry.Register("text", &text);
 	registry.Register("color", &color);
+	registry.Register("width", &width);
+	registry.Register("wordWrap", &wordWrap);
+	registry.Register("align", reinterpret_cast<int*>(&align));
 }
 
 void UILabel::LoadFont(const std::string& ttfPath, float pixelHeight) {
@@ -36,12 +39,16 @@ std::unique_ptr<UIElement> UILabel::Clone() const {
 	copy->SetPosition(position);
 	copy->SetFontSize(fontData.fontSize);
 	copy->SetColor(color);
+	copy->SetWidth(width);
+	copy->SetWordWrap(wordWrap);
+	copy->SetAlign(align);
 	copy->SetName(name);
 	copy->SetEnabled(enabled);
 
 	// copy font settings
 	copy->fontData.fontPath = fontData.fontPath;
 	copy->fontData.fontSize = fontData.fontSize;
+	copy->fontData.sdf = fontData.sdf;
 	copy->fontData.Init();
 
 	for (const auto& child : children) {
@@ -58,7 +65,9 @@ void UILabel::Update(float deltaTime) {
 void UILabel::Draw(const glm::mat4& projection) {
 	if (!enabled) return;
 
-	fontData.DrawText(text, position, color, projection);
+	// Reload font if its path or mode changed
+	fontData.Refresh();
+	fontData.DrawText(layout, text, position, color, projection, &renderer.GetTextBatch(), width, align, wordWrap);
 
 	UIElement::Draw(projection);
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <glm/glm.hpp>
 #include "Font.h"
+#include "TextLayout.h"
 
 class UILabel : public UIElement {
 public:
@@ -30,10 +31,20 @@ public:
 	void SetFontSize(float s) { fontData.fontSize = s; }
 	float GetFontSize() const { return fontData.fontSize; }
 
+	//width 0 sizes the text box to the widest line
+	void SetWidth(float w) { width = w; }
+	void SetWordWrap(bool enabled) { wordWrap = enabled; }
+	void SetAlign(TextAlign a) { align = a; }
+	const TextLayout& GetLayout() const { return layout; }
+
 	const std::string GetType() const override;
 private:
 	std::string text;
 	glm::vec4 color;
 
 	DelusiveFont fontData;
+	TextLayout layout;
+	float width = 0.0f;
+	bool wordWrap = false;
+	TextAlign align = TextAlign::Left;
 };
\ No newline at end of file
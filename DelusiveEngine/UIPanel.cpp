@@ -36,6 +36,7 @@ void UIPanel::SetColor(const glm::vec4& c) {
 }
 
 void UIPanel::Draw(const glm::mat4& projection) {
+    renderer.GetTextBatch().Flush(); // keep earlier text below the panel
     if (shader) shader->Use();
     renderer.DrawRect(position, size, color, projection, shader, texture);
 
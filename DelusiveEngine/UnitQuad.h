@@ -0,0 +1,14 @@
+#pragma once
+
+//Unit quad centred on the origin, two triangles of (pos.xy, tex.uv)
+inline constexpr float UnitQuadVertices[] = {
+    // pos       // tex
+    -0.5f, -0.5f,  0.0f, 0.0f,
+     0.5f, -0.5f,  1.0f, 0.0f,
+     0.5f,  0.5f,  1.0f, 1.0f,
+
+     0.5f,  0.5f,  1.0f, 1.0f,
+    -0.5f,  0.5f,  0.0f, 1.0f,
+    -0.5f, -0.5f,  0.0f, 0.0f
+};
+inline constexpr int UnitQuadVertexCount = 6;
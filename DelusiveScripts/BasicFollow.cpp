@@ -16,6 +16,17 @@ void BasicFollow::Update(float deltaTime) {
     glm::vec2 direction = targetPos - ownerPos;
     float distance = glm::length(direction);
 
+    // Inside a crowd, only ask for a velocity. The CrowdSystem steers it around
+    // neighbours and the PathfindingComponent moves the agent.
+    if (owner->steering && owner->steering->active) {
+        glm::vec2 desired(0.0f);
+        if (distance > followDistance && distance > 0.0001f) {
+            desired = direction / distance * movementSpeed;
+        }
+        owner->steering->preferredVelocity = desired;
+        return;
+    }
+
     if (distance > followDistance) {
         if (distance > 0.0001f) { // avoid normalize(0)
             glm::vec2 moveDir = direction / distance; // safe normalize
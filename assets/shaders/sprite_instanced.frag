@@ -0,0 +1,10 @@
+#version 330 core
+in vec2 TexCoord;
+in vec4 Tint;
+out vec4 FragColor;
+
+uniform sampler2D tex;
+
+void main() {
+    FragColor = texture(tex, TexCoord) * Tint;
+}
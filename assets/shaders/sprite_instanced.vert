@@ -0,0 +1,21 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTex;
+
+// Per instance: 2x3 affine transform, atlas rect and tint
+layout (location = 2) in vec4 iAxes;   // x axis in xy, y axis in zw
+layout (location = 3) in vec2 iOffset;
+layout (location = 4) in vec4 iUVRect; // offset in xy, size in zw
+layout (location = 5) in vec4 iTint;
+
+uniform mat4 projection;
+
+out vec2 TexCoord;
+out vec4 Tint;
+
+void main() {
+    vec2 world = iAxes.xy * aPos.x + iAxes.zw * aPos.y + iOffset;
+    gl_Position = projection * vec4(world, 0.0, 1.0);
+    TexCoord = iUVRect.xy + aTex * iUVRect.zw;
+    Tint = iTint;
+}
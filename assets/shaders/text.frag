@@ -1,11 +1,11 @@
 #version 330 core
 in vec2 TexCoord;
+in vec4 Color;
 out vec4 FragColor;
 
 uniform sampler2D tex;
-uniform vec4 uColor;
 
 void main() {
     float alpha = texture(tex, TexCoord).r;
-    FragColor = vec4(uColor.rgb, uColor.a * alpha);
-}
\ No newline at end of file
+    FragColor = vec4(Color.rgb, Color.a * alpha);
+}
@@ -1,13 +1,16 @@
 #version 330 core
 layout(location = 0) in vec2 aPos;
 layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
 
 uniform mat4 model;
 uniform mat4 projection;
 
 out vec2 TexCoord;
+out vec4 Color;
 
 void main() {
     gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
     TexCoord = aTexCoord;
-}
\ No newline at end of file
+    Color = aColor;
+}
@@ -0,0 +1,15 @@
+#version 330 core
+in vec2 TexCoord;
+in vec4 Color;
+out vec4 FragColor;
+
+uniform sampler2D tex;
+
+// The atlas stores distance to the outline, 0.5 being the edge.
+// Smoothing over one screen pixel keeps edges sharp at any draw size.
+void main() {
+    float distance = texture(tex, TexCoord).r;
+    float smoothing = max(fwidth(distance) * 0.5, 1e-4);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    FragColor = vec4(Color.rgb, Color.a * alpha);
+}
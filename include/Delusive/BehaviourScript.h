@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <glm/glm.hpp>
+#include <Delusive/Contact.h>
 
 class DelusiveScriptAgent;
 
@@ -11,6 +12,11 @@ public:
 	virtual void Update(float deltaTime) = 0;
 	virtual std::unique_ptr<BehaviourScript> Clone() const = 0;
 
+	//Contact hooks, called after the physics step. Stay only comes through colliders with wantsStay set.
+	virtual void OnContactBegin(const ContactInfo&) {}
+	virtual void OnContactStay(const ContactInfo&) {}
+	virtual void OnContactEnd(const ContactInfo&) {}
+
 	//Getters and Setters
 	virtual DelusiveScriptAgent* GetOwner() const { return owner; }
 	virtual DelusiveScriptAgent* GetTarget() const { return target; }
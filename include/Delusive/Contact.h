@@ -0,0 +1,19 @@
+// Contact.h  (safe for scripts)
+#pragma once
+#include <cstdint>
+
+enum class ContactPhase {
+    Begin,
+    Stay,
+    End
+};
+
+// What a script sees of one contact event, from its own collider's point of view.
+// Stay fires every step while two colliders keep overlapping.
+struct ContactInfo {
+    ContactPhase phase{ ContactPhase::Begin };
+    uint64_t otherAgentID{ 0 };
+    int selfLayer{ 0 };
+    int otherLayer{ 0 };
+    bool otherRemoved{ false }; // the other collider was destroyed or disabled
+};
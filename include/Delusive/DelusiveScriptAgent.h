@@ -1,18 +1,23 @@
 #pragma once
 #include <cstdint>
 #include <Delusive/Transform.h>
+#include <Delusive/Steering.h>
 #include <string>
 
 class Agent; //Forward declaration
+class PhysicsQuery;
 
 class DelusiveScriptAgent {
 public:
 	Transform* transform;
+	Steering* steering;
 
 	DelusiveScriptAgent(Agent* engineAgent);
 
 	uint64_t GetID() const;
 	const std::string& GetName() const;
+	//Raycasts and overlap tests against the agent's scene, null when it is not in one
+	const PhysicsQuery* GetPhysics() const;
 private:
 	Agent* agent; //Non-owned, points to engine side agent
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+// PhysicsQuery.h  (safe for scripts)
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Restricts which colliders a query can see
+struct QueryFilter {
+    uint32_t layerMask{ 0xFFFFFFFFu }; // one bit per collision layer
+    uint64_t ignoreAgentID{ 0 };       // usually the caller itself, 0 ignores nothing
+};
+
+struct QueryHit {
+    uint64_t agentID{ 0 };
+    int layer{ 0 };
+    glm::vec2 point{ 0.0f, 0.0f };
+    glm::vec2 normal{ 0.0f, 0.0f };
+    float fraction{ 1.0f }; // along the cast, 0 when it started inside the collider
+};
+
+struct RaycastRequest {
+    glm::vec2 from{ 0.0f, 0.0f };
+    glm::vec2 to{ 0.0f, 0.0f };
+    QueryFilter filter;
+};
+
+struct RaycastResult {
+    bool hit{ false };
+    QueryHit info;
+};
+
+// Read-only access to the scene's colliders, answered from the broadphase trees.
+// Results reflect the colliders as of the last physics step.
+class PhysicsQuery {
+public:
+    virtual ~PhysicsQuery() = default;
+
+    // Closest hit along from -> to
+    virtual bool Raycast(glm::vec2 from, glm::vec2 to, QueryHit& hit, const QueryFilter& filter = {}) const = 0;
+    // Appends each agent with a collider touching the area once, returns how many were added
+    virtual int CircleOverlap(glm::vec2 center, float radius, std::vector<uint64_t>& agentIDs, const QueryFilter& filter = {}) const = 0;
+    virtual int BoxOverlap(glm::vec2 min, glm::vec2 max, std::vector<uint64_t>& agentIDs, const QueryFilter& filter = {}) const = 0;
+    // First hit of a circle of the given radius swept from -> to
+    virtual bool ShapeCast(glm::vec2 from, glm::vec2 to, float radius, QueryHit& hit, const QueryFilter& filter = {}) const = 0;
+    // Answers many raycasts at once across the job system, results[i] belongs to requests[i]
+    virtual void RaycastBatch(const RaycastRequest* requests, RaycastResult* results, int count) const = 0;
+};
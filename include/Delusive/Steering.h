@@ -0,0 +1,13 @@
+// Steering.h  (safe for scripts)
+#pragma once
+#include <glm/glm.hpp>
+
+// Velocity handoff between an agent's brain and the CrowdSystem.
+// Scripts and path followers write preferredVelocity; the CrowdSystem answers with
+// a collision-free velocity while the agent takes part in a crowd.
+struct Steering {
+public:
+    glm::vec2 preferredVelocity{ 0.0f, 0.0f };
+    glm::vec2 velocity{ 0.0f, 0.0f };
+    bool active{ false }; // set by the CrowdSystem each tick, cleared once the agent has used it
+};
\ No newline at end of file